@@ -125,9 +125,20 @@ int parseParams(const ParameterList &params) {
     }
 }
 
+static thread_local std::map<std::string, std::string> *threadOptions = 0;
+
 std::map<std::string, std::string> &getNamedOptions() {
     static std::map<std::string, std::string> options;
-    return options;
+    return threadOptions ? *threadOptions : options;
+}
+
+ThreadNamedOptions::ThreadNamedOptions(const std::map<std::string, std::string> &options) : mOptions(options),
+        mPrevious(threadOptions) {
+    threadOptions = &mOptions;
+}
+
+ThreadNamedOptions::~ThreadNamedOptions() {
+    threadOptions = mPrevious;
 }
 
 std::string &getNamedOption(const std::string &name, const std::string &defValue) {
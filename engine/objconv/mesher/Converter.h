@@ -173,9 +173,32 @@ public:
  */
 void registerConversionImplementation(ConversionImpl *module, int priority);
 
+/** Run a conversion through the registered implementations, the way --convert does.
+ *  @remarks
+ *       Implementations are probed in priority order until one returns something other
+ *       than RC_NOT_IMPLEMENTED. Input and output paths are taken from the named options.
+ */
+ConversionImpl::RetCodeEnum runConversion(const std::string &inputFormat, const std::string &outputFormat,
+        const std::string &opCode);
+
 /** Get a map with all named options */
 std::map<std::string, std::string> &getNamedOptions();
 
+/** Gives the calling thread its own copy of the named options for as long as it lives.
+ *  @remarks
+ *       Conversions read their input/output paths and flags from the named options, so
+ *       this is what allows several of them to run at once (see --batch).
+ */
+class ThreadNamedOptions {
+public:
+    explicit ThreadNamedOptions(const std::map<std::string, std::string> &options);
+    ~ThreadNamedOptions();
+
+private:
+    std::map<std::string, std::string> mOptions;
+    std::map<std::string, std::string> *mPrevious;
+};
+
 /** Get a specific named option - create it if it doesn't exist, with said default value. */
 std::string &getNamedOption(const std::string &name, const std::string &defValue = std::string());
 
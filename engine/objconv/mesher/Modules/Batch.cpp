@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2001-2025 Daniel Horn, pyramid3d, Stephen G. Tuggy,
+ * and other Vega Strike contributors.
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../PrecompiledHeaders/Converter.h"
+#include "../Converter.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/filesystem.hpp>
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace Converter {
+
+class BatchHandler : public Module {
+    NameList mNames;
+
+    struct Job {
+        string input;
+        string output;
+        // output path relative to the output directory, used as key in the hash file
+        string key;
+        string status;
+        double ms;
+        uint64_t hash;
+    };
+
+    static const char *extensionFor(const string &format) {
+        if (format == "BFXM") {
+            return ".bfxm";
+        } else if (format == "XMesh") {
+            return ".xmesh";
+        } else if (format == "Wavefront") {
+            return ".obj";
+        } else if (format == "Ogre") {
+            return ".mesh";
+        }
+        return "";
+    }
+
+    // FNV-1a, enough to tell whether an input changed since the last run
+    static uint64_t hashBytes(uint64_t hash, const char *data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= (unsigned char) data[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    static bool hashFile(const string &path, uint64_t &hash) {
+        ifstream file(path.c_str(), ios::binary);
+        if (!file) {
+            return false;
+        }
+        char buffer[65536];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount()) {
+            hash = hashBytes(hash, buffer, (size_t) file.gcount());
+        }
+        return true;
+    }
+
+    static string jsonString(const string &s) {
+        string rv = "\"";
+        for (string::const_iterator it = s.begin(); it != s.end(); ++it) {
+            if (*it == '"' || *it == '\\') {
+                rv += '\\';
+                rv += *it;
+            } else if ((unsigned char) *it < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char) *it);
+                rv += escaped;
+            } else {
+                rv += *it;
+            }
+        }
+        return rv + "\"";
+    }
+
+    static void addJob(vector<Job> &jobs, const fs::path &input, const fs::path &relative, const fs::path &outputDir,
+            const string &extension) {
+        Job job;
+        fs::path output = outputDir / relative;
+        output.replace_extension(extension);
+        job.input = input.string();
+        job.output = output.string();
+        job.key = fs::path(relative).replace_extension(extension).generic_string();
+        job.ms = 0;
+        job.hash = 0;
+        jobs.push_back(job);
+    }
+
+    // source is either a directory, searched recursively for files in the input format,
+    // or a manifest listing one input per line (relative to the manifest; '#' starts a comment)
+    static bool collectJobs(vector<Job> &jobs, const string &inputFormat, const string &outputFormat,
+            const fs::path &source, const fs::path &outputDir) {
+        const string inExtension = extensionFor(inputFormat);
+        const string outExtension = extensionFor(outputFormat);
+        if (fs::is_directory(source)) {
+            for (fs::recursive_directory_iterator it(source), end; it != end; ++it) {
+                if (fs::is_regular_file(it->status())
+                        && boost::algorithm::to_lower_copy(fs::extension(it->path())) == inExtension) {
+                    addJob(jobs, it->path(), it->path().lexically_relative(source), outputDir, outExtension);
+                }
+            }
+        } else {
+            ifstream manifest(source.string().c_str());
+            if (!manifest) {
+                cerr << "Error: cannot open " << source.string() << endl;
+                return false;
+            }
+            string line;
+            while (getline(manifest, line)) {
+                line = line.substr(0, line.find('#'));
+                line.erase(line.find_last_not_of(" \t\r") + 1);
+                line.erase(0, line.find_first_not_of(" \t"));
+                if (line.empty()) {
+                    continue;
+                }
+                fs::path input(line);
+                fs::path relative = input.is_absolute() ? input.filename() : input;
+                if (!input.is_absolute()) {
+                    input = source.parent_path() / input;
+                }
+                addJob(jobs, input, relative, outputDir, outExtension);
+            }
+        }
+        sort(jobs.begin(), jobs.end(), [](const Job &a, const Job &b) {
+            return a.input < b.input;
+        });
+        return true;
+    }
+
+    static map<string, uint64_t> loadHashes(const fs::path &hashFile) {
+        map<string, uint64_t> hashes;
+        ifstream file(hashFile.string().c_str());
+        string line;
+        while (getline(file, line)) {
+            string::size_type space = line.find(' ');
+            if (space != string::npos) {
+                hashes[line.substr(space + 1)] = strtoull(line.substr(0, space).c_str(), 0, 16);
+            }
+        }
+        return hashes;
+    }
+
+    static void saveHashes(const fs::path &hashFile, const map<string, uint64_t> &hashes) {
+        ofstream file(hashFile.string().c_str());
+        for (map<string, uint64_t>::const_iterator it = hashes.begin(); it != hashes.end(); ++it) {
+            file << hex << setw(16) << setfill('0') << it->second << ' ' << it->first << '\n';
+        }
+    }
+
+    int runBatch(const string &inputFormat, const string &outputFormat, const string &opCode, const string &source,
+            const string &outputDir) {
+        vector<Job> jobs;
+        if (!collectJobs(jobs, inputFormat, outputFormat, fs::path(source), fs::path(outputDir))) {
+            return 1;
+        }
+        const bool incremental = hasNamedOption("incremental");
+        const fs::path hashPath = fs::path(outputDir) / ".mesher-batch";
+        // the workers only read the previous run's hashes, so they see a map that is complete before they start
+        const map<string, uint64_t> previousHashes = loadHashes(hashPath);
+
+        // options change the output too, so they go into the hash; paths and batch settings don't
+        map<string, string> options = getNamedOptions();
+        static const char *const unhashed[] = {"inputPath", "outputPath", "rootPath", "jobs", "incremental", "report"};
+        const char *const *unhashedEnd = unhashed + sizeof(unhashed) / sizeof(*unhashed);
+        uint64_t settingsHash = 14695981039346656037ull;
+        const string conversion = inputFormat + '\n' + outputFormat + '\n' + opCode + '\n';
+        settingsHash = hashBytes(settingsHash, conversion.data(), conversion.size());
+        for (map<string, string>::const_iterator it = options.begin(); it != options.end(); ++it) {
+            if (find(unhashed, unhashedEnd, it->first) == unhashedEnd) {
+                const string option = it->first + '=' + it->second + '\n';
+                settingsHash = hashBytes(settingsHash, option.data(), option.size());
+            }
+        }
+
+        for (vector<Job>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+            fs::create_directories(fs::path(it->output).parent_path());
+        }
+
+        unsigned int threads = atoi(getNamedOption("jobs", "0").c_str());
+        if (threads == 0) {
+            threads = max(1u, thread::hardware_concurrency());
+        }
+        // the Ogre writer keeps its managers and scratch buffers in statics, so it only runs on one thread
+        if (threads > 1 && (inputFormat == "Ogre" || outputFormat == "Ogre")) {
+            cerr << "Warning: Ogre conversions are not thread-safe, running on one thread" << endl;
+            threads = 1;
+        }
+        threads = (unsigned int) min<size_t>(threads, max<size_t>(jobs.size(), 1));
+
+        atomic<size_t> next(0);
+        size_t finished = 0;
+        mutex outputMutex;
+        const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        auto worker = [&]() {
+            ThreadNamedOptions threadOptions(options);
+            for (size_t index; (index = next++) < jobs.size();) {
+                Job &job = jobs[index];
+                const chrono::steady_clock::time_point jobStart = chrono::steady_clock::now();
+                job.hash = settingsHash;
+                const map<string, uint64_t>::const_iterator previous = previousHashes.find(job.key);
+                if (!hashFile(job.input, job.hash)) {
+                    job.status = "error";
+                } else if (incremental && previous != previousHashes.end() && previous->second == job.hash
+                        && fs::exists(job.output)) {
+                    job.status = "skipped";
+                } else {
+                    getInputPath() = job.input;
+                    getOutputPath() = job.output;
+                    ConversionImpl::RetCodeEnum rc;
+                    try {
+                        rc = runConversion(inputFormat, outputFormat, opCode);
+                    } catch (const exception &e) {
+                        cerr << "Error: " << job.input << ": " << e.what() << endl;
+                        rc = ConversionImpl::RC_INTERNAL_ERROR;
+                    }
+                    job.status = (rc == ConversionImpl::RC_OK) ? "ok" : "error";
+                }
+                job.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - jobStart).count();
+
+                lock_guard<mutex> lock(outputMutex);
+                cout << "[" << ++finished << "/" << jobs.size() << "] " << job.status << " " << job.input
+                        << " (" << job.ms << " ms)" << endl;
+            }
+        };
+        vector<thread> pool;
+        for (unsigned int i = 1; i < threads; ++i) {
+            pool.push_back(thread(worker));
+        }
+        worker();
+        for (vector<thread>::iterator it = pool.begin(); it != pool.end(); ++it) {
+            it->join();
+        }
+        const double wallMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        map<string, uint64_t> hashes = previousHashes;
+        size_t converted = 0, skipped = 0, failed = 0;
+        for (vector<Job>::const_iterator it = jobs.begin(); it != jobs.end(); ++it) {
+            if (it->status == "ok") {
+                ++converted;
+                hashes[it->key] = it->hash;
+            } else if (it->status == "skipped") {
+                ++skipped;
+            } else {
+                ++failed;
+                hashes.erase(it->key);
+            }
+        }
+        saveHashes(hashPath, hashes);
+        cout << "Batch: " << converted << " converted, " << skipped << " unchanged, " << failed << " failed in "
+                << wallMs << " ms on " << threads << " threads" << endl;
+
+        if (hasNamedOption("report")) {
+            ofstream report(getNamedOption("report").c_str());
+            report << "{\n  \"threads\": " << threads << ",\n  \"wall_ms\": " << wallMs
+                    << ",\n  \"converted\": " << converted << ",\n  \"skipped\": " << skipped
+                    << ",\n  \"failed\": " << failed << ",\n  \"files\": [";
+            for (vector<Job>::const_iterator it = jobs.begin(); it != jobs.end(); ++it) {
+                report << (it == jobs.begin() ? "\n" : ",\n") << "    {\"input\": " << jsonString(it->input)
+                        << ", \"output\": " << jsonString(it->output) << ", \"status\": \"" << it->status
+                        << "\", \"ms\": " << it->ms << "}";
+            }
+            report << "\n  ]\n}\n";
+        }
+        return failed ? 1 : 0;
+    }
+
+public:
+    BatchHandler() {
+        mNames.push_back("--batch");
+        mNames.push_back("--jobs");
+        mNames.push_back("--incremental");
+        mNames.push_back("--report");
+    }
+
+    virtual const NameList &getNames() const {
+        return mNames;
+    }
+
+    virtual void help(const std::string &command, ParameterList &params) const {
+        if (command == "--batch" || command == "--jobs" || command == "--incremental" || command == "--report") {
+            cout << "Convert many meshes in one run, on several threads\n"
+                    << "Usage:\n"
+                    << "\tmesher [--jobs=N] [--incremental] [--report=path] [options] --batch"
+                    << " (inputFormat) (outputFormat) (opCode) (directory|manifest) (outputDirectory)\n\n"
+                    << "A directory is searched recursively for files in the input format; a manifest\n"
+                    << "lists one input per line. Outputs mirror the input tree under outputDirectory.\n"
+                    << "--jobs=N        number of worker threads (default: one per hardware thread;\n"
+                    << "                Ogre conversions always run on one)\n"
+                    << "--incremental   skip files whose input and options are unchanged since the last run\n"
+                    << "--report=path   write a JSON timing report\n"
+                    << endl;
+            params.clear();
+        } else {
+            cerr << "Warning: BatchHandler::help() received an unrecognized command." << endl;
+        }
+    }
+
+    virtual int execute(const std::string &command, ParameterList &params, unsigned int phase) {
+        const string name = command.substr(0, command.rfind('='));
+        const string value = (command.rfind('=') != string::npos) ? command.substr(command.rfind('=') + 1) : "1";
+        if (name == "--jobs" || name == "--incremental" || name == "--report") {
+            if (phase == 0) {
+                getNamedOption(name.substr(2)) = value;
+            }
+            return 0;
+        } else if (command == "--batch") {
+            if (params.size() < 5) {
+                cerr << "Fatal: " << command << " needs five arguments\n"
+                        << "Do \"mesher --help batch\" for details" << endl;
+                return 1;
+            }
+            int rv = 0;
+            if (phase == 1) {
+                rv = runBatch(params[0], params[1], params[2], params[3], params[4]);
+            }
+            params.erase(params.begin(), params.begin() + 5);
+            return rv;
+        } else {
+            cerr << "Warning: BatchHandler::execute() received an unrecognized command." << endl;
+            return 0;
+        }
+    }
+};
+
+static ModuleDeclaration<BatchHandler, false> __bh_declaration;
+
+}
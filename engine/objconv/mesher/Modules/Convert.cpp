@@ -60,6 +60,17 @@ void registerConversionImplementation(ConversionImpl *module, int priority) {
     getRegistry().insert(pair<int, ConversionImpl *>(priority, module));
 }
 
+ConversionImpl::RetCodeEnum runConversion(const string &inputFormat, const string &outputFormat,
+        const string &opCode) {
+    ConversionImplList &registry = getRegistry();
+    ConversionImpl::RetCodeEnum rc = ConversionImpl::RC_NOT_IMPLEMENTED;
+    for (ConversionImplList::iterator cit = registry.begin();
+            (rc == ConversionImpl::RC_NOT_IMPLEMENTED) && (cit != registry.end()); ++cit) {
+        rc = cit->second->convert(inputFormat, outputFormat, opCode);
+    }
+    return rc;
+}
+
 class ConvertHandler : public Module {
     typedef set<string> OptionList;
     typedef map<string, string> AliasList;
@@ -95,7 +106,7 @@ public:
         ADD_OPTION("flipn"); //flip normals
         ADD_OPTION("dims");  //show dimensions
         ADD_OPTION("basepath");       //specify model base path for building material scripts
-        ADD_OPTION("autolod");        //create automatic lods (TODO: may specify distance list)
+        ADD_OPTION("autolod");        //create automatic lods, optionally =size1,size2,... in pixels (largest first)
         ADD_OPTION("autoedge");       //create edge list (prepare for stencil shadows)
         ADD_OPTION("autotangent");    //create tangent texcoord unit
         ADD_OPTION("forceflatshade"); //force flat shading
@@ -158,12 +169,7 @@ public:
                     // Do nothing in phase 0.
                     return 0;
                 } else if (phase == 1) {
-                    ConversionImplList &registry = getRegistry();
-                    ConversionImpl::RetCodeEnum rc = ConversionImpl::RC_NOT_IMPLEMENTED;
-                    for (ConversionImplList::iterator cit = registry.begin();
-                            (rc == ConversionImpl::RC_NOT_IMPLEMENTED) && (cit != registry.end()); ++cit) {
-                        rc = cit->second->convert(params[0], params[1], params[2]);
-                    }
+                    ConversionImpl::RetCodeEnum rc = runConversion(params[0], params[1], params[2]);
                     if (rc == ConversionImpl::RC_NOT_IMPLEMENTED) {
                         cerr << "Error: " << params[2] << " from " << params[0] << " to " << params[1]
                                 << " unimplemented" << endl;
@@ -23,6 +23,7 @@
 #include "../PrecompiledHeaders/Converter.h"
 #include "../Converter.h"
 #include "../from_obj.h"
+#include "../auto_lod.h"
 
 using namespace std;
 
@@ -58,7 +59,11 @@ public:
                     fclose(InputMtl);
                     return RC_INTERNAL_ERROR;
                 }
-                ObjToBFXM(Inputfile, InputMtl, Outputfile, forcenormals);
+                vector<float> lodsizes;
+                if (hasNamedOption("autolod")) {
+                    lodsizes = ParseAutoLODSizes(getNamedOption("autolod"));
+                }
+                ObjToBFXM(Inputfile, InputMtl, Outputfile, forcenormals, lodsizes);
                 return RC_OK;
             } else {
                 return RC_NOT_IMPLEMENTED;
@@ -23,6 +23,7 @@
 #include "../PrecompiledHeaders/Converter.h"
 #include "../Converter.h"
 #include "../to_BFXM.h"
+#include "../auto_lod.h"
 
 using namespace std;
 
@@ -46,6 +47,9 @@ public:
                         "rb+"); //append to end, but not append, which doesn't do what you want it to.
                 fseek(Outputfile, 0, SEEK_END);
                 XML memfile = (LoadXML(input.c_str(), 1));
+                if (hasNamedOption("autolod")) {
+                    GenerateLODs(memfile, ParseAutoLODSizes(getNamedOption("autolod")));
+                }
                 xmeshToBFXM(memfile, Outputfile, 'a', forcenormals);
                 return RC_OK;
             } else if (opCode == "create") {
@@ -54,6 +58,9 @@ public:
                 string output = getNamedOption("outputPath");
                 FILE *Outputfile = fopen(output.c_str(), "wb+"); //create file for BFXM output
                 XML memfile = (LoadXML(input.c_str(), 1));
+                if (hasNamedOption("autolod")) {
+                    GenerateLODs(memfile, ParseAutoLODSizes(getNamedOption("autolod")));
+                }
                 xmeshToBFXM(memfile, Outputfile, 'c', forcenormals);
                 return RC_OK;
             } else {
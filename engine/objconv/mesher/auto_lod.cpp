@@ -0,0 +1,503 @@
+/*
+ * Copyright (C) 2001-2025 Daniel Horn, pyramid3d, Stephen G. Tuggy,
+ * and other Vega Strike contributors.
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeaders/Converter.h"
+#include "objconv/mesher/auto_lod.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <queue>
+#include <set>
+#include <utility>
+
+namespace {
+
+//Faces whose normal would turn by more than ~60 degrees block the collapse
+const double kMinNormalDot = 0.5;
+const float kSeamEpsilon = 1e-5f;
+//A level that keeps more than this fraction of the previous one is not worth storing
+const float kMinReduction = 0.9f;
+
+struct Vec3 {
+    double x, y, z;
+};
+
+Vec3 sub(const Vec3 &a, const Vec3 &b) {
+    return Vec3{a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+Vec3 cross(const Vec3 &a, const Vec3 &b) {
+    return Vec3{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+double dot(const Vec3 &a, const Vec3 &b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+//Symmetric 4x4 error quadric, upper triangle: xx xy xz xw yy yz yw zz zw ww
+struct Quadric {
+    double m[10];
+
+    Quadric() {
+        std::fill(m, m + 10, 0.0);
+    }
+
+    void addPlane(const Vec3 &n, double d, double weight) {
+        m[0] += weight * n.x * n.x;
+        m[1] += weight * n.x * n.y;
+        m[2] += weight * n.x * n.z;
+        m[3] += weight * n.x * d;
+        m[4] += weight * n.y * n.y;
+        m[5] += weight * n.y * n.z;
+        m[6] += weight * n.y * d;
+        m[7] += weight * n.z * n.z;
+        m[8] += weight * n.z * d;
+        m[9] += weight * d * d;
+    }
+
+    Quadric &operator+=(const Quadric &o) {
+        for (int i = 0; i < 10; ++i) {
+            m[i] += o.m[i];
+        }
+        return *this;
+    }
+
+    double error(const Vec3 &p) const {
+        return m[0] * p.x * p.x + 2 * m[1] * p.x * p.y + 2 * m[2] * p.x * p.z + 2 * m[3] * p.x
+                + m[4] * p.y * p.y + 2 * m[5] * p.y * p.z + 2 * m[6] * p.y
+                + m[7] * p.z * p.z + 2 * m[8] * p.z
+                + m[9];
+    }
+};
+
+struct Face {
+    int v[3];
+    float s[3];
+    float t[3];
+    bool flatshade;
+    bool live;
+
+    int corner(int vertex) const {
+        return v[0] == vertex ? 0 : (v[1] == vertex ? 1 : (v[2] == vertex ? 2 : -1));
+    }
+};
+
+//Half edge collapse from -> to; stamps detect entries made stale by later collapses
+struct Collapse {
+    double cost;
+    int from;
+    int to;
+    unsigned int from_stamp;
+    unsigned int to_stamp;
+
+    bool operator<(const Collapse &o) const {
+        return cost > o.cost;
+    }
+};
+
+class Simplifier {
+public:
+    explicit Simplifier(const XML &memfile);
+
+    size_t triangles() const {
+        return live_faces;
+    }
+
+    void reduce(size_t target);
+
+    XML result(const XML &memfile) const;
+
+private:
+    void addFace(int a, int b, int c, float sa, float ta, float sb, float tb, float sc, float tc, bool flatshade);
+    void addFace(const strip &s, int a, int b, int c);
+    void push(int from, int to);
+    bool canCollapse(int from, int to, float &s, float &t) const;
+    void collapse(int from, int to, float s, float t);
+    void neighbours(int vertex, std::set<int> &out) const;
+    Vec3 faceNormal(const Face &f, int moved, const Vec3 &to) const;
+
+    vector<Vec3> positions;
+    vector<Quadric> quadrics;
+    vector<bool> locked;
+    vector<bool> alive;
+    vector<unsigned int> stamps;
+    vector<Face> faces;
+    vector<vector<int> > vertex_faces;
+    std::priority_queue<Collapse> heap;
+    size_t live_faces;
+};
+
+Simplifier::Simplifier(const XML &memfile) : live_faces(0) {
+    const size_t count = memfile.vertices.size();
+    positions.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = Vec3{memfile.vertices[i].x, memfile.vertices[i].y, memfile.vertices[i].z};
+    }
+    quadrics.resize(count);
+    locked.assign(count, false);
+    alive.assign(count, true);
+    stamps.assign(count, 0);
+    vertex_faces.resize(count);
+
+    for (size_t i = 0; i < memfile.tris.size(); ++i) {
+        const triangle &tri = memfile.tris[i];
+        addFace(tri.indexref[0], tri.indexref[1], tri.indexref[2],
+                tri.s[0], tri.t[0], tri.s[1], tri.t[1], tri.s[2], tri.t[2], tri.flatshade);
+    }
+    for (size_t i = 0; i < memfile.quads.size(); ++i) {
+        const quad &q = memfile.quads[i];
+        addFace(q.indexref[0], q.indexref[1], q.indexref[2],
+                q.s[0], q.t[0], q.s[1], q.t[1], q.s[2], q.t[2], q.flatshade);
+        addFace(q.indexref[0], q.indexref[2], q.indexref[3],
+                q.s[0], q.t[0], q.s[2], q.t[2], q.s[3], q.t[3], q.flatshade);
+    }
+    //quad strips list their points in triangle strip order
+    const vector<strip> *strips[] = {&memfile.tristrips, &memfile.quadstrips};
+    for (int kind = 0; kind < 2; ++kind) {
+        for (size_t i = 0; i < strips[kind]->size(); ++i) {
+            const strip &s = (*strips[kind])[i];
+            for (size_t p = 2; p < s.points.size(); ++p) {
+                if (p % 2 == 0) {
+                    addFace(s, int(p - 2), int(p - 1), int(p));
+                } else {
+                    addFace(s, int(p - 1), int(p - 2), int(p));
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < memfile.trifans.size(); ++i) {
+        const strip &s = memfile.trifans[i];
+        for (size_t p = 2; p < s.points.size(); ++p) {
+            addFace(s, 0, int(p - 1), int(p));
+        }
+    }
+
+    //Vertices on UV seams: their corners disagree about the texture coordinate
+    vector<bool> seen(count, false);
+    vector<std::pair<float, float> > uv(count);
+    std::map<std::pair<int, int>, int> edges;
+    for (size_t f = 0; f < faces.size(); ++f) {
+        const Face &face = faces[f];
+        for (int c = 0; c < 3; ++c) {
+            const int v = face.v[c];
+            if (!seen[v]) {
+                seen[v] = true;
+                uv[v] = std::make_pair(face.s[c], face.t[c]);
+            } else if (std::fabs(uv[v].first - face.s[c]) > kSeamEpsilon
+                    || std::fabs(uv[v].second - face.t[c]) > kSeamEpsilon) {
+                locked[v] = true;
+            }
+            const int w = face.v[(c + 1) % 3];
+            ++edges[std::make_pair(std::min(v, w), std::max(v, w))];
+        }
+    }
+    //Open borders and non manifold edges. Hard edges and seams in files that split
+    //vertices there show up as borders too, since the two sides share no vertex.
+    for (std::map<std::pair<int, int>, int>::const_iterator it = edges.begin(); it != edges.end(); ++it) {
+        if (it->second != 2) {
+            locked[it->first.first] = true;
+            locked[it->first.second] = true;
+        }
+    }
+    for (size_t i = 0; i < memfile.lines.size(); ++i) {
+        locked[memfile.lines[i].indexref[0]] = true;
+        locked[memfile.lines[i].indexref[1]] = true;
+    }
+    for (size_t i = 0; i < memfile.logos.size(); ++i) {
+        for (size_t r = 0; r < memfile.logos[i].refpnt.size(); ++r) {
+            if (memfile.logos[i].refpnt[r] >= 0 && size_t(memfile.logos[i].refpnt[r]) < count) {
+                locked[memfile.logos[i].refpnt[r]] = true;
+            }
+        }
+    }
+    for (std::map<std::pair<int, int>, int>::const_iterator it = edges.begin(); it != edges.end(); ++it) {
+        push(it->first.first, it->first.second);
+        push(it->first.second, it->first.first);
+    }
+}
+
+void Simplifier::addFace(int a, int b, int c, float sa, float ta, float sb, float tb, float sc, float tc,
+        bool flatshade) {
+    const int count = int(positions.size());
+    if (a < 0 || b < 0 || c < 0 || a >= count || b >= count || c >= count || a == b || b == c || a == c) {
+        return;
+    }
+    Face face = {{a, b, c}, {sa, sb, sc}, {ta, tb, tc}, flatshade, true};
+    Vec3 n = cross(sub(positions[b], positions[a]), sub(positions[c], positions[a]));
+    const double area2 = std::sqrt(dot(n, n));
+    if (area2 > 0) {
+        n = Vec3{n.x / area2, n.y / area2, n.z / area2};
+        const double d = -dot(n, positions[a]);
+        for (int i = 0; i < 3; ++i) {
+            quadrics[face.v[i]].addPlane(n, d, area2 * 0.5);
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        vertex_faces[face.v[i]].push_back(int(faces.size()));
+    }
+    faces.push_back(face);
+    ++live_faces;
+}
+
+void Simplifier::addFace(const strip &s, int a, int b, int c) {
+    addFace(s.points[a].indexref, s.points[b].indexref, s.points[c].indexref,
+            s.points[a].s, s.points[a].t, s.points[b].s, s.points[b].t, s.points[c].s, s.points[c].t,
+            s.flatshade);
+}
+
+void Simplifier::push(int from, int to) {
+    if (locked[from]) {
+        return;
+    }
+    Quadric q = quadrics[from];
+    q += quadrics[to];
+    Collapse c = {q.error(positions[to]), from, to, stamps[from], stamps[to]};
+    heap.push(c);
+}
+
+void Simplifier::neighbours(int vertex, std::set<int> &out) const {
+    for (size_t i = 0; i < vertex_faces[vertex].size(); ++i) {
+        const Face &face = faces[vertex_faces[vertex][i]];
+        if (face.live) {
+            for (int c = 0; c < 3; ++c) {
+                if (face.v[c] != vertex) {
+                    out.insert(face.v[c]);
+                }
+            }
+        }
+    }
+}
+
+Vec3 Simplifier::faceNormal(const Face &f, int moved, const Vec3 &to) const {
+    Vec3 p[3];
+    for (int c = 0; c < 3; ++c) {
+        p[c] = (f.v[c] == moved) ? to : positions[f.v[c]];
+    }
+    return cross(sub(p[1], p[0]), sub(p[2], p[0]));
+}
+
+bool Simplifier::canCollapse(int from, int to, float &s, float &t) const {
+    //The edge must still exist, and to must have one texture coordinate along it
+    int shared = 0;
+    for (size_t i = 0; i < vertex_faces[from].size(); ++i) {
+        const Face &face = faces[vertex_faces[from][i]];
+        const int c = face.corner(to);
+        if (!face.live || c < 0) {
+            continue;
+        }
+        if (shared > 0 && (std::fabs(face.s[c] - s) > kSeamEpsilon || std::fabs(face.t[c] - t) > kSeamEpsilon)) {
+            return false;
+        }
+        s = face.s[c];
+        t = face.t[c];
+        ++shared;
+    }
+    if (shared == 0) {
+        return false;
+    }
+    //Link condition: sharing more neighbours than faces would pinch the surface
+    std::set<int> from_ring, to_ring;
+    neighbours(from, from_ring);
+    neighbours(to, to_ring);
+    int common = 0;
+    for (std::set<int>::const_iterator it = from_ring.begin(); it != from_ring.end(); ++it) {
+        if (*it != to && to_ring.count(*it)) {
+            ++common;
+        }
+    }
+    if (common != shared) {
+        return false;
+    }
+    for (size_t i = 0; i < vertex_faces[from].size(); ++i) {
+        const Face &face = faces[vertex_faces[from][i]];
+        if (!face.live || face.corner(to) >= 0) {
+            continue;
+        }
+        const Vec3 before = faceNormal(face, from, positions[from]);
+        const Vec3 after = faceNormal(face, from, positions[to]);
+        const double lengths = std::sqrt(dot(before, before) * dot(after, after));
+        if (lengths <= 0 || dot(before, after) < kMinNormalDot * lengths) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Simplifier::collapse(int from, int to, float s, float t) {
+    for (size_t i = 0; i < vertex_faces[from].size(); ++i) {
+        const int f = vertex_faces[from][i];
+        Face &face = faces[f];
+        if (!face.live) {
+            continue;
+        }
+        if (face.corner(to) >= 0) {
+            face.live = false;
+            --live_faces;
+        } else {
+            const int c = face.corner(from);
+            face.v[c] = to;
+            face.s[c] = s;
+            face.t[c] = t;
+            vertex_faces[to].push_back(f);
+        }
+    }
+    vertex_faces[from].clear();
+    alive[from] = false;
+    quadrics[to] += quadrics[from];
+    ++stamps[to];
+
+    vector<int> &list = vertex_faces[to];
+    list.erase(std::remove_if(list.begin(), list.end(), [this](int f) {
+        return !faces[f].live;
+    }), list.end());
+    std::set<int> ring;
+    neighbours(to, ring);
+    for (std::set<int>::const_iterator it = ring.begin(); it != ring.end(); ++it) {
+        push(to, *it);
+        push(*it, to);
+    }
+}
+
+void Simplifier::reduce(size_t target) {
+    while (live_faces > target && !heap.empty()) {
+        const Collapse c = heap.top();
+        heap.pop();
+        if (!alive[c.from] || !alive[c.to] || stamps[c.from] != c.from_stamp || stamps[c.to] != c.to_stamp) {
+            continue;
+        }
+        float s = 0, t = 0;
+        if (canCollapse(c.from, c.to, s, t)) {
+            collapse(c.from, c.to, s, t);
+        }
+    }
+}
+
+XML Simplifier::result(const XML &memfile) const {
+    XML lod(memfile);
+    lod.tris.clear();
+    lod.quads.clear();
+    lod.tristrips.clear();
+    lod.trifans.clear();
+    lod.quadstrips.clear();
+    lod.LODs.clear();
+    lod.animframes.clear();
+    lod.animdefs.clear();
+    lod.num_vertex_references.clear();
+    lod.vertices.clear();
+
+    vector<int> remap(memfile.vertices.size(), -1);
+    std::function<int(int)> keep = [&](int v) {
+        if (remap[v] < 0) {
+            remap[v] = int(lod.vertices.size());
+            lod.vertices.push_back(memfile.vertices[v]);
+        }
+        return remap[v];
+    };
+    for (size_t f = 0; f < faces.size(); ++f) {
+        const Face &face = faces[f];
+        if (face.live) {
+            lod.tris.push_back(triangle(keep(face.v[0]), keep(face.v[1]), keep(face.v[2]),
+                    face.s[0], face.t[0], face.s[1], face.t[1], face.s[2], face.t[2], face.flatshade));
+        }
+    }
+    for (size_t i = 0; i < lod.lines.size(); ++i) {
+        lod.lines[i].indexref[0] = keep(lod.lines[i].indexref[0]);
+        lod.lines[i].indexref[1] = keep(lod.lines[i].indexref[1]);
+    }
+    for (size_t i = 0; i < lod.logos.size(); ++i) {
+        for (size_t r = 0; r < lod.logos[i].refpnt.size(); ++r) {
+            const int v = lod.logos[i].refpnt[r];
+            if (v >= 0 && size_t(v) < remap.size()) {
+                lod.logos[i].refpnt[r] = keep(v);
+            }
+        }
+    }
+    return lod;
+}
+
+} //namespace
+
+vector<float> ParseAutoLODSizes(const string &option) {
+    vector<float> sizes;
+    if (option.empty() || option == "1") {
+        sizes.push_back(128);
+        sizes.push_back(64);
+        sizes.push_back(32);
+        return sizes;
+    }
+    const char *p = option.c_str();
+    while (*p) {
+        char *end;
+        const double size = strtod(p, &end);
+        if (end == p) {
+            ++p;
+            continue;
+        }
+        if (size > 0) {
+            sizes.push_back(float(size));
+        }
+        p = end;
+    }
+    //every level is simpler than the last, so it must be used at smaller sizes
+    std::sort(sizes.begin(), sizes.end(), std::greater<float>());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    return sizes;
+}
+
+XML SimplifyMesh(const XML &memfile, size_t target_tris) {
+    Simplifier simplifier(memfile);
+    simplifier.reduce(target_tris);
+    return simplifier.result(memfile);
+}
+
+void GenerateLODs(XML &memfile, const vector<float> &sizes) {
+    if (sizes.empty()) {
+        return;
+    }
+    if (!memfile.LODs.empty() || !memfile.animframes.empty()) {
+        fprintf(stderr, "Warning: mesh already has LODs or animation frames, not generating LODs\n");
+        return;
+    }
+    Simplifier simplifier(memfile);
+    size_t tris = simplifier.triangles();
+    printf("LOD 0: %u tris\n", (unsigned int) tris);
+    for (size_t level = 0; level < sizes.size(); ++level) {
+        const size_t previous = tris;
+        simplifier.reduce(previous / 2);
+        tris = simplifier.triangles();
+        if (tris == 0 || tris > previous * kMinReduction) {
+            printf("LOD %u: cannot reduce below %u tris, stopping\n", (unsigned int) (level + 1),
+                    (unsigned int) previous);
+            break;
+        }
+        LODholder lod;
+        lod.size = sizes[level];
+        lod.mesh = std::make_shared<XML>(simplifier.result(memfile));
+        memfile.LODs.push_back(lod);
+        printf("LOD %u: %u tris, %u vertices, below %g pixels\n", (unsigned int) (level + 1), (unsigned int) tris,
+                (unsigned int) lod.mesh->vertices.size(), sizes[level]);
+    }
+}
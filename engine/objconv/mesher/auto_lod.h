@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2001-2025 Daniel Horn, pyramid3d, Stephen G. Tuggy,
+ * and other Vega Strike contributors.
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_OBJCONV_AUTO_LOD_H
+#define VEGA_STRIKE_ENGINE_OBJCONV_AUTO_LOD_H
+
+#include "objconv/mesher/to_BFXM.h"
+#include <string>
+#include <vector>
+
+//Quadric edge collapse simplification used by the -autolod option.
+//Vertices on open borders, on UV seams and on hard (split normal) edges are never
+//moved, and collapses that would turn a face too far from its original normal are
+//rejected, so the reduced meshes keep their texture layout and shading.
+
+//Parses the value of -autolod: a comma separated list of LOD sizes in pixels.
+//A bare -autolod (value "1") selects the default list.
+vector<float> ParseAutoLODSizes(const string &option);
+
+//Returns a triangulated copy of the top level mesh with at most target_tris triangles,
+//or as close to that as the mesh allows. Lines are kept untouched.
+XML SimplifyMesh(const XML &memfile, size_t target_tris);
+
+//Appends one generated LOD to memfile.LODs per entry of sizes, each having about
+//half the triangles of the previous one, and prints the triangle count of every level.
+//Stops early when a level would not get any simpler.
+void GenerateLODs(XML &memfile, const vector<float> &sizes);
+
+#endif //VEGA_STRIKE_ENGINE_OBJCONV_AUTO_LOD_H
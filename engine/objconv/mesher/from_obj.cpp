@@ -22,6 +22,7 @@
 
 #include "PrecompiledHeaders/Converter.h"
 #include "objconv/mesher/from_obj.h"
+#include "objconv/mesher/auto_lod.h"
 
 #include <utility>
 
@@ -760,13 +761,17 @@ void ObjToXMESH(FILE *obj, FILE *mtl, vector<XML> &xmllist, bool forcenormals) {
     printf("Total indices: %d\n", totindex);
 }
 
-void ObjToBFXM(FILE *obj, FILE *mtl, FILE *outputFile, bool forcenormals) {
+void ObjToBFXM(FILE *obj, FILE *mtl, FILE *outputFile, bool forcenormals, const std::vector<float> &lodsizes) {
     vector<XML> xmllist;
 
     ObjToXMESH(obj, mtl, xmllist, forcenormals);
 
     int textnum = 0;
     for (vector<XML>::iterator it = xmllist.begin(); it != xmllist.end(); ++it, ++textnum) {
+        if (!lodsizes.empty()) {
+            printf("%u:\n", textnum);
+            GenerateLODs(*it, lodsizes);
+        }
         xmeshToBFXM(*it, outputFile, textnum == 0 ? 'c' : 'a', forcenormals);
     }
 }
@@ -25,6 +25,7 @@
 #include "objconv/mesher/to_BFXM.h"
 #include <vector>
 void ObjToXMESH(FILE *obj, FILE *mtl, std::vector<XML> &xml, bool forcenormals);
-void ObjToBFXM(FILE *, FILE *, FILE *, bool forcenormals);
+void ObjToBFXM(FILE *, FILE *, FILE *, bool forcenormals,
+        const std::vector<float> &lodsizes = std::vector<float>()); //lodsizes: see GenerateLODs
 string ObjGetMtl(FILE *, string);
 
@@ -1016,6 +1016,10 @@ uint32bit appendrecordfromxml(XML memfile, FILE *Outputfile, bool forcenormals)
     size_t mesh;
     for (mesh = 0; mesh < memfile.LODs.size(); mesh++) {
         //write all LOD meshes
+        if (memfile.LODs[mesh].mesh) {
+            runningbytenum += appendmeshfromxml(*memfile.LODs[mesh].mesh, Outputfile, forcenormals);
+            continue;
+        }
         string LODname = "";
         for (size_t i = 0; i < memfile.LODs[mesh].name.size(); i++) {
             LODname += memfile.LODs[mesh].name[i];
@@ -22,6 +22,7 @@
 #ifndef VEGA_STRIKE_ENGINE_OBJCONV_TO_BFXM_H
 #define VEGA_STRIKE_ENGINE_OBJCONV_TO_BFXM_H
 
+#include <memory>
 #include <string>
 #include <vector>
 ///Stores all the load-time vertex info in the XML struct FIXME light calculations
@@ -211,10 +212,13 @@ struct strip {
     }
 };
 
+struct XML;
+
 struct LODholder   //Holds 1 LOD entry
 {
     float size;
     vector<unsigned char> name;
+    std::shared_ptr<XML> mesh; //generated in memory (autolod), used instead of loading name
 
     LODholder() {
         name = vector<unsigned char>();
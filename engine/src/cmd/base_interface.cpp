@@ -1165,6 +1165,28 @@ const char *compute_time_of_day(Unit *base, Unit *un) {
 
 extern void ExecuteDirector();
 
+//The scripts the links and objects of rooms run when clicked or timed out
+static std::vector<std::string> RoomScripts(const std::vector<BaseInterface::Room *> &rooms,
+        const std::string &kbhandler) {
+    std::vector<std::string> scripts(1, kbhandler);
+    for (const BaseInterface::Room *room : rooms) {
+        for (const BaseInterface::Room::Link *link : room->links) {
+            if (link) {
+                scripts.push_back(link->pythonfile);
+            }
+        }
+        for (BaseInterface::Room::BaseObj *obj : room->objs) {
+            const BaseInterface::Room::BasePython *python = dynamic_cast<BaseInterface::Room::BasePython *>(obj);
+            if (python) {
+                scripts.push_back(python->pythonfile);
+            }
+        }
+    }
+    std::sort(scripts.begin(), scripts.end());
+    scripts.erase(std::unique(scripts.begin(), scripts.end()), scripts.end());
+    return scripts;
+}
+
 BaseInterface::BaseInterface(const char *basefile, Unit *base, Unit *un) :
         curtext(vs_config->getColor("Base_Text_Color_Foreground", GFXColor(0, 1, 0, 1)),
                 vs_config->getColor("Base_Text_Color_Background", GFXColor(0, 0, 0, 1))),
@@ -1195,6 +1217,7 @@ BaseInterface::BaseInterface(const char *basefile, Unit *base, Unit *un) :
         fac = UniverseUtil::GetGalaxyFaction(UnitUtil::getUnitSystemFile(base));
     }
     Load(basefile, compute_time_of_day(base, un), fac.c_str());
+    WarmPython(RoomScripts(rooms, python_kbhandler));
     createdmusic = AUDHighestSoundPlaying();
     if (base && un) {
         vector<string> vec;
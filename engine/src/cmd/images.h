@@ -286,6 +286,9 @@ struct unorigdest {
     bool justloaded;
     bool ready;
     QVector final_location;
+    // set while dest is still being preloaded
+    std::string dest_file;
+    std::string dest_path;
 
     unorigdest(Unit *un,
             Unit *jumppoint,
@@ -66,6 +66,9 @@
 /* *********************************************************** */
 //ADD_FROM_PYTHON_FUNCTION(pythonMission)
 void Mission::DirectorLoop() {
+#if defined(LOG_TIME_TAKEN_DETAILS)
+    const double director_loop_start_time = realTime();
+#endif
     double oldgametime = gametime;
     gametime += SIMULATION_ATOM;     //elapsed;
     //VS_LOG(trace, (boost::format("void Mission::DirectorLoop(): oldgametime = %1$.6f; SIMULATION_ATOM = %2$.6f; gametime = %3$.6f") % oldgametime % SIMULATION_ATOM % gametime));
@@ -90,6 +93,9 @@ void Mission::DirectorLoop() {
         }
         throw;
     }
+#if defined(LOG_TIME_TAKEN_DETAILS)
+    VS_LOG(trace, (boost::format("%1%: Time taken by DirectorLoop: %2%") % __FUNCTION__ % (realTime() - director_loop_start_time)));
+#endif
 }
 
 void Mission::DirectorEnd() {
@@ -42,6 +42,7 @@
 #include "src/gnuhash.h"
 #include "src/universe.h"
 #include "src/vs_logging.h"
+#include "root_generic/lin_time.h"
 
 PYTHON_INIT_INHERIT_GLOBALS(Director, PythonMissionBaseClass);
 
@@ -413,8 +414,14 @@ bool Mission::runScript(missionNode *module_node, const string &scriptname, unsi
     runtime.cur_thread->module_stack.push_back(module_node);
     runtime.cur_thread->classid_stack.push_back(classid);
 
+#if defined(LOG_TIME_TAKEN_DETAILS)
+    const double run_script_start_time = realTime();
+#endif
     varInst *vi = doScript(script_node, SCRIPT_RUN);
     deleteVarInst(vi);
+#if defined(LOG_TIME_TAKEN_DETAILS)
+    VS_LOG(trace, (boost::format("%1%: Time taken by script %2%: %3%") % __FUNCTION__ % scriptname % (realTime() - run_script_start_time)));
+#endif
 
     runtime.cur_thread->classid_stack.pop_back();
     runtime.cur_thread->module_stack.pop_back();
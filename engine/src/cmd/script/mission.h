@@ -83,6 +83,15 @@ enum callback_module_type {
     CMT_IO, CMT_STD, CMT_STRING, CMT_OLIST, CMT_OMAP, CMT_ORDER, CMT_UNIT, CMT_BRIEFING
 };
 
+enum callback_module_io_type {
+    CMT_IO_UNKNOWN = 0,
+    CMT_IO_PrintFloats,
+    CMT_IO_printf,
+    CMT_IO_sprintf,
+    CMT_IO_message,
+    CMT_IO_printMsgList
+};
+
 enum callback_module_std_type {
     CMT_STD_UNKNOWN = 0,
     CMT_STD_Rnd,
@@ -286,6 +295,8 @@ enum var_type { VAR_FAILURE, VAR_BOOL, VAR_FLOAT, VAR_INT, VAR_OBJECT, VAR_VOID,
 
 enum tester_type { TEST_GT, TEST_LT, TEST_EQ, TEST_NE, TEST_GE, TEST_LE };
 
+enum math_type { MATH_UNKNOWN = 0, MATH_ADD, MATH_SUB, MATH_MUL, MATH_DIV };
+
 /* *********************************************************** */
 
 class missionNode;
@@ -391,6 +402,8 @@ public:
         missionNode *if_block[3]; //if
         missionNode *while_arg[2]; //while
         int tester; //test
+        math_type math_op; //fmath, imath
+        varInst *resolved_var; //var, setvar: module or global variable bound at parse time
         missionNode *test_arg[2]; //test
         enum var_type vartype; //defvar,script
         std::string initval;
@@ -575,6 +588,7 @@ private:
     vsUMap<std::string, callback_module_order_type> module_order_map;
     vsUMap<std::string, callback_module_unit_type> module_unit_map;
     vsUMap<std::string, callback_module_std_type> module_std_map;
+    vsUMap<std::string, callback_module_io_type> module_io_map;
     vsUMap<std::string, callback_module_briefing_type> module_briefing_map;
     vsUMap<std::string, callback_module_type> module_map;
 
@@ -613,6 +627,7 @@ private:
     varInst *lookupModuleVariable(missionNode *asknode);
     varInst *lookupClassVariable(missionNode *asknode);
     varInst *lookupGlobalVariable(missionNode *asknode);
+    void bindVariable(missionNode *node, varInst *vi);
     varInst *doVariable(missionNode *node, int mode);
     void checkStatement(missionNode *node, int mode);
     void doIf(missionNode *node, int mode);
@@ -631,8 +646,9 @@ private:
     int checkIntExpr(missionNode *node, int mode);
     int doIMath(missionNode *node, int mode);
     varInst *doMath(missionNode *node, int mode);
-    int intMath(std::string mathname, int res1, int res2);
-    double floatMath(std::string mathname, double res1, double res2);
+    math_type mathFromString(const std::string &mathname);
+    int intMath(math_type op, int res1, int res2);
+    double floatMath(math_type op, double res1, double res2);
     varInst *checkExpression(missionNode *node, int mode);
 
     void assignVariable(varInst *v1, varInst *v2);
@@ -743,7 +759,7 @@ private:
 
     void findNextEnemyTarget(Unit *my_unit);
 
-    varInst *doCall(missionNode *node, int mode, std::string module, std::string method);
+    varInst *doCall(missionNode *node, int mode, const std::string &module, const std::string &method);
     void doCall_toxml(std::string module, varInst *ovi);
 
     varInst *newVarInst(scope_type scopetype);
@@ -87,7 +87,7 @@ void Mission::doCall_toxml(string module, varInst *ovi) {
     }
 }
 
-varInst *Mission::doCall(missionNode *node, int mode, string module, string method) {
+varInst *Mission::doCall(missionNode *node, int mode, const string &module, const string &method) {
     varInst *vi = NULL;
     callback_module_type module_id = node->script.callback_module_id;
     if (module_id == CMT_UNIT) {
@@ -180,15 +180,19 @@ varInst *Mission::doCall(missionNode *node, int mode, string module, string meth
     } else if (module_id == CMT_STRING) {
         vi = call_string(node, mode);
     } else if (module_id == CMT_IO) {
-        if (method == "PrintFloats") {
+        if (mode == SCRIPT_PARSE) {
+            node->script.method_id = module_io_map[method];
+        }
+        callback_module_io_type method_id = (callback_module_io_type) node->script.method_id;
+        if (method_id == CMT_IO_PrintFloats) {
             vi = callPrintFloats(node, mode);
-        } else if (method == "printf") {
+        } else if (method_id == CMT_IO_printf) {
             vi = call_io_printf(node, mode);
-        } else if (method == "sprintf") {
+        } else if (method_id == CMT_IO_sprintf) {
             vi = call_io_sprintf(node, mode);
-        } else if (method == "message") {
+        } else if (method_id == CMT_IO_message) {
             vi = call_io_message(node, mode);
-        } else if (method == "printMsgList") {
+        } else if (method_id == CMT_IO_printMsgList) {
             vi = call_io_printmsglist(node, mode);
         }
     } else if (module_id == CMT_BRIEFING) {
@@ -215,9 +219,13 @@ varInst *Mission::doCall(missionNode *node, int mode) {
         callback_module_type module_id = module_map[module];
         node->script.callback_module_id = module_id;
     }
-    //RUNTIME && PARSE
-    string module = node->attr_value("module");
-    if (module.empty()) {
+    //the module and method are resolved to ids at parse time, so a run
+    //doesn't need to look at the attributes again
+    string module;
+    if (mode == SCRIPT_PARSE) {
+        module = node->attr_value("module");
+    }
+    if (mode == SCRIPT_PARSE && module.empty()) {
         //does not work yet
         string object = node->attr_value("object");
         assert(0);
@@ -237,11 +245,11 @@ varInst *Mission::doCall(missionNode *node, int mode) {
         }
         module = "_" + module;
     }
-    string method = node->script.name;
     varInst *vi = NULL;
-    vi = doCall(node, mode, module, method);
+    vi = doCall(node, mode, module, node->script.name);
     if (vi == NULL) {
-        fatalError(node, mode, "no such callback named " + module + "." + node->script.name);
+        //module is only filled in while parsing, the attribute still names it at run time
+        fatalError(node, mode, "no such callback named " + node->attr_value("module") + "." + node->script.name);
         assert(0);
     }
     return vi;
@@ -844,6 +852,12 @@ void Mission::initCallbackMaps() {
     module_omap_map["toxml"] = CMT_OMAP_toxml;
     module_omap_map["size"] = CMT_OMAP_size;
 
+    module_io_map["PrintFloats"] = CMT_IO_PrintFloats;
+    module_io_map["printf"] = CMT_IO_printf;
+    module_io_map["sprintf"] = CMT_IO_sprintf;
+    module_io_map["message"] = CMT_IO_message;
+    module_io_map["printMsgList"] = CMT_IO_printMsgList;
+
     module_string_map["new"] = CMT_STRING_new;
     module_string_map["delete"] = CMT_STRING_delete;
     module_string_map["print"] = CMT_STRING_print;
@@ -86,7 +86,14 @@ varInst *Mission::checkObjectExpr(missionNode *node, int mode) {
 /* *********************************************************** */
 
 varInst *Mission::doMath(missionNode *node, int mode) {
-    string mathname = node->attr_value("math");
+    if (mode == SCRIPT_PARSE) {
+        node->script.math_op = mathFromString(node->attr_value("math"));
+        if (node->script.math_op == MATH_UNKNOWN) {
+            fatalError(node, mode, "no such math expression " + node->attr_value("math"));
+            assert(0);
+        }
+    }
+    const math_type op = node->script.math_op;
 
     int len = node->subnodes.size();
     if (len < 2) {
@@ -114,7 +121,7 @@ varInst *Mission::doMath(missionNode *node, int mode) {
             res2_type = VAR_FLOAT;
             if (mode == SCRIPT_RUN) {
                 float res2 = (float) res2_vi->int_val;
-                float res = floatMath(mathname, res_vi->float_val, res2);
+                float res = floatMath(op, res_vi->float_val, res2);
                 res_vi->float_val = res;
             }
         } else if (res2_type == VAR_FLOAT && res_vi->type == VAR_INT) {
@@ -122,7 +129,7 @@ varInst *Mission::doMath(missionNode *node, int mode) {
             if (mode == SCRIPT_RUN) {
                 res_vi->float_val = (float) res_vi->int_val;
                 float res2 = res2_vi->float_val;
-                float res = floatMath(mathname, res_vi->float_val, res2);
+                float res = floatMath(op, res_vi->float_val, res2);
                 res_vi->float_val = res;
             }
         } else {
@@ -132,10 +139,10 @@ varInst *Mission::doMath(missionNode *node, int mode) {
             }
             if (mode == SCRIPT_RUN) {
                 if (res_vi->type == VAR_INT) {
-                    int res = intMath(mathname, res_vi->int_val, res2_vi->int_val);
+                    int res = intMath(op, res_vi->int_val, res2_vi->int_val);
                     res_vi->int_val = res;
                 } else if (res_vi->type == VAR_FLOAT) {
-                    float res = floatMath(mathname, res_vi->float_val, res2_vi->float_val);
+                    float res = floatMath(op, res_vi->float_val, res2_vi->float_val);
                     res_vi->float_val = res;
                 } else if (res_vi->type != res2_type) {
                     fatalError(node, mode, "can't do math on such types");
@@ -149,39 +156,54 @@ varInst *Mission::doMath(missionNode *node, int mode) {
     return res_vi;
 }
 
-int Mission::intMath(string mathname, int res1, int res2) {
-    int res = res1;
+math_type Mission::mathFromString(const string &mathname) {
     if (mathname == "+") {
-        res = res + res2;
+        return MATH_ADD;
     } else if (mathname == "-") {
-        res = res - res2;
+        return MATH_SUB;
     } else if (mathname == "*") {
-        res = res * res2;
+        return MATH_MUL;
     } else if (mathname == "/") {
-        res = res / res2;
-    } else {
-        fatalError(NULL, SCRIPT_RUN, "no such intmath expression");
-        assert(0);
+        return MATH_DIV;
     }
-    return res;
+    return MATH_UNKNOWN;
 }
 
 /* *********************************************************** */
-double Mission::floatMath(string mathname, double res1, double res2) {
-    double res = res1;
-    if (mathname == "+") {
-        res = res + res2;
-    } else if (mathname == "-") {
-        res = res - res2;
-    } else if (mathname == "*") {
-        res = res * res2;
-    } else if (mathname == "/") {
-        res = res / res2;
-    } else {
-        fatalError(NULL, SCRIPT_RUN, "no such floatmath expression");
-        assert(0);
+
+int Mission::intMath(math_type op, int res1, int res2) {
+    switch (op) {
+        case MATH_ADD:
+            return res1 + res2;
+        case MATH_SUB:
+            return res1 - res2;
+        case MATH_MUL:
+            return res1 * res2;
+        case MATH_DIV:
+            return res1 / res2;
+        default:
+            fatalError(NULL, SCRIPT_RUN, "no such intmath expression");
+            assert(0);
     }
-    return res;
+    return res1;
+}
+
+/* *********************************************************** */
+double Mission::floatMath(math_type op, double res1, double res2) {
+    switch (op) {
+        case MATH_ADD:
+            return res1 + res2;
+        case MATH_SUB:
+            return res1 - res2;
+        case MATH_MUL:
+            return res1 * res2;
+        case MATH_DIV:
+            return res1 / res2;
+        default:
+            fatalError(NULL, SCRIPT_RUN, "no such floatmath expression");
+            assert(0);
+    }
+    return res1;
 }
 
 /* *********************************************************** */
@@ -128,7 +128,10 @@ varInst *Mission::lookupLocalVariable(missionNode *asknode) {
     for (unsigned int i = 0; i < cstack->contexts.size() && defnode == NULL; i++) {
         scriptContext *context = cstack->contexts[i];
         varInstMap *map = context->varinsts;
-        defnode = (*map)[asknode->script.name];
+        varInstMap::const_iterator it = map->find(asknode->script.name);
+        if (it != map->end()) {
+            defnode = it->second;
+        }
         if (defnode != NULL) {
             debug(5, defnode->defvar_node, SCRIPT_RUN, "FOUND local variable defined in that node");
         }
@@ -257,8 +260,24 @@ void Mission::doGlobals(missionNode *node, int mode) {
 
 /* *********************************************************** */
 
+void Mission::bindVariable(missionNode *node, varInst *vi) {
+    //module and global variables live as long as the mission, so runs can use
+    //the instance found now instead of searching every scope by name;
+    //class variables depend on the instance the script runs for
+    node->script.resolved_var = NULL;
+    if (vi->scopetype == VI_GLOBAL
+            || (vi->scopetype == VI_MODULE && vi->defvar_node->attr_value("classvar") != "true")) {
+        node->script.resolved_var = vi;
+    }
+}
+
+/* *********************************************************** */
+
 varInst *Mission::doVariable(missionNode *node, int mode) {
     if (mode == SCRIPT_RUN) {
+        if (node->script.resolved_var != NULL) {
+            return node->script.resolved_var;
+        }
         varInst *var = lookupLocalVariable(node);
         if (var == NULL) {
             var = lookupClassVariable(node);
@@ -294,6 +313,7 @@ varInst *Mission::doVariable(missionNode *node, int mode) {
             }
             vi = global_var->script.varinst;
         }
+        bindVariable(node, vi);
         return vi;
     }
 }
@@ -454,6 +474,7 @@ void Mission::doSetVar(missionNode *node, int mode) {
             }
             vi = global_var->script.varinst;
         }
+        bindVariable(node, vi);
         switch (vi->type) {
             case VAR_FLOAT: // fall-through
             case VAR_INT:   // fall-through
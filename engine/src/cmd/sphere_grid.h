@@ -0,0 +1,129 @@
+/*
+ * sphere_grid.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_SPHERE_GRID_H
+#define VEGA_STRIKE_ENGINE_CMD_SPHERE_GRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "gfx_generic/vec.h"
+
+// Uniform hash grid of bounding spheres, rebuilt whenever it is needed.
+// Spheres no bigger than a cell are bucketed by their centre; bigger ones
+// (planets, stations) are few and kept in a list that every query checks.
+// Unlike the collide map this takes the radius of what is stored into account,
+// which is what explosions need.
+template<typename T>
+class SphereGrid {
+public:
+    explicit SphereGrid(double cell_size) : cell_size(cell_size > 1.0 ? cell_size : 1.0) {
+    }
+
+    void insert(const QVector &centre, double radius, const T &item) {
+        const size_t index = spheres.size();
+        spheres.push_back(Sphere{centre, radius, item});
+        if (radius > cell_size) {
+            oversized.push_back(index);
+        } else {
+            cells[key(cell(centre.i), cell(centre.j), cell(centre.k))].push_back(index);
+        }
+    }
+
+    size_t size() const {
+        return spheres.size();
+    }
+
+    // Calls found(item) for every sphere that overlaps the sphere at centre,
+    // i.e. whose surface is less than radius away from it.
+    template<typename Found>
+    void query(const QVector &centre, double radius, Found found) const {
+        // a stored centre can be up to a cell further away than its surface
+        const double reach = radius + cell_size;
+        const int64_t i0 = cell(centre.i - reach), i1 = cell(centre.i + reach);
+        const int64_t j0 = cell(centre.j - reach), j1 = cell(centre.j + reach);
+        const int64_t k0 = cell(centre.k - reach), k1 = cell(centre.k + reach);
+        const double visited = double(i1 - i0 + 1) * double(j1 - j0 + 1) * double(k1 - k0 + 1);
+        if (visited > double(cells.size()) || std::max(i1 - i0, std::max(j1 - j0, k1 - k0)) >= axis_cells) {
+            for (const auto &bucket : cells) {
+                test(bucket.second, centre, radius, found);
+            }
+        } else {
+            for (int64_t i = i0; i <= i1; ++i) {
+                for (int64_t j = j0; j <= j1; ++j) {
+                    for (int64_t k = k0; k <= k1; ++k) {
+                        auto bucket = cells.find(key(i, j, k));
+                        if (bucket != cells.end()) {
+                            test(bucket->second, centre, radius, found);
+                        }
+                    }
+                }
+            }
+        }
+        test(oversized, centre, radius, found);
+    }
+
+private:
+    struct Sphere {
+        QVector centre;
+        double radius;
+        T item;
+    };
+
+    static const int64_t axis_cells = int64_t(1) << 21;
+
+    int64_t cell(double coordinate) const {
+        return static_cast<int64_t>(std::floor(coordinate / cell_size));
+    }
+
+    static uint64_t key(int64_t i, int64_t j, int64_t k) {
+        // far away cells may share a bucket, which only costs a distance check
+        const uint64_t mask = axis_cells - 1;
+        return ((static_cast<uint64_t>(i) & mask) << 42) | ((static_cast<uint64_t>(j) & mask) << 21)
+                | (static_cast<uint64_t>(k) & mask);
+    }
+
+    template<typename Found>
+    void test(const std::vector<size_t> &indices, const QVector &centre, double radius, Found &found) const {
+        for (size_t index : indices) {
+            const Sphere &sphere = spheres[index];
+            if ((sphere.centre - centre).Magnitude() - sphere.radius < radius) {
+                found(sphere.item);
+            }
+        }
+    }
+
+    double cell_size;
+    std::vector<Sphere> spheres;
+    std::vector<size_t> oversized;
+    std::unordered_map<uint64_t, std::vector<size_t>> cells;
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_SPHERE_GRID_H
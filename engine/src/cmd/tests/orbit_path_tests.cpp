@@ -0,0 +1,122 @@
+/*
+ * orbit_path_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "cmd/orbit_path.h"
+
+#include <deque>
+
+namespace {
+// Settling a new system: num_times_to_simulate_new_star_system * SIM_QUEUE_SIZE + 2
+// frames, of which all but SIM_QUEUE_SIZE + 1 are fast-forwarded
+const unsigned int kSkippedFrames = 20 * 128 + 2 - (128 + 1);
+const double kSimulationAtom = 0.1;
+// How many of the orbited unit's positions PlanetaryOrbit::Execute averages
+// (SIM_QUEUE_SIZE / ORBIT_PRIORITY)
+const size_t kAveragedFrames = 128 / 8;
+
+const OrbitPath kPlanet(2.0 * PI * 2.0 * PI / 3600.0, QVector(5e7, 0, 0), QVector(0, 4.5e7, 1e6));
+const OrbitPath kMoon(2.0 * PI * 2.0 * PI / 600.0, QVector(0, 2e6, 0), QVector(2e6, 0, 0));
+const QVector kStar(1e9, -3e8, 2e7);
+const double kPlanetStart = 0.7;
+const double kMoonStart = 2.1;
+
+// What Execute() does frame by frame: theta advances by one simulation atom,
+// a unit on a fixed centre goes straight to its place on the ellipse, and a
+// unit orbiting another one is placed around the average of that one's last
+// positions
+struct Stepped {
+    QVector planet, moon;
+    QVector planet_velocity;
+
+    Stepped() {
+        double planet_theta = kPlanetStart;
+        double moon_theta = kMoonStart;
+        planet = kStar + kPlanet.Offset(planet_theta);
+        std::deque<QVector> centres(kAveragedFrames, planet);
+        for (unsigned int frame = 0; frame < kSkippedFrames; ++frame) {
+            planet_theta += kPlanet.AngularVelocity() * kSimulationAtom;
+            const QVector next = kStar + kPlanet.Offset(planet_theta);
+            planet_velocity = (next - planet) * (1. / kSimulationAtom);
+            planet = next;
+
+            centres.pop_front();
+            centres.push_back(planet);
+            QVector average(0, 0, 0);
+            for (const QVector &centre : centres) {
+                average += centre;
+            }
+            average *= 1. / centres.size();
+            moon_theta += kMoon.AngularVelocity() * kSimulationAtom;
+            moon = average + kMoon.Offset(moon_theta);
+        }
+    }
+};
+
+// What FastForward() does: one step of the whole elapsed time
+struct FastForwarded {
+    QVector planet, moon;
+    QVector planet_velocity;
+
+    FastForwarded() {
+        const double elapsed = kSkippedFrames * kSimulationAtom;
+        const double planet_theta = kPlanetStart + kPlanet.AngularVelocity() * elapsed;
+        planet = kStar + kPlanet.Offset(planet_theta);
+        planet_velocity = kPlanet.Tangent(planet_theta);
+        moon = planet + kMoon.Offset(kMoonStart + kMoon.AngularVelocity() * elapsed);
+    }
+};
+}
+
+TEST(OrbitPath, Focus) {
+    EXPECT_EQ(OrbitPath::Focus(QVector(3, 0, 0), QVector(0, 3, 0)), QVector(0, 0, 0));
+    EXPECT_EQ(OrbitPath::Focus(QVector(5, 0, 0), QVector(0, 3, 0)), QVector(2, 0, 0));
+    EXPECT_EQ(OrbitPath::Focus(QVector(3, 0, 0), QVector(0, 5, 0)), QVector(0, 2, 0));
+}
+
+TEST(OrbitPath, FastForwardMatchesStepping) {
+    const Stepped stepped;
+    const FastForwarded fast;
+
+    // Summing small steps of theta drifts by rounding error only
+    const double radius = kPlanet.x_size.Magnitude();
+    EXPECT_LT((stepped.planet - fast.planet).Magnitude(), radius * 1e-9);
+
+    // Execute() takes the velocity from the last step, so it is off by the
+    // chord's curvature: half a step's turn
+    const double speed = fast.planet_velocity.Magnitude();
+    const double turn = kPlanet.AngularVelocity() * kSimulationAtom;
+    EXPECT_LT((stepped.planet_velocity - fast.planet_velocity).Magnitude(), speed * turn);
+
+    // A moon stepped around the averaged centre trails its planet by about
+    // half the averaging window; the fast-forward puts it on the planet itself
+    const double trail = speed * kSimulationAtom * kAveragedFrames / 2.0;
+    EXPECT_GT((stepped.moon - fast.moon).Magnitude(), trail * 0.5);
+    EXPECT_LT((stepped.moon - fast.moon).Magnitude(), trail * 1.5);
+}
@@ -0,0 +1,141 @@
+/*
+ * sphere_grid_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "cmd/sphere_grid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace {
+struct Ship {
+    QVector position;
+    double radius;
+};
+
+// A fleet spread over a 100 km cube: mostly fighters, some capital ships, a few stations
+std::vector<Ship> makeFleet(size_t count) {
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<double> coordinate(-50000.0, 50000.0);
+    std::vector<Ship> fleet;
+    for (size_t i = 0; i < count; ++i) {
+        double radius = 20.0;
+        if (i % 100 == 0) {
+            radius = 5000.0;
+        } else if (i % 10 == 0) {
+            radius = 600.0;
+        }
+        fleet.push_back(Ship{QVector(coordinate(random), coordinate(random), coordinate(random)), radius});
+    }
+    return fleet;
+}
+
+std::vector<size_t> bruteForce(const std::vector<Ship> &fleet, const QVector &centre, double radius) {
+    std::vector<size_t> hits;
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        if ((fleet[i].position - centre).Magnitude() - fleet[i].radius < radius) {
+            hits.push_back(i);
+        }
+    }
+    return hits;
+}
+}
+
+TEST(SphereGrid, Overlap) {
+    SphereGrid<int> grid(100.0);
+    grid.insert(QVector(0, 0, 0), 10.0, 1);
+    grid.insert(QVector(150, 0, 0), 60.0, 2);     // surface 90 away
+    grid.insert(QVector(-5000, 0, 0), 4950.0, 3); // oversized, surface 50 away
+    grid.insert(QVector(0, 300, 0), 10.0, 4);     // out of reach
+
+    std::vector<int> found;
+    grid.query(QVector(0, 0, 0), 100.0, [&found](int item) {
+        found.push_back(item);
+    });
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(SphereGrid, MatchesBruteForce) {
+    const std::vector<Ship> fleet = makeFleet(5000);
+    SphereGrid<size_t> grid(1500.0);
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        grid.insert(fleet[i].position, fleet[i].radius, i);
+    }
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> coordinate(-55000.0, 55000.0);
+    std::uniform_real_distribution<double> blast(0.0, 1500.0);
+    for (int n = 0; n < 200; ++n) {
+        const QVector centre(coordinate(random), coordinate(random), coordinate(random));
+        const double radius = blast(random);
+        std::vector<size_t> found;
+        grid.query(centre, radius, [&found](size_t item) {
+            found.push_back(item);
+        });
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, bruteForce(fleet, centre, radius));
+    }
+}
+
+TEST(SphereGrid, TorpedoBarrage) {
+    const std::vector<Ship> fleet = makeFleet(20000);
+    // torpedoes detonating among the ships
+    std::vector<QVector> torpedoes;
+    for (size_t i = 0; i < 500; ++i) {
+        torpedoes.push_back(fleet[(i * 37) % fleet.size()].position + QVector(100, 0, 0));
+    }
+    const double radius = 1000.0;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t brute_hits = 0;
+    for (const QVector &torpedo : torpedoes) {
+        brute_hits += bruteForce(fleet, torpedo, radius).size();
+    }
+    const std::chrono::duration<double, std::milli> brute_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    SphereGrid<size_t> grid(radius);
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        grid.insert(fleet[i].position, fleet[i].radius, i);
+    }
+    size_t grid_hits = 0;
+    for (const QVector &torpedo : torpedoes) {
+        grid.query(torpedo, radius, [&grid_hits](size_t) {
+            ++grid_hits;
+        });
+    }
+    const std::chrono::duration<double, std::milli> grid_time = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(grid_hits, brute_hits);
+    std::cout << torpedoes.size() << " torpedoes against " << fleet.size() << " ships: "
+              << brute_time.count() << " ms scanning every unit, "
+              << grid_time.count() << " ms with the grid (including building it)" << std::endl;
+}
@@ -37,6 +37,7 @@ enum class EnergyConsumerSource {
 EnergyConsumerSource GetSource(const int source);
 
 class EnergyConsumer {
+    friend class EnergyStage;
 protected:
     double consumption;         // Directly converted to atomic. Mostly for book keeping.
     double atom_consumption;    // consumption per 0.1 seconds.
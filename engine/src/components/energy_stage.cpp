@@ -0,0 +1,101 @@
+/*
+ * energy_stage.cpp
+ *
+ * Copyright (c) 2001-2002 Daniel Horn
+ * Copyright (c) 2002-2019 pyramid3d and other Vega Strike Contributors
+ * Copyright (c) 2019-2025 Stephen G. Tuggy, Benjamen R. Meyer, Roy Falk and other Vega Strike Contributors
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil -*-
+
+#include "components/energy_stage.h"
+
+#include "components/drive.h"
+#include "components/ecm.h"
+#include "components/energy_container.h"
+#include "components/reactor.h"
+#include "components/shield.h"
+
+void EnergyStage::Add(Reactor &reactor, Drive &drive, Shield *shield, bool player_ship, ECM &ecm) {
+    reactors.push_back({reactor.source, reactor.energy, reactor.ftl_energy,
+                        reactor.atom_consumption, reactor.atom_capacity,
+                        reactor.partial, reactor.infinite});
+    drives.push_back({drive.source, drive.atom_consumption, drive.partial, drive.infinite});
+    if(shield) {
+        shields.push_back({shield, player_ship});
+    }
+    // An inactive ECM draws nothing
+    if(ecm.Active()) {
+        ecms.push_back({ecm.source, ecm.atom_consumption, ecm.partial, ecm.infinite});
+    }
+}
+
+// Same as EnergyConsumer::Consume
+static inline double Consume(EnergyContainer *source, bool partial, bool infinite, double atom_consumption) {
+    if(infinite) {
+        return atom_consumption;
+    }
+
+    if(!source) {
+        return 0.0;
+    }
+
+    return source->Deplete(partial, atom_consumption);
+}
+
+void EnergyStage::Run() {
+    // Production, as Reactor::Generate
+    for(const Production& reactor : reactors) {
+        const double power = Consume(reactor.fuel, reactor.partial, reactor.infinite, reactor.atom_consumption);
+
+        // Zero out fuel if power is 0
+        if(power < 0.0001) {
+            if(reactor.fuel) {
+                reactor.fuel->Zero();
+            }
+            continue;
+        }
+
+        double surplus = reactor.energy->Charge(reactor.atom_capacity * power);
+        surplus = reactor.ftl_energy->Charge(reactor.atom_capacity * surplus);
+    }
+
+    for(const Draw& drive : drives) {
+        Consume(drive.source, drive.partial, drive.infinite, drive.atom_consumption);
+    }
+
+    // Regeneration depends on the state of each shield; it is not batched
+    for(const Regeneration& regeneration : shields) {
+        regeneration.shield->Regenerate(regeneration.player_ship);
+    }
+
+    for(const Draw& ecm : ecms) {
+        Consume(ecm.source, ecm.partial, ecm.infinite, ecm.atom_consumption);
+    }
+
+    reactors.clear();
+    drives.clear();
+    shields.clear();
+    ecms.clear();
+}
+
+size_t EnergyStage::Size() const {
+    return reactors.size();
+}
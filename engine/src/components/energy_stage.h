@@ -0,0 +1,87 @@
+/*
+ * energy_stage.h
+ *
+ * Copyright (c) 2001-2002 Daniel Horn
+ * Copyright (c) 2002-2019 pyramid3d and other Vega Strike Contributors
+ * Copyright (c) 2019-2025 Stephen G. Tuggy, Benjamen R. Meyer, Roy Falk and other Vega Strike Contributors
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil -*-
+
+#ifndef VEGA_STRIKE_ENGINE_COMPONENTS_ENERGY_STAGE_H
+#define VEGA_STRIKE_ENGINE_COMPONENTS_ENERGY_STAGE_H
+
+#include <cstddef>
+#include <vector>
+
+class Drive;
+class ECM;
+class EnergyContainer;
+class Reactor;
+class Shield;
+
+/**
+ * @brief The EnergyStage class runs the power flow of many ships at once.
+ * @details Each kind of component goes into its own contiguous batch, which
+ * is then run in one loop: every reactor, then every drive, shield and ECM.
+ * That is the order each ship ran them in on its own, and ships do not
+ * share containers, so the containers end up exactly as if the ships had
+ * been updated one by one.
+ */
+class EnergyStage {
+public:
+    // shield may be null for ships that have no shield to regenerate
+    void Add(Reactor &reactor, Drive &drive, Shield *shield, bool player_ship, ECM &ecm);
+
+    // Produces and draws the energy of every ship added, then clears the batches
+    void Run();
+
+    size_t Size() const;
+
+private:
+    struct Production {
+        EnergyContainer *fuel;
+        EnergyContainer *energy;
+        EnergyContainer *ftl_energy;
+        double atom_consumption;
+        double atom_capacity;
+        bool partial;
+        bool infinite;
+    };
+
+    struct Draw {
+        EnergyContainer *source;
+        double atom_consumption;
+        bool partial;
+        bool infinite;
+    };
+
+    struct Regeneration {
+        Shield *shield;
+        bool player_ship;
+    };
+
+    std::vector<Production> reactors;
+    std::vector<Draw> drives;
+    std::vector<Regeneration> shields;
+    std::vector<Draw> ecms;
+};
+
+#endif // VEGA_STRIKE_ENGINE_COMPONENTS_ENERGY_STAGE_H
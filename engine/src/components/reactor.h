@@ -37,6 +37,7 @@ class EnergyManager;
 
 class Reactor: public Component, public EnergyConsumer
 {
+    friend class EnergyStage;
 private:
     Resource<double> capacity;          // Capacity per second
     double atom_capacity;               // Capacity per atom
@@ -0,0 +1,214 @@
+/*
+ * energy_stage_tests.cpp
+ *
+ * Copyright (C) 2001-2025 Daniel Horn, Benjamen Meyer, Roy Falk, Stephen G. Tuggy,
+ * and other Vega Strike contributors.
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "components/cloak.h"
+#include "components/drive.h"
+#include "components/ecm.h"
+#include "components/energy_container.h"
+#include "components/energy_stage.h"
+#include "components/ftl_drive.h"
+#include "components/reactor.h"
+#include "components/shield.h"
+#include "cmd/unit_csv_factory.h"
+
+namespace {
+
+const std::string shielded_ship = "EnergyStageShip__upgrades";
+
+const std::map<std::string, std::string> shielded_ship_map = {
+    {"shield", "120"},
+    {"shield_facets", "4"},
+    {"Shield_Recharge", "8"},
+};
+
+// The components of a ship that take part in its power flow
+struct PoweredShip {
+    EnergyContainer fuel = EnergyContainer(ComponentType::Fuel);
+    EnergyContainer energy = EnergyContainer(ComponentType::Capacitor);
+    EnergyContainer ftl_energy = EnergyContainer(ComponentType::FtlCapacitor);
+    Reactor reactor = Reactor(&fuel, &energy, &ftl_energy);
+    Drive drive = Drive(&fuel);
+    FtlDrive ftl_drive = FtlDrive(&ftl_energy);
+    Cloak cloak;
+    Shield shield = Shield(&energy, &ftl_drive, &cloak);
+    ECM ecm = ECM(&energy);
+    bool shielded = false;
+
+    // The per ship sequence of Unit::UpdatePhysics3
+    void Update() {
+        reactor.Generate();
+        drive.Consume();
+        if(shielded) {
+            shield.Regenerate(false);
+        }
+        ecm.Consume();
+    }
+
+    void Stage(EnergyStage& stage) {
+        stage.Add(reactor, drive, shielded ? &shield : nullptr, false, ecm);
+    }
+};
+
+// Two identical fleets of varied ships, one to update ship by ship and one
+// to run through the stage
+void makeFleets(size_t count,
+                std::vector<std::unique_ptr<PoweredShip>>& by_ship,
+                std::vector<std::unique_ptr<PoweredShip>>& staged) {
+    UnitCSVFactory::LoadUnit(shielded_ship, shielded_ship_map);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for(size_t i = 0; i < count; ++i) {
+        const double fuel = 0.5 + 4.0 * unit(rng);
+        const double energy = 50.0 + 250.0 * unit(rng);
+        const double ftl_energy = 100.0 + 200.0 * unit(rng);
+        const double capacity = 5.0 + 60.0 * unit(rng);
+        const double drive = 0.0005 + 0.002 * unit(rng);
+        const double ecm = 40.0 * unit(rng);
+        const bool ecm_active = unit(rng) < 0.3;
+        const bool shielded = unit(rng) < 0.5;
+        for(auto *fleet : {&by_ship, &staged}) {
+            std::unique_ptr<PoweredShip> ship(new PoweredShip());
+            ship->fuel.SetCapacity(fuel);
+            ship->energy.SetCapacity(energy);
+            ship->ftl_energy.SetCapacity(ftl_energy, false);
+            ship->reactor.SetCapacity(capacity);
+            ship->drive.SetConsumption(drive);
+            ship->ecm.SetConsumption(ecm);
+            if(ecm_active) {
+                ship->ecm.Toggle();
+            }
+            ship->shielded = shielded;
+            if(shielded) {
+                ship->shield.Load(shielded_ship);
+                ship->shield.Zero();
+            }
+            fleet->push_back(std::move(ship));
+        }
+    }
+}
+
+void expectSameState(const PoweredShip& expected, const PoweredShip& actual) {
+    const double expected_levels[] = {expected.fuel.Level(), expected.energy.Level(), expected.ftl_energy.Level(),
+                                      expected.shield.TotalLayerValue()};
+    const double actual_levels[] = {actual.fuel.Level(), actual.energy.Level(), actual.ftl_energy.Level(),
+                                    actual.shield.TotalLayerValue()};
+    // Bit for bit, not merely close
+    EXPECT_EQ(std::memcmp(expected_levels, actual_levels, sizeof(expected_levels)), 0);
+}
+
+} // namespace
+
+TEST(EnergyStage, MatchesShipByShipUpdates) {
+    std::vector<std::unique_ptr<PoweredShip>> by_ship;
+    std::vector<std::unique_ptr<PoweredShip>> staged;
+    makeFleets(200, by_ship, staged);
+
+    EnergyStage stage;
+    for(int step = 0; step < 3000; ++step) {
+        for(auto& ship : by_ship) {
+            ship->Update();
+        }
+        for(auto& ship : staged) {
+            ship->Stage(stage);
+        }
+        EXPECT_EQ(stage.Size(), staged.size());
+        stage.Run();
+        EXPECT_EQ(stage.Size(), 0u);
+    }
+
+    for(size_t i = 0; i < by_ship.size(); ++i) {
+        expectSameState(*by_ship[i], *staged[i]);
+    }
+}
+
+// The fuel burn of balancing_tests, through the stage
+TEST(EnergyStage, RobinFuelBurn) {
+    PoweredShip robin;
+    robin.fuel.SetCapacity(3.51);
+    robin.energy.SetCapacity(100.0);
+    robin.ftl_energy.SetCapacity(200.0);
+    robin.reactor.SetCapacity(15.0);
+    robin.drive.SetConsumption(0.001);
+    robin.ecm.SetConsumption(15.0);
+    robin.ecm.Toggle();
+
+    PoweredShip expected;
+    expected.fuel.SetCapacity(3.51);
+    expected.energy.SetCapacity(100.0);
+    expected.ftl_energy.SetCapacity(200.0);
+    expected.reactor.SetCapacity(15.0);
+    expected.drive.SetConsumption(0.001);
+    expected.ecm.SetConsumption(15.0);
+    expected.ecm.Toggle();
+
+    EnergyStage stage;
+    int iterations = 0;
+    for(; iterations < 36000 && !robin.fuel.Depleted(); ++iterations) {
+        expected.Update();
+        robin.Stage(stage);
+        stage.Run();
+    }
+    expectSameState(expected, robin);
+    EXPECT_GT(iterations, 12000);
+}
+
+TEST(EnergyStage, ThousandsOfShips) {
+    std::vector<std::unique_ptr<PoweredShip>> by_ship;
+    std::vector<std::unique_ptr<PoweredShip>> staged;
+    makeFleets(5000, by_ship, staged);
+    const int steps = 100;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int step = 0; step < steps; ++step) {
+        for(auto& ship : by_ship) {
+            ship->Update();
+        }
+    }
+    const double ship_by_ship = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    EnergyStage stage;
+    start = std::chrono::steady_clock::now();
+    for(int step = 0; step < steps; ++step) {
+        for(auto& ship : staged) {
+            ship->Stage(stage);
+        }
+        stage.Run();
+    }
+    const double batched = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "5000 ships, " << steps << " atoms: ship by ship " << ship_by_ship
+              << " ms, staged " << batched << " ms" << std::endl;
+    for(size_t i = 0; i < by_ship.size(); ++i) {
+        expectSameState(*by_ship[i], *staged[i]);
+    }
+}
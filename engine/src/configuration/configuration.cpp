@@ -2071,6 +2071,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 general.audio_atom = boost::json::value_to<double>(*audio_atom_value_ptr);
             }
 
+            const boost::json::value * binary_savegames_value_ptr = general_object.if_contains("binary_savegames");
+            if (binary_savegames_value_ptr != nullptr) {
+                general.binary_savegames = boost::json::value_to<bool>(*binary_savegames_value_ptr);
+            }
+
             const boost::json::value * command_interpreter_value_ptr = general_object.if_contains("command_interpreter");
             if (command_interpreter_value_ptr != nullptr) {
                 general.command_interpreter = boost::json::value_to<bool>(*command_interpreter_value_ptr);
@@ -2161,6 +2166,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 general.pitch = boost::json::value_to<double>(*pitch_value_ptr);
             }
 
+            const boost::json::value * python_bytecode_cache_value_ptr = general_object.if_contains("python_bytecode_cache");
+            if (python_bytecode_cache_value_ptr != nullptr) {
+                general.python_bytecode_cache = boost::json::value_to<bool>(*python_bytecode_cache_value_ptr);
+            }
+
             const boost::json::value * quick_savegame_summaries_value_ptr = general_object.if_contains("quick_savegame_summaries");
             if (quick_savegame_summaries_value_ptr != nullptr) {
                 general.quick_savegame_summaries = boost::json::value_to<bool>(*quick_savegame_summaries_value_ptr);
@@ -2282,6 +2292,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 graphics.aspect = boost::json::value_to<double>(*aspect_value_ptr);
             }
 
+            const boost::json::value * async_texture_decode_value_ptr = graphics_object.if_contains("async_texture_decode");
+            if (async_texture_decode_value_ptr != nullptr) {
+                graphics.async_texture_decode = boost::json::value_to<bool>(*async_texture_decode_value_ptr);
+            }
+
             const boost::json::value * atmosphere_emissive_value_ptr = graphics_object.if_contains("atmosphere_emissive");
             if (atmosphere_emissive_value_ptr != nullptr) {
                 graphics.atmosphere_emissive = boost::json::value_to<double>(*atmosphere_emissive_value_ptr);
@@ -3492,6 +3507,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 graphics.star_streaks = boost::json::value_to<bool>(*star_streaks_value_ptr);
             }
 
+            const boost::json::value * starfield_disk_cache_value_ptr = graphics_object.if_contains("starfield_disk_cache");
+            if (starfield_disk_cache_value_ptr != nullptr) {
+                graphics.starfield_disk_cache = boost::json::value_to<bool>(*starfield_disk_cache_value_ptr);
+            }
+
             const boost::json::value * stars_alpha_test_cutoff_value_ptr = graphics_object.if_contains("stars_alpha_test_cutoff");
             if (stars_alpha_test_cutoff_value_ptr != nullptr) {
                 graphics.stars_alpha_test_cutoff = boost::json::value_to<double>(*stars_alpha_test_cutoff_value_ptr);
@@ -3557,6 +3577,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 graphics.texture_compression = boost::json::value_to<int>(*texture_compression_value_ptr);
             }
 
+            const boost::json::value * texture_uploads_per_frame_value_ptr = graphics_object.if_contains("texture_uploads_per_frame");
+            if (texture_uploads_per_frame_value_ptr != nullptr) {
+                graphics.texture_uploads_per_frame = boost::json::value_to<int>(*texture_uploads_per_frame_value_ptr);
+            }
+
             const boost::json::value * torque_star_streak_scale_value_ptr = graphics_object.if_contains("torque_star_streak_scale");
             if (torque_star_streak_scale_value_ptr != nullptr) {
                 graphics.torque_star_streak_scale = boost::json::value_to<double>(*torque_star_streak_scale_value_ptr);
@@ -4692,6 +4717,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 physics.allow_special_and_normal_gun_combo = boost::json::value_to<bool>(*allow_special_and_normal_gun_combo_value_ptr);
             }
 
+            const boost::json::value * analytic_new_star_system_warmup_value_ptr = physics_object.if_contains("analytic_new_star_system_warmup");
+            if (analytic_new_star_system_warmup_value_ptr != nullptr) {
+                physics.analytic_new_star_system_warmup = boost::json::value_to<bool>(*analytic_new_star_system_warmup_value_ptr);
+            }
+
             const boost::json::value * asteroid_difficulty_value_ptr = physics_object.if_contains("asteroid_difficulty");
             if (asteroid_difficulty_value_ptr != nullptr) {
                 physics.asteroid_difficulty = boost::json::value_to<double>(*asteroid_difficulty_value_ptr);
@@ -528,6 +528,7 @@ namespace vega_config {
 
     struct {
         double audio_atom = 0.05555555556;
+        bool binary_savegames = false;
         bool command_interpreter = false;
         std::string custom_python = "import custom;custom.processMessage";
         bool debug_config = true;
@@ -546,6 +547,7 @@ namespace vega_config {
         double percentage_speed_change_to_fault_search = 300.0;
         bool persistent_mission_across_ship_switch = true;
         double pitch = 0.0;
+        bool python_bytecode_cache = true;
         bool quick_savegame_summaries = true;
         int quick_savegame_summaries_buffer_size = 16384;
         bool remember_savegame = true;
@@ -573,6 +575,7 @@ namespace vega_config {
         double anim_far_percent = 0.8;
         std::string armor_flash_animation = "armorflash.ani";
         double aspect = 1.33;
+        bool async_texture_decode = true;
         double atmosphere_emissive = 1.0;
         double atmosphere_diffuse = 1.0;
         int atmosphere_texture_resolution = 512;
@@ -815,6 +818,7 @@ namespace vega_config {
         double star_spread_attenuation = 0.4;
         double star_spreading = 30000.0;
         bool star_streaks = true;
+        bool starfield_disk_cache = false;
         double stars_alpha_test_cutoff = 0.2;
         bool stars_dont_move = true;
         std::string startup_cockpit_view = "front";
@@ -828,6 +832,7 @@ namespace vega_config {
         double text_speed = 0.025;
         std::string texture = "supernova.bmp";
         int texture_compression = 0;
+        int texture_uploads_per_frame = 8;
         double torque_star_streak_scale = 1.0;
         bool unit_switch_cockpit_change = false;
         std::string unprintable_faction_extension = "citizen";
@@ -1083,6 +1088,7 @@ namespace vega_config {
         bool ai_pilot_when_in_turret = false;
         bool allow_mission_abort = true;
         bool allow_special_and_normal_gun_combo = true;
+        bool analytic_new_star_system_warmup = true;
         double asteroid_difficulty = 0.1;
         bool asteroid_weapon_collision = false;
         double auto_docking_speed_boost = 20.0;
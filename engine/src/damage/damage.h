@@ -64,15 +64,12 @@ struct InflictedDamage {
     // shield, armor and hull. But this makes this implementation inflexible.
     std::vector<double> inflicted_damage_by_layer;
 
-    InflictedDamage(int number_of_layers = 3) {
+    InflictedDamage(int number_of_layers = 3) :
+            inflicted_damage_by_layer(number_of_layers, 0.0) {
         total_damage = 0.0;
         normal_damage = 0.0;
         phase_damage = 0.0;
         propulsion_damage = 0.0;
-
-        for (int i = 0; i < number_of_layers; i++) {
-            inflicted_damage_by_layer.push_back(0.0f);
-        }
     }
 
     InflictedDamage() = delete;
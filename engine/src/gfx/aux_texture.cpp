@@ -36,7 +36,11 @@
 #include "src/in_kb.h"
 #include "src/main_loop.h"
 #include "gfx/aux_texture.h"
+#include "gfx/texture_decode.h"
 #include "root_generic/configxml.h"
+#include "configuration/configuration.h"
+#include "src/vs_logging.h"
+#include <algorithm>
 
 using std::string;
 using namespace VSFileSystem;
@@ -44,6 +48,8 @@ using namespace XMLSupport;
 ///holds all the textures in a huge hash table
 Hashtable<string, Texture, 4007> texHashTable;
 Hashtable<string, bool, 4007> badtexHashTable;
+///textures whose image is still being decoded in the background
+static std::vector<Texture *> pending_textures;
 
 Texture *Texture::Exists(string s, string a) {
     return Texture::Exists(s + a);
@@ -120,6 +126,8 @@ void Texture::InitTexture() {
     mintcoord = Vector(0.0f, 0.0f, 0.0f);
     maxtcoord = Vector(1.0f, 1.0f, 1.0f);
     address_mode = DEFAULT_ADDRESS_MODE;
+    decode.reset();
+    mip_chain = nullptr;
 }
 
 void Texture::setold() {
@@ -149,6 +157,10 @@ Texture *Texture::Original() {
 Texture *Texture::Clone() {
     Texture *retval = new Texture();
     Texture *target = Original();
+    //callers of Clone expect a bound texture with its size known, so finish a background load first
+    while (target->decode) {
+        target->FinishLoad();
+    }
     *retval = *target;
     //memcpy (this, target, sizeof (Texture));
     if (retval->name != -1) {
@@ -266,7 +278,8 @@ Texture::Texture(const char *FileName,
         GFXBOOL detailtexture,
         GFXBOOL nocache,
         enum ADDRESSMODE address_mode,
-        Texture *main) {
+        Texture *main,
+        bool async) {
     InitTexture();
     Load(FileName,
             stage,
@@ -278,7 +291,8 @@ Texture::Texture(const char *FileName,
             detailtexture,
             nocache,
             address_mode,
-            main);
+            main,
+            async);
 }
 
 void Texture::Load(const char *FileName,
@@ -291,7 +305,8 @@ void Texture::Load(const char *FileName,
         GFXBOOL detailtexture,
         GFXBOOL nocache,
         enum ADDRESSMODE address_mode,
-        Texture *main) {
+        Texture *main,
+        bool async) {
     if (data != nullptr) {
         free(data);
         data = nullptr;
@@ -324,7 +339,8 @@ void Texture::Load(const char *FileName,
         t[tmp - 2] = 'l';
         t[tmp - 1] = 'p';
     }
-    VSFile f2;
+    //heap allocated so that a background decode can take them over
+    std::unique_ptr<VSFile> f2(new VSFile);
     VSError err2 = VSFileSystem::FileNotFound;
     if (t) {
         if (t[0] != '\0') {
@@ -332,7 +348,7 @@ void Texture::Load(const char *FileName,
                     "bitmap_alphamap",
                     "true"));
             if (use_alphamap) {
-                err2 = f2.OpenReadOnly(t, TextureFile);
+                err2 = f2->OpenReadOnly(t, TextureFile);
             }
         }
     }
@@ -341,24 +357,24 @@ void Texture::Load(const char *FileName,
     }
     //this->texfilename = texfilename;
     //strcpy (filename,texfilename.c_str());
-    VSFile f;
+    std::unique_ptr<VSFile> f(new VSFile);
     VSError err; //FIXME err not always initialized before use
     err = Ok; //FIXME this line added temporarily by chuck_starchaser
     if (FileName) {
         if (FileName[0]) {
-            err = f.OpenReadOnly(FileName, TextureFile);
+            err = f->OpenReadOnly(FileName, TextureFile);
         }
     }
     bool shared = (err == Shared);
     free(t);
     if (err <= Ok && g_game.use_textures == 0 && !force_load) {
-        f.Close();
+        f->Close();
         err = Unspecified;
     }
     if (err > Ok) { //FIXME err not guaranteed to have been initialized!
         FileNotFound(texfn);
         if (err2 <= Ok) {
-            f2.Close();
+            f2->Close();
         }
         return;
     }
@@ -370,11 +386,27 @@ void Texture::Load(const char *FileName,
     if (texfn.find("white") == string::npos) {
         bootstrap_draw("Loading " + string(FileName));
     }
+    if (async && main == nullptr && configuration()->graphics.async_texture_decode) {
+        if (err2 > Ok) {
+            f2.reset();
+        }
+        decode = SubmitTextureDecode(std::move(f), std::move(f2), (ismipmapped & (MIPMAP | TRILINEAR)) != 0);
+        decode->maxdimension = maxdimension;
+        decode->detailtexture = detailtexture;
+        decode->filename = texfn;
+        if (!nocache) {
+            //the cached original owns the name, so it finishes the load for everyone sharing it
+            setold();
+            decode.reset();
+        }
+        pending_textures.push_back(Original());
+        return;
+    }
     //strcpy(filename, FileName);
     if (err2 > Ok) {
-        data = this->ReadImage(&f, NULL, true, NULL);
+        data = this->ReadImage(f.get(), NULL, true, NULL);
     } else {
-        data = this->ReadImage(&f, NULL, true, &f2);
+        data = this->ReadImage(f.get(), NULL, true, f2.get());
     }
     if (data) {
         if (mode >= _DXT1 && mode <= _DXT5) {
@@ -396,9 +428,9 @@ void Texture::Load(const char *FileName,
     } else {
         FileNotFound(texfilename);
     }
-    f.Close();
-    if (f2.Valid()) {
-        f2.Close();
+    f->Close();
+    if (f2->Valid()) {
+        f2->Close();
     }
 }
 
@@ -549,6 +581,10 @@ Texture::~Texture() {
          *             data = NULL;
          *     }
          */
+        if (decode) {
+            pending_textures.erase(std::remove(pending_textures.begin(), pending_textures.end(), this),
+                    pending_textures.end());
+        }
         UnBind();
         if (palette != nullptr) {
             free(palette);
@@ -607,7 +643,17 @@ void Texture::Transfer(int maxdimension, GFXBOOL detailtexture) {
         default:
             return;
     }
-    if (img_sides == SIDE_SINGLE) {
+    if (img_sides == SIDE_SINGLE && mip_chain != nullptr && !mip_chain->empty() && !detailtexture) {
+        std::vector<const unsigned char *> levels(1, data);
+        for (const auto &level : *mip_chain) {
+            levels.push_back(level.data());
+        }
+        if (!GFXTransferMipChain(levels.data(), int(levels.size()), name, sizeX, sizeY, internformat, image_target,
+                maxdimension)) {
+            //let the driver build the mips from the base level as for any other texture
+            GFXTransferTexture(data, name, sizeX, sizeY, internformat, image_target, maxdimension, detailtexture);
+        }
+    } else if (img_sides == SIDE_SINGLE) {
         GFXTransferTexture(data, name, sizeX, sizeY, internformat, image_target, maxdimension, detailtexture);
     } else {
         GFXTransferTexture(data, name, sizeX, sizeY, internformat, CUBEMAP_POSITIVE_X, maxdimension, detailtexture, 0);
@@ -679,6 +725,88 @@ int Texture::Bind(Texture *other, int maxdimension, GFXBOOL detailtexture) {
     return name;
 }
 
+bool Texture::FinishLoad() {
+    std::shared_ptr<TextureDecodeJob> job;
+    job.swap(decode);
+    pending_textures.erase(std::remove(pending_textures.begin(), pending_textures.end(), this),
+            pending_textures.end());
+    job->wait();
+    if (job->data == nullptr) {
+        VS_LOG(error, (boost::format("Could not decode texture %1%") % job->filename));
+        texHashTable.Delete(texfilename);
+        setbad(job->filename);
+        name = -1;
+        if (!job->fallback.empty()) {
+            //LoadSuccess already said yes, so load the fallback here instead of in the caller.
+            //It is not cached, since this texture may already have left the cache
+            Load(job->fallback.c_str(), stage, ismipmapped, texture_target, image_target, GFXTRUE,
+                    job->maxdimension, job->detailtexture, GFXTRUE, address_mode, nullptr, true);
+            return decode != nullptr;
+        }
+        return false;
+    }
+    mode = job->image.mode;
+    sizeX = job->image.sizeX;
+    sizeY = job->image.sizeY;
+    img_sides = job->image.Sides();
+    if (palette != nullptr) {
+        free(palette);
+    }
+    palette = job->image.palette;
+    job->image.palette = nullptr;
+    GFXBOOL detailtexture = job->detailtexture;
+    data = job->data;
+    if (mode >= _DXT1 && mode <= _DXT5) {
+        if ((int) data[0] == 0) {
+            detailtexture = NEAREST;
+            ismipmapped = NEAREST;
+        }
+    }
+    mip_chain = &job->mips;
+    Bind(job->maxdimension, detailtexture);
+    mip_chain = nullptr;
+    data = nullptr;
+    return true;
+}
+
+void Texture::FinishPending() {
+    Texture *owner = Original();
+    if (owner->decode && owner->decode->ready()) {
+        owner->FinishLoad();
+    }
+    if (owner != this && owner->name != -1) {
+        name = owner->name;
+        bound = owner->bound;
+        boundSizeX = owner->boundSizeX;
+        boundSizeY = owner->boundSizeY;
+        boundMode = owner->boundMode;
+    }
+}
+
+void Texture::FinishPendingLoads(int budget) {
+    for (size_t i = 0; i < pending_textures.size() && budget > 0;) {
+        Texture *texture = pending_textures[i];
+        if (texture->decode->ready()) {
+            //removes itself from pending_textures
+            texture->FinishLoad();
+            --budget;
+        } else {
+            ++i;
+        }
+    }
+}
+
+void Texture::SetFallback(const std::string &filename) {
+    Texture *owner = Original();
+    if (owner->decode) {
+        owner->decode->fallback = filename;
+    }
+}
+
+bool Texture::LoadSuccess() {
+    return name >= 0 || Original()->decode != nullptr;
+}
+
 void Texture::Prioritize(float priority) {
     GFXPrioritizeTexture(name, priority);
 }
@@ -691,6 +819,9 @@ static void ActivateWhite(int stage) {
 }
 
 void Texture::MakeActive(int stag, int pass) {
+    if (name == -1) {
+        FinishPending();
+    }
     if ((name == -1) || (pass != 0)) {
         ActivateWhite(stag);
     } else {
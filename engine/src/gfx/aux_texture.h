@@ -29,7 +29,9 @@
 #include "src/gfxlib_struct.h"
 #include "src/SharedPool.h"
 
+#include <memory>
 #include <string>
+#include <vector>
 //#include "gfx/vsimage.h"
 //#include "root_generic/vsfilesystem.h" this is included by gfxlib.h
 
@@ -39,6 +41,8 @@
  *  to prevent the loading of duplicate textures
  */
 ;
+class TextureDecodeJob;
+
 class Texture : public ::VSImage {
     typedef unsigned int uint;
 public:
@@ -80,6 +84,12 @@ public:
     ///The address mode being used with this texture
     enum ADDRESSMODE address_mode;
 
+    ///Set while the image is decoded in the background, on the texture that owns the GFX name
+    std::shared_ptr<TextureDecodeJob> decode;
+
+    ///Prebuilt mip levels for Transfer, only set while finishing a background load
+    const std::vector<std::vector<unsigned char> > *mip_chain;
+
     ///Returns if this texture is actually already loaded
     GFXBOOL checkold(const std::string &s, bool shared, std::string &hashname);
     void modold(const std::string &s, bool shared, std::string &hashname);
@@ -103,6 +113,12 @@ protected:
     ///Transfers this texture to GFX library
     void Transfer(int maxdimension, GFXBOOL detailtexture);
 
+    ///Uploads the result of the background decode, returns whether it succeeded
+    bool FinishLoad();
+
+    ///Finishes a pending load if it is ready, and picks up the name of the original once it has one
+    void FinishPending();
+
 public:
 
     ///Binds this texture to the same name as the given texture - for multipart textures
@@ -134,6 +150,8 @@ public:
             Texture *main = 0);
 
     ///Creates a texture with only color data as a single bitmap
+    ///With async (and graphics.async_texture_decode) the image is decoded in the background and
+    ///the texture draws as white until it is uploaded; sizeX, sizeY and mode are not known until then
     Texture(const char *FileName,
             int stage = 0,
             enum FILTER mipmap = MIPMAP,
@@ -144,7 +162,8 @@ public:
             GFXBOOL detail_texture = GFXFALSE,
             GFXBOOL nocache = false,
             enum ADDRESSMODE address_mode = DEFAULT_ADDRESS_MODE,
-            Texture *main = 0);
+            Texture *main = 0,
+            bool async = false);
     Texture(VSFileSystem::VSFile *f,
             int stage = 0,
             enum FILTER mipmap = MIPMAP,
@@ -180,7 +199,8 @@ public:
             GFXBOOL detail_texture = GFXFALSE,
             GFXBOOL nocache = false,
             enum ADDRESSMODE address_mode = DEFAULT_ADDRESS_MODE,
-            Texture *main = 0);
+            Texture *main = 0,
+            bool async = false);
     virtual const Texture *Original() const;
     virtual Texture *Original();
     virtual Texture *Clone();
@@ -272,10 +292,14 @@ public:
         return true;
     }                                                                                                              //If one is going to perform multipass rendering of this texture, the Texture() must handle blending - SetupPass() sets up blending. If it returns false, then blending is not compatible with the requested blend mode emulation. One may assume that if numPasses()==1, no SetupPass() is needed. pass==-1 means restore setup. You should call it after multipass rendering.
 
-    ///If the texture has loaded properly returns true
-    virtual bool LoadSuccess() {
-        return name >= 0;
-    }
+    ///If the texture has loaded properly (or is still being decoded) returns true
+    virtual bool LoadSuccess();
+
+    ///Names the file to load instead if a background decode fails after LoadSuccess returned true
+    void SetFallback(const std::string &filename);
+
+    ///Uploads up to budget background loads that have finished decoding. Call from the render thread
+    static void FinishPendingLoads(int budget);
 
     ///Changes priority of texture
     virtual void Prioritize(float);
@@ -39,33 +39,19 @@
 #include <float.h>
 const float size = 100;
 
+static std::string FarStarsSystem(const std::string &filename) {
+    static bool use_star_coords =
+            XMLSupport::parse_bool(vs_config->getVariable("graphics", "use_star_coords", "true"));
+    return use_star_coords ? filename : "";
+}
+
 Background::Background(const char *file,
-        int numstars,
+        const StarfieldFuture &starfield,
         float spread,
-        const std::string &filename,
         const GFXColor &color_,
         bool degamma_)
         : Enabled(true), degamma(degamma_), color(color_), stars(NULL) {
     string temp;
-    static string starspritetextures = vs_config->getVariable("graphics", "far_stars_sprite_texture", "");
-    static float starspritesize =
-            XMLSupport::parse_float(vs_config->getVariable("graphics", "far_stars_sprite_size", "2"));
-    if (starspritetextures.length() == 0) {
-        stars =
-                new PointStarVlist(numstars, 200 /*spread*/,
-                        XMLSupport::parse_bool(vs_config->getVariable("graphics",
-                                "use_star_coords",
-                                "true")) ? filename : "");
-    } else {
-        stars =
-                new SpriteStarVlist(numstars,
-                        200 /*spread*/,
-                        XMLSupport::parse_bool(vs_config->getVariable("graphics",
-                                "use_star_coords",
-                                "true")) ? filename : "",
-                        starspritetextures,
-                        starspritesize);
-    }
     up = left = down = front = right = back = NULL;
 
     SphereBackground = NULL;
@@ -126,6 +112,24 @@ Background::Background(const char *file,
         //down->Filter();
     }
 #endif
+    //generated on a worker while the textures above were loading
+    static string starspritetextures = vs_config->getVariable("graphics", "far_stars_sprite_texture", "");
+    static float starspritesize =
+            XMLSupport::parse_float(vs_config->getVariable("graphics", "far_stars_sprite_size", "2"));
+    if (starspritetextures.length() == 0) {
+        stars = new PointStarVlist(starfield, 200 /*spread*/);
+    } else {
+        stars = new SpriteStarVlist(starfield, 200 /*spread*/, starspritetextures, starspritesize);
+    }
+}
+
+StarfieldFuture Background::RequestStars(int numstars, const std::string &filename) {
+    static string starspritetextures = vs_config->getVariable("graphics", "far_stars_sprite_texture", "");
+    if (starspritetextures.length() == 0) {
+        return PointStarVlist::Request(numstars, 200 /*spread*/, FarStarsSystem(filename), filename);
+    } else {
+        return SpriteStarVlist::Request(numstars, 200 /*spread*/, FarStarsSystem(filename), filename);
+    }
 }
 
 void Background::EnableBG(bool tf) {
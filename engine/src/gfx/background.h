@@ -28,6 +28,7 @@
 #define VEGA_STRIKE_ENGINE_GFX_BACKGROUND_H
 
 #include "src/gfxlib_struct.h"
+#include "gfx/starfield.h"
 
 class SphereMesh;
 class Texture;
@@ -45,13 +46,15 @@ class Background {
     Texture *down;
     SphereMesh *SphereBackground;
 public:
+    ///starfield is the far stars, see RequestStars
     Background(const char *file,
-            int numstars,
+            const StarfieldFuture &starfield,
             float spread,
-            const std::string &starfilename,
             const GFXColor &color,
             bool degamma);
     ~Background();
+    ///Starts generating the far stars of the system in filename, to be handed to the constructor
+    static StarfieldFuture RequestStars(int numstars, const std::string &filename);
     void EnableBG(bool);
     void Draw();
     struct BackgroundClone {
@@ -517,6 +517,11 @@ void DrawNavigationSymbol( const Vector &Loc, const Vector &P, const Vector &Q,
 
 bool DrawNavSystem(NavigationSystem* nav_system, Camera* camera, float cockpit_offset)
 {
+    // Saved paths are searched in the background, pick up what came in
+    if(nav_system->pathman) {
+        nav_system->pathman->poll();
+    }
+
     if(!nav_system->CheckDraw()) {
         return false;
     }
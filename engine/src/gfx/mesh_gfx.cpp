@@ -269,10 +269,15 @@ Texture *Mesh::TempGetTexture(MeshXML *xml, std::string filename, std::string fa
             return ret;
         }
     }
-    ret = new Texture(facplus.c_str(), 1, fil, TEXTURE2D, TEXTURE_2D, GFXFALSE, 65536, detail);
+    //mesh textures are decoded in the background, see Texture::Load
+    ret = new Texture(facplus.c_str(), 1, fil, TEXTURE2D, TEXTURE_2D, GFXFALSE, 65536, detail, GFXFALSE,
+            DEFAULT_ADDRESS_MODE, nullptr, true);
     if (!ret->LoadSuccess()) {
         delete ret;
-        ret = new Texture(filename.c_str(), 1, fil, TEXTURE2D, TEXTURE_2D, GFXFALSE, 65536, detail);
+        ret = new Texture(filename.c_str(), 1, fil, TEXTURE2D, TEXTURE_2D, GFXFALSE, 65536, detail, GFXFALSE,
+                DEFAULT_ADDRESS_MODE, nullptr, true);
+    } else if (facplus != filename) {
+        ret->SetFallback(filename);
     }
     return ret;
 }
@@ -334,13 +339,17 @@ Texture *Mesh::TempGetTexture(MeshXML *xml, int index, std::string factionname)
             tex =
                     new Texture(
                             temptex.c_str(), 0, MIPMAP, TEXTURE2D, TEXTURE_2D,
-                            (g_game.use_ship_textures || xml->force_texture) ? GFXTRUE : GFXFALSE);
+                            (g_game.use_ship_textures || xml->force_texture) ? GFXTRUE : GFXFALSE,
+                            65536, GFXFALSE, GFXFALSE, DEFAULT_ADDRESS_MODE, nullptr, true);
             if (!tex->LoadSuccess()) {
                 delete tex;
                 tex =
                         new Texture(
                                 zt->decal_name.c_str(), 0, MIPMAP, TEXTURE2D, TEXTURE_2D,
-                                (g_game.use_ship_textures || xml->force_texture) ? GFXTRUE : GFXFALSE);
+                                (g_game.use_ship_textures || xml->force_texture) ? GFXTRUE : GFXFALSE,
+                                65536, GFXFALSE, GFXFALSE, DEFAULT_ADDRESS_MODE, nullptr, true);
+            } else if (temptex != zt->decal_name) {
+                tex->SetFallback(zt->decal_name);
             }
         } else {
             string temptex = faction_prefix + zt->decal_name;
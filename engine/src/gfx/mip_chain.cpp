@@ -0,0 +1,64 @@
+/*
+ * mip_chain.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gfx/mip_chain.h"
+
+#include <algorithm>
+
+void BuildMipChain(const unsigned char *pixels,
+        int width,
+        int height,
+        int pixsize,
+        std::vector<std::vector<unsigned char> > &levels) {
+    levels.clear();
+    const unsigned char *source = pixels;
+    while (width > 1 || height > 1) {
+        const int newwidth = std::max(1, width / 2);
+        const int newheight = std::max(1, height / 2);
+        std::vector<unsigned char> level(static_cast<size_t>(newwidth) * newheight * pixsize);
+        const size_t istride = static_cast<size_t>(width) * pixsize;
+        // a side that is already 1 pixel long samples the same row or column twice
+        const size_t xstep = width > 1 ? pixsize : 0;
+        const size_t ystep = height > 1 ? istride : 0;
+        unsigned char *out = level.data();
+        for (int y = 0; y < newheight; ++y) {
+            const unsigned char *row = source + static_cast<size_t>(y) * (height > 1 ? 2 : 1) * istride;
+            for (int x = 0; x < newwidth; ++x) {
+                const unsigned char *in = row + static_cast<size_t>(x) * (width > 1 ? 2 : 1) * pixsize;
+                for (int c = 0; c < pixsize; ++c) {
+                    *out++ = static_cast<unsigned char>(
+                            (in[c] + in[c + xstep] + in[c + ystep] + in[c + xstep + ystep] + 2) >> 2);
+                }
+            }
+        }
+        levels.push_back(std::move(level));
+        source = levels.back().data();
+        width = newwidth;
+        height = newheight;
+    }
+}
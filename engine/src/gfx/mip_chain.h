@@ -0,0 +1,43 @@
+/*
+ * mip_chain.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_MIP_CHAIN_H
+#define VEGA_STRIKE_ENGINE_GFX_MIP_CHAIN_H
+
+#include <vector>
+
+// Box filtered mip levels of an uncompressed image, so that textures decoded in the
+// background reach the render thread with nothing left to do but the GL upload.
+// Fills levels with every level after the first, each halving both sides (never
+// below 1) down to 1x1. pixsize is the number of bytes per pixel, 1 to 4.
+void BuildMipChain(const unsigned char *pixels,
+        int width,
+        int height,
+        int pixsize,
+        std::vector<std::vector<unsigned char> > &levels);
+
+#endif //VEGA_STRIKE_ENGINE_GFX_MIP_CHAIN_H
@@ -62,6 +62,7 @@
 #include "gfx/nav/navscreen.h"
 #include "gfx/masks.h"
 #include "gfx/nav/navscreenoccupied.h"
+#include "gfx/nav/screen_grid.h"
 
 using std::string;
 using std::vector;
@@ -78,7 +79,8 @@ static void DrawNodeDescription(string text,
         float size_y,
         bool ignore_occupied_areas,
         const GFXColor &col,
-        navscreenoccupied *screenoccupation) {
+        navscreenoccupied *screenoccupation,
+        ScreenGrid *labels = nullptr) {
     //take the head and stick it in the back
     if (text.size() == 0) {
         return;
@@ -102,7 +104,12 @@ static void DrawNodeDescription(string text,
         displayname.bgcol = tpbg;
     } else {
         float new_y = screenoccupation->findfreesector(x_, y_);
-        displayname.SetPos((x_ - offset), new_y);
+        //a label on top of one already drawn is not readable, move it next to it or skip it
+        float left = x_ - offset, right = x_ + offset, top = new_y;
+        if (labels && !labels->claimNear(left, new_y, right, top, 2)) {
+            return;
+        }
+        displayname.SetPos(left, new_y);
         displayname.SetText(text);
         displayname.SetCharSize(size_x, size_y);
         GFXColor tpbg = displayname.bgcol;
@@ -131,14 +138,16 @@ static void DrawNode(int type,
         float size,
         float x,
         float y,
-        std::string source,
+        char color,
+        const string &tsector,
+        const string &label,
         navscreenoccupied *screenoccupation,
+        ScreenGrid *labels,
         bool moused,
         GFXColor race,
         bool mouseover = false,
         bool willclick = false,
-        string insector = "") {
-    char color = GetSystemColor(source);
+        const string &insector = "") {
     if (moused) {
         return;
     }
@@ -166,14 +175,13 @@ static void DrawNode(int type,
     }
     NavigationSystem::DrawCircle(x, y, size, race);
     if ((!mouseover) || (willclick)) {
-        string tsector, nam;
-        Beautify(source, tsector, nam);
+        string nam = label;
         if (willclick) {
             race = highlighted_tail_text;
             nam = tsector + " / " + nam;
         }
         if (willclick || !(insector.compare("")) || !(insector.compare(tsector))) {
-            DrawNodeDescription(nam, x, y, 1.0, 1.0, 0, race, screenoccupation);
+            DrawNodeDescription(nam, x, y, 1.0, 1.0, 0, race, screenoccupation, labels);
         }
     }
 }
@@ -185,6 +193,8 @@ class systemdrawnode {
     float y;
     unsigned index;
     std::string source;
+    std::string sector;
+    std::string label;
 //Vector of indicies
 //std::vector<int> *dest; //let's just hope that the iterator doesn't get killed during the frame, which shouldn't happen.
 //std::vector<string> *stringdest; //let's just hope that the iterator doesn't get killed during the frame, which shouldn't happen.
@@ -209,7 +219,7 @@ public:
             float size,
             float x,
             float y,
-            std::string source,
+            const NavigationSystem::CachedSystemIterator::SystemInfo &system,
             unsigned index,
             navscreenoccupied *so,
             bool moused,
@@ -219,9 +229,11 @@ public:
             x(x),
             y(y),
             index(index),
-            source(source),
+            source(system.name),
+            sector(system.sector),
+            label(system.label),
             moused(moused),
-            color(GetSystemColor(source)),
+            color(system.visit),
             race(race),
             screenoccupation(so) {
     }
@@ -239,7 +251,7 @@ public:
     }
 
     void draw(bool mouseover = false, bool willclick = false) {
-        DrawNode(type, size, x, y, source, screenoccupation, moused, race, mouseover, willclick);
+        DrawNode(type, size, x, y, color, sector, label, screenoccupation, nullptr, moused, race, mouseover, willclick);
     }
 };
 
@@ -367,8 +379,9 @@ NavigationSystem::CachedSystemIterator::SystemInfo::SystemInfo(const string &nam
         const QVector &position,
         const std::vector<std::string> &destinations,
         NavigationSystem::CachedSystemIterator *csi) :
-        name(name), position(position), part_of_path(false) {
+        name(name), position(position), part_of_path(false), visit('v'), drawable(true) {
     //Eww... double for loop!
+    Beautify(name, sector, label);
     UpdateColor();
     if (csi) {
         for (size_t i = 0; i < destinations.size(); ++i) {
@@ -392,10 +405,17 @@ NavigationSystem::CachedSystemIterator::SystemInfo::SystemInfo(const string &nam
 
 //Create a placeholder to avoid the problem described above
 NavigationSystem::CachedSystemIterator::SystemInfo::SystemInfo(const string &name) :
-        name(name), part_of_path(false) {
+        name(name), part_of_path(false), visit('v'), drawable(true) {
+    Beautify(name, sector, label);
 }
 
-void NavigationSystem::CachedSystemIterator::SystemInfo::loadData(map<string, unsigned> *index_table) {
+void NavigationSystem::CachedSystemIterator::SystemInfo::UpdateVisited() {
+    visit = GetSystemColor(name);
+    drawable = checkedVisited(name);
+}
+
+void NavigationSystem::CachedSystemIterator::SystemInfo::loadData(map<string, unsigned> *index_table,
+        const std::vector<std::string> &destinations) {
     string xyz = _Universe->getGalaxyProperty(name, "xyz");
     QVector pos;
     if (xyz.size() && (sscanf(xyz.c_str(), "%lf %lf %lf", &pos.i, &pos.j, &pos.k) >= 3)) {
@@ -408,7 +428,7 @@ void NavigationSystem::CachedSystemIterator::SystemInfo::loadData(map<string, un
     position = pos;
 
     UpdateColor();
-    const vector<std::string> &destinations = _Universe->getAdjacentStarSystems(name);
+    UpdateVisited();
     for (size_t i = 0; i < destinations.size(); ++i) {
         if (index_table->count(destinations[i]) != 0) {
             lowerdestinations.push_back((*index_table)[destinations[i]]);
@@ -418,10 +438,11 @@ void NavigationSystem::CachedSystemIterator::SystemInfo::loadData(map<string, un
 
 void NavigationSystem::CachedSystemIterator::init(string current_system, unsigned max_systems) {
     systems.clear();
+    index_table.clear();
+    ++generation;
     unsigned count = 0;
     string sys;
 
-    map<string, unsigned> index_table;
     std::deque<std::string> frontier;
     frontier.push_back(current_system);
     systems.push_back(SystemInfo(current_system));
@@ -430,9 +451,10 @@ void NavigationSystem::CachedSystemIterator::init(string current_system, unsigne
         sys = frontier.front();
         frontier.pop_front();
 
-        int nas = UniverseUtil::GetNumAdjacentSystems(sys);
-        for (int j = 0; j < nas && count < max_systems; ++j) {
-            string n = UniverseUtil::GetAdjacentSystem(sys, j);
+        //a copy, the jumps are parsed into a vector that the next lookup reuses
+        const vector<string> destinations = _Universe->getAdjacentStarSystems(sys);
+        for (size_t j = 0; j < destinations.size() && count < max_systems; ++j) {
+            const string &n = destinations[j];
             if (index_table.count(n) == 0) {
                 frontier.push_back(n);
                 index_table[n] = systems.size();
@@ -440,19 +462,55 @@ void NavigationSystem::CachedSystemIterator::init(string current_system, unsigne
                 ++count;
             }
         }
-        systems[index_table[sys]].loadData(&index_table);
+        systems[index_table[sys]].loadData(&index_table, destinations);
     }
 }
 
-NavigationSystem::CachedSystemIterator::CachedSystemIterator() {
+unsigned NavigationSystem::CachedSystemIterator::find(const string &name) const {
+    map<string, unsigned>::const_iterator it = index_table.find(name);
+    return it == index_table.end() ? size() : it->second;
 }
 
-NavigationSystem::CachedSystemIterator::CachedSystemIterator(string current_system, unsigned max_systems) {
+void NavigationSystem::CachedSystemIterator::visit(unsigned index) {
+    if (index >= size()) {
+        return;
+    }
+    SystemInfo &system = systems[index];
+    updateVisited(system);
+    for (size_t i = 0; i < system.lowerdestinations.size(); ++i) {
+        updateVisited(systems[system.lowerdestinations[i]]);
+    }
+}
+
+void NavigationSystem::CachedSystemIterator::updateVisited(SystemInfo &system) {
+    const bool drawable = system.isDrawable();
+    system.UpdateVisited();
+    if (system.isDrawable() != drawable) {
+        ++generation;
+    }
+}
+
+void NavigationSystem::CachedSystemIterator::updateVisited() {
+    for (size_t i = 0; i < systems.size(); ++i) {
+        updateVisited(systems[i]);
+    }
+}
+
+unsigned NavigationSystem::CachedSystemIterator::getGeneration() const {
+    return generation;
+}
+
+NavigationSystem::CachedSystemIterator::CachedSystemIterator() : generation(0) {
+}
+
+NavigationSystem::CachedSystemIterator::CachedSystemIterator(string current_system, unsigned max_systems) :
+        generation(0) {
     init(current_system, max_systems);
 }
 
 NavigationSystem::CachedSystemIterator::CachedSystemIterator(const CachedSystemIterator &other) :
-        systems(other.systems), currentPosition(other.currentPosition) {
+        systems(other.systems), index_table(other.index_table), currentPosition(other.currentPosition),
+        generation(other.generation) {
 }
 
 bool NavigationSystem::CachedSystemIterator::seek(unsigned position) {
@@ -531,7 +589,7 @@ const string &NavigationSystem::CachedSystemIterator::SystemInfo::GetName() cons
 }
 
 bool NavigationSystem::CachedSystemIterator::SystemInfo::isDrawable() const {
-    return checkedVisited(GetName());
+    return drawable;
 }
 
 QVector &NavigationSystem::CachedSystemIterator::SystemInfo::Position() {
@@ -723,6 +781,22 @@ float vsmax(float x, float y) {
     return x > y ? x : y;
 }
 
+//Where a system of the galaxy map ends up on the screen this frame
+struct ProjectedSystem {
+    float x;
+    float y;
+    float x_flat;
+    float y_flat;
+    float scale;
+    float zdistance;
+    float size;
+    GFXColor col;
+    //squared distance in the galaxy to the system the player is in
+    double from_current;
+    bool drawable;
+    bool path;
+};
+
 void NavigationSystem::DrawGalaxy() {
 //systemdrawlist mainlist;//(0, screenoccupation, factioncolours);	//	lists of items to draw that are in mouse range
 
@@ -854,35 +928,34 @@ void NavigationSystem::DrawGalaxy() {
     }
     DrawOriginOrientationTri(center_nav_x, center_nav_y, 0);
 
-    //Enlist the items and attributes
+    //Project every system on the map once per frame, nodes and the connections to them use the result
     //**********************************
-    systemIter.seek();
-    while (!systemIter.done()) {
-        //this draws the points
+    float alphaadd;
+    {
+        float tmp = (1 - (zoom / MAXZOOM));
+        alphaadd = (tmp * tmp) - .5;
+//if (alphaadd<=0)
+//alphaadd=0;
+//else
+        alphaadd *= 4;
+    }
+    static std::vector<ProjectedSystem> projected;
+    projected.resize(systemIter.size());
+    const QVector here = currentsystemindex < systemIter.size() ? systemIter[currentsystemindex].Position()
+            : QVector(0, 0, 0);
+    for (unsigned i = 0; i < systemIter.size(); ++i) {
+        CachedSystemIterator::SystemInfo &system = systemIter[i];
+        ProjectedSystem &item = projected[i];
         //IGNORE UNDRAWABLE SYSTEMS
         //**********************************
-        if (!systemIter->isDrawable()) {
-            ++systemIter;
+        item.drawable = system.isDrawable();
+        if (!item.drawable) {
             continue;
         }
         //**********************************
-
-        //Retrieve unit data
-        //**********************************
-        unsigned temp = systemIter.getIndex();
-
-        pos = systemIter->Position();
-
+        pos = system.Position();
+        item.from_current = (pos - here).MagnitudeSquared();
         ReplaceAxes(pos);             //poop
-
-        //Modify by old rotation amount
-        //*************************
-//if(galaxy_view==VIEW_3D){pos = dxyz(pos, 0, ry, 0);pos = dxyz(pos, rx, 0, 0);}
-        //*************************
-        //*************************
-
-        GFXColor col = systemIter->GetColor();
-        float the_x, the_y, the_x_flat, the_y_flat, system_item_scale_temp;
         TranslateCoordinates(pos,
                 pos_flat,
                 center_nav_x,
@@ -890,48 +963,58 @@ void NavigationSystem::DrawGalaxy() {
                 themaxvalue,
                 zscale,
                 zdistance,
-                the_x,
-                the_y,
-                the_x_flat,
-                the_y_flat,
-                system_item_scale_temp,
+                item.x,
+                item.y,
+                item.x_flat,
+                item.y_flat,
+                item.scale,
                 0);
-        float alphaadd;
-        {
-            float tmp = (1 - (zoom / MAXZOOM));
-            alphaadd = (tmp * tmp) - .5;
-//if (alphaadd<=0)
-//alphaadd=0;
-//else
-            alphaadd *= 4;
+        item.zdistance = zdistance;
+        item.col = system.GetColor();
+        item.col.a = (item.scale - minimumitemscaledown) / (maximumitemscaleup - minimumitemscaledown) + alphaadd;
+    }
+    //**********************************
+
+    //Enlist the items and attributes, and the lines between them
+    //**********************************
+    //labels take one of the 31 rows that navscreenoccupied hands out
+    static ScreenGrid grid;
+    grid.reset(screenskipby4[0], screenskipby4[1], screenskipby4[2], screenskipby4[3],
+            (screenskipby4[3] - screenskipby4[2]) / 31);
+    static std::vector<unsigned> visible;
+    visible.clear();
+    const int vsize = 3 + 4;
+    static std::vector<float> verts;
+    verts.clear();
+    for (unsigned temp = 0; temp < systemIter.size(); ++temp) {
+        CachedSystemIterator::SystemInfo &system = systemIter[temp];
+        ProjectedSystem &item = projected[temp];
+        if (!item.drawable) {
+            continue;
         }
-        col.a = (system_item_scale_temp - minimumitemscaledown) / (maximumitemscaleup - minimumitemscaledown)
-                + alphaadd;
-//col.a=GetAlpha(oldpos,center_x,center_y,center_z,zdistance);
         //IGNORE DIM AND OFF SCREEN SYETEMS
         //**********************************
-        if ((col.a < .05)
+        if ((item.col.a < .05)
                 || (!TestIfInRange(screenskipby4[0],
                         screenskipby4[1],
                         screenskipby4[2],
                         screenskipby4[3],
-                        the_x,
-                        the_y))) {
-            ++systemIter;
+                        item.x,
+                        item.y))) {
             continue;
         }
         //**********************************
 
         //FIND OUT IF SYSTEM IS PART OF A VISIBLE PATH
         //**********************************
-        bool isPath = false;
+        item.path = false;
         if (path_view != PATH_OFF) {
-            if (systemIter->part_of_path) {
-                for (std::set<NavPath *>::iterator paths = systemIter->paths.begin();
-                        paths != systemIter->paths.end();
+            if (system.part_of_path) {
+                for (std::set<NavPath *>::iterator paths = system.paths.begin();
+                        paths != system.paths.end();
                         ++paths) {
                     if ((*paths)->getVisible()) {
-                        isPath = true;
+                        item.path = true;
                         break;
                     }
                 }
@@ -940,122 +1023,94 @@ void NavigationSystem::DrawGalaxy() {
         //**********************************
         //IGNORE NON-PATH SYSTEMS IN PATH_ONLY MODE
         //**********************************
-        if (!isPath && path_view == PATH_ONLY) {
-            ++systemIter;
+        if (!item.path && path_view == PATH_ONLY) {
             continue;
         }
         //**********************************
 
-        int insert_type = systemambiguous;
-        float insert_size = SYSTEM_DEFAULT_SIZE;
-        if (system_item_scale_temp > (system_item_scale * 3)) {
-            system_item_scale_temp = (system_item_scale * 3);
+        item.size = SYSTEM_DEFAULT_SIZE;
+        item.size *= std::min(item.scale, system_item_scale * 3) / 3;
+        visible.push_back(temp);
+        grid.insert(item.x, item.y, 0.5f * item.size, temp);
+
+        unsigned destsize = system.GetDestinationSize();
+        for (unsigned i = 0; i < destsize; ++i) {
+            const unsigned othindex = system.GetDestinationIndex(i);
+            if (othindex >= projected.size() || !projected[othindex].drawable) {
+                continue;
+            }
+            CachedSystemIterator::SystemInfo &oth = systemIter[othindex];
+            const ProjectedSystem &othitem = projected[othindex];
+            float the_new_x = othitem.x;
+            float the_new_y = othitem.y;
+            IntersectBorder(the_new_x, the_new_y, item.x, item.y);
+
+            bool isConnectionPath = false;
+            if (path_view != PATH_OFF && system.part_of_path && oth.part_of_path) {
+                for (std::set<NavPath *>::iterator paths = system.paths.begin();
+                        !isConnectionPath && paths != system.paths.end();
+                        ++paths) {
+                    isConnectionPath = (*paths)->getVisible()
+                            && (*paths)->isNeighborPath(temp, othindex);
+                }
+            }
+            if (isConnectionPath) {
+                const float line[2 * vsize] = {
+                        item.x, item.y, 0, pathcol.r, pathcol.g, pathcol.b, pathcol.a,
+                        the_new_x, the_new_y, 0, pathcol.r, pathcol.g, pathcol.b, pathcol.a
+                };
+                verts.insert(verts.end(), line, line + 2 * vsize);
+            } else if (path_view != PATH_ONLY) {
+                const GFXColor &col = item.col;
+                const GFXColor &othcol = othitem.col;
+                const float line[2 * vsize] = {
+                        item.x, item.y, 0, col.r, col.g, col.b, col.a,
+                        the_new_x, the_new_y, 0, othcol.r, othcol.g, othcol.b, othcol.a
+                };
+                verts.insert(verts.end(), line, line + 2 * vsize);
+            }
         }
-        insert_size *= system_item_scale_temp / 3;
+    }
+    //all connections in one batch, under the nodes
+    if (!verts.empty()) {
+        GFXDisable(LIGHTING);
+        GFXDisable(TEXTURE0);
+        GFXDraw(GFXLINE, &verts[0], verts.size() / vsize, 3, 4);
+    }
+    //labels go to whoever asks first, so the systems closest to the player's draw first and keep theirs
+    std::stable_sort(visible.begin(), visible.end(), [](unsigned a, unsigned b) {
+        return projected[a].from_current < projected[b].from_current;
+    });
+    for (size_t v = 0; v < visible.size(); ++v) {
+        const unsigned temp = visible[v];
+        CachedSystemIterator::SystemInfo &system = systemIter[temp];
+        const ProjectedSystem &item = projected[temp];
         if (currentsystemindex == temp) {
-            DrawTargetCorners(the_x, the_y, (insert_size), currentcol);
+            DrawTargetCorners(item.x, item.y, (item.size), currentcol);
         }
         if (destinationsystemindex == temp) {
-            DrawTargetCorners(the_x, the_y, (insert_size) * 1.2, destinationcol);
+            DrawTargetCorners(item.x, item.y, (item.size) * 1.2, destinationcol);
         }
         if (systemselectionindex == temp) {
-            DrawTargetCorners(the_x, the_y, (insert_size) * 1.4, selectcol);
-        }
-        bool moused = false;
-        DrawNode(insert_type, insert_size, the_x, the_y,
-                (*systemIter).GetName(), screenoccupation, moused, isPath ? pathcol : col, false, false,
-                isPath ? "" : csector);
-        if (std::fabs(zdistance) < 2.0f * camera_z) {
-            DisplayOrientationLines(the_x, the_y, the_x_flat, the_y_flat, 0);
+            DrawTargetCorners(item.x, item.y, (item.size) * 1.4, selectcol);
         }
-        if (TestIfInRangeRad(the_x, the_y, insert_size, mouse_x_current, mouse_y_current)) {
-            mouselist.push_back(systemdrawnode(insert_type, insert_size, the_x, the_y, (*systemIter).GetName(),
-                    systemIter.getIndex(), screenoccupation, false, isPath ? pathcol : col));
-            moused = true;
+        DrawNode(systemambiguous, item.size, item.x, item.y, system.visit, system.sector, system.label,
+                screenoccupation, &grid, false, item.path ? pathcol : item.col, false, false,
+                item.path ? "" : csector);
+        if (std::fabs(item.zdistance) < 2.0f * camera_z) {
+            DisplayOrientationLines(item.x, item.y, item.x_flat, item.y_flat, 0);
         }
-        unsigned destsize = systemIter->GetDestinationSize();
-        if (destsize != 0) {
-            GFXDisable(LIGHTING);
-            GFXDisable(TEXTURE0);
-            const int vsize = 3 + 4;
-            std::vector<float> verts(2 * destsize * vsize);
-            std::vector<float>::iterator v = verts.begin();
-            for (unsigned i = 0; i < destsize; ++i) {
-                CachedSystemIterator::SystemInfo &oth = systemIter[systemIter->GetDestinationIndex(i)];
-                if (oth.isDrawable()) {
-                    QVector posoth = oth.Position();
-                    ReplaceAxes(posoth);
-
-                    float the_new_x, the_new_y, new_system_item_scale_temp, the_new_x_flat, the_new_y_flat;
-                    //WARNING: SOME VARIABLES FOR ORIGINAL SYSTEM MAY BE MODIFIED HERE!!!
-                    TranslateCoordinates(posoth,
-                            pos_flat,
-                            center_nav_x,
-                            center_nav_y,
-                            themaxvalue,
-                            zscale,
-                            zdistance,
-                            the_new_x,
-                            the_new_y,
-                            the_new_x_flat,
-                            the_new_y_flat,
-                            new_system_item_scale_temp,
-                            0);
-                    GFXColor othcol = oth.GetColor();
-                    othcol.a =
-                            (new_system_item_scale_temp
-                                    - minimumitemscaledown) / (maximumitemscaleup - minimumitemscaledown) + alphaadd;
-                    //GetAlpha(oldposoth,center_x,center_y,center_z,zdistance);
-                    IntersectBorder(the_new_x, the_new_y, the_x, the_y);
-
-                    bool isConnectionPath = false;
-                    if (path_view != PATH_OFF && systemIter->part_of_path && oth.part_of_path) {
-                        for (std::set<NavPath *>::iterator paths = systemIter->paths.begin();
-                                !isConnectionPath && paths != systemIter->paths.end();
-                                ++paths) {
-                            isConnectionPath = (*paths)->getVisible()
-                                    && (*paths)->isNeighborPath(temp, systemIter->GetDestinationIndex(i));
-                        }
-                    }
-                    if (isConnectionPath) {
-                        *v++ = the_x;
-                        *v++ = the_y;
-                        *v++ = 0;
-                        *v++ = pathcol.r;
-                        *v++ = pathcol.g;
-                        *v++ = pathcol.b;
-                        *v++ = pathcol.a;
-                        *v++ = the_new_x;
-                        *v++ = the_new_y;
-                        *v++ = 0;
-                        *v++ = pathcol.r;
-                        *v++ = pathcol.g;
-                        *v++ = pathcol.b;
-                        *v++ = pathcol.a;
-                    } else if (path_view != PATH_ONLY) {
-                        *v++ = the_x;
-                        *v++ = the_y;
-                        *v++ = 0;
-                        *v++ = col.r;
-                        *v++ = col.g;
-                        *v++ = col.b;
-                        *v++ = col.a;
-                        *v++ = the_new_x;
-                        *v++ = the_new_y;
-                        *v++ = 0;
-                        *v++ = othcol.r;
-                        *v++ = othcol.g;
-                        *v++ = othcol.b;
-                        *v++ = othcol.a;
-                    }
-                }
-            }
-            if (v != verts.end()) {
-                verts.erase(v, verts.end());
-            }
-            GFXDraw(GFXLINE, &verts[0], verts.size() / vsize, 3, 4);
-        }
-        ++systemIter;
+    }
+    //what is under the mouse, in map order like the rest
+    std::vector<unsigned> moused;
+    grid.query(mouse_x_current, mouse_y_current, [&moused](unsigned index) {
+        moused.push_back(index);
+    });
+    std::sort(moused.begin(), moused.end());
+    for (size_t m = 0; m < moused.size(); ++m) {
+        const ProjectedSystem &item = projected[moused[m]];
+        mouselist.push_back(systemdrawnode(systemambiguous, item.size, item.x, item.y, systemIter[moused[m]],
+                moused[m], screenoccupation, false, item.path ? pathcol : item.col));
     }
     //**********************************
     //Adjust mouse list for 'n' kliks
@@ -0,0 +1,198 @@
+/*
+ * nav_graph.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "gfx/nav/nav_graph.h"
+
+#include <set>
+
+NavGraph::NavGraph() : first_destination(1, 0) {
+}
+
+unsigned NavGraph::addSystem(bool drawable, const std::vector<unsigned> &destinations) {
+    this->destinations.insert(this->destinations.end(), destinations.begin(), destinations.end());
+    first_destination.push_back(this->destinations.size());
+    this->drawable.push_back(drawable);
+    return size() - 1;
+}
+
+unsigned NavGraph::size() const {
+    return drawable.size();
+}
+
+bool NavGraph::isDrawable(unsigned system) const {
+    return system < size() && drawable[system];
+}
+
+//The searches are the ones NavPath::evaluate used to run over the system
+//iterator, step for step, so routes come out the same.
+bool NavGraph::findRoute(unsigned originIndex, unsigned destIndex, size_t max_size,
+        std::list<unsigned> &route) const {
+    route.clear();
+    if (originIndex == destIndex) {
+        route.push_back(originIndex);
+        return true;
+    }
+    if (originIndex >= size() || destIndex >= size()) {
+        return false;
+    }
+    //Using a double-rooted BFS search
+    std::vector<unsigned> prev(size());
+    std::vector<unsigned> visited(size(), 0);
+    std::deque<unsigned> oriFront, destFront;
+    bool found = false;
+    unsigned midNode = 0;
+    unsigned midNodePrevOri = 0;
+    unsigned midNodePrevDest = 0;
+    bool oriTurn = true;
+    std::deque<unsigned> *front;
+    unsigned visitMark;
+    oriFront.push_back(originIndex);
+    visited[originIndex] = 1;
+    destFront.push_back(destIndex);
+    visited[destIndex] = 2;
+    while (oriFront.size() < max_size && destFront.size() < max_size && !oriFront.empty() && !destFront.empty()
+            && !found) {
+        if (oriTurn) {
+            front = &oriFront;
+            visitMark = 1;
+        } else {
+            front = &destFront;
+            visitMark = 2;
+        }
+        unsigned index = front->front();
+        front->pop_front();
+        for (unsigned adjs = first_destination[index]; adjs < first_destination[index + 1]; ++adjs) {
+            unsigned adjIndex = destinations[adjs];
+            if (isDrawable(adjIndex)) {
+                if (visited[adjIndex] == 0) {
+                    visited[adjIndex] = visitMark;
+                    prev[adjIndex] = index;
+                    front->push_back(adjIndex);
+                } else if (visited[adjIndex] != visitMark) {
+                    midNode = adjIndex;
+                    if (oriTurn) {
+                        midNodePrevDest = prev[adjIndex];
+                        midNodePrevOri = index;
+                    } else {
+                        midNodePrevOri = prev[adjIndex];
+                        midNodePrevDest = index;
+                    }
+                    found = true;
+                    break;
+                }
+            }
+        }
+        oriTurn = !oriTurn;
+    }
+    if (found) {
+        unsigned index = midNodePrevOri;
+        while (index != originIndex) {
+            route.push_front(index);
+            index = prev[index];
+            if (route.size() >= max_size) {
+                //this prevents some odd "out of memory" crashes we were getting where there might have been a loop in the path somehow
+                route.clear();
+                return false;
+            }
+        }
+        route.push_front(originIndex);
+        if (destIndex == midNode) {
+            route.push_back(destIndex);
+        } else {
+            route.push_back(midNode);
+
+            index = midNodePrevDest;
+            while (index != destIndex) {
+                route.push_back(index);
+                index = prev[index];
+                if (route.size() >= max_size) {
+                    route.clear();
+                    return false;
+                }
+            }
+            route.push_back(destIndex);
+        }
+    }
+    return found;
+}
+
+bool NavGraph::findRoute(std::deque<unsigned> frontier, const std::function<bool(unsigned)> &isDestination,
+        size_t max_size, std::list<unsigned> &route) const {
+    route.clear();
+    //Using single-rooted BFS search
+    std::vector<unsigned> prev(size());
+    std::vector<bool> visited(size(), false);
+    std::set<unsigned> origins;
+    bool found = false;
+    unsigned index, destIndex = 0;
+    for (unsigned i = 0; i < frontier.size(); ++i) {
+        index = frontier.front();
+        frontier.pop_front();
+        if (index >= size()) {
+            return false;
+        }
+        visited[index] = true;
+        frontier.push_back(index);
+        origins.insert(index);
+        if (isDestination(index)) {
+            route.push_back(index);
+            return true;
+        }
+    }
+    while (frontier.size() < max_size && !frontier.empty() && !found) {
+        index = frontier.front();
+        frontier.pop_front();
+        for (unsigned adjs = first_destination[index]; adjs < first_destination[index + 1]; ++adjs) {
+            unsigned adjIndex = destinations[adjs];
+            if (isDrawable(adjIndex) && !visited[adjIndex]) {
+                visited[adjIndex] = true;
+                prev[adjIndex] = index;
+                frontier.push_back(adjIndex);
+                if (isDestination(adjIndex)) {
+                    found = true;
+                    destIndex = adjIndex;
+                    break;
+                }
+            }
+        }
+    }
+    if (found) {
+        index = destIndex;
+        route.push_front(index);
+        do {
+            index = prev[index];
+            route.push_front(index);
+            if (route.size() >= max_size) {
+                route.clear();
+                return false;
+            }
+        } while (!origins.count(index));             //While the index is not an origin
+    }
+    return found;
+}
@@ -0,0 +1,68 @@
+/*
+ * nav_graph.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_NAV_NAV_GRAPH_H
+#define VEGA_STRIKE_ENGINE_GFX_NAV_NAV_GRAPH_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <list>
+#include <vector>
+
+/**
+ * @brief Read-only copy of the galaxy map's jump lanes for route searches.
+ * @details Systems are numbered like NavigationSystem::CachedSystemIterator
+ * and each system's jumps sit in one flat array. Nothing here touches the
+ * universe, so a snapshot can be searched on a worker thread while the map
+ * goes on changing.
+ */
+class NavGraph {
+public:
+    NavGraph();
+
+    // Appends system size(). Destinations may name systems added later.
+    unsigned addSystem(bool drawable, const std::vector<unsigned> &destinations);
+
+    unsigned size() const;
+    bool isDrawable(unsigned system) const;
+
+    // Shortest route between two systems, searched from both ends.
+    // Returns false, with an empty route, if there is none within max_size.
+    bool findRoute(unsigned origin, unsigned destination, size_t max_size, std::list<unsigned> &route) const;
+
+    // Shortest route from any of origins to the first system isDestination accepts
+    bool findRoute(std::deque<unsigned> origins, const std::function<bool(unsigned)> &isDestination,
+            size_t max_size, std::list<unsigned> &route) const;
+
+private:
+    std::vector<unsigned> first_destination;     // Per system, plus one past the end
+    std::vector<unsigned> destinations;
+    std::vector<bool> drawable;
+};
+
+#endif   //VEGA_STRIKE_ENGINE_GFX_NAV_NAV_GRAPH_H
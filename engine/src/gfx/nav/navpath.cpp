@@ -36,6 +36,7 @@
 #include "gfx/nav/navscreen.h"
 #include "root_generic/configxml.h"
 #include "src/universe.h"
+#include "vs_thread_pool.h"
 
 #include <vector>
 using std::vector;
@@ -47,14 +48,25 @@ using std::list;
 using std::set;
 #include <map>
 using std::map;
+#include <algorithm>
 #include <string>
 using std::string;
 #include <iostream>
 using std::endl;
 using std::pair;
+#include <chrono>
 
 #include "src/vs_logging.h"
 
+static size_t maxSearchSize() {
+    static size_t max_size = XMLSupport::parse_int(vs_config->getVariable("graphics", "nav_max_search_size", "16384"));
+    return max_size;
+}
+
+static PathManager *pathManager() {
+    return _Universe->AccessCockpit()->AccessNavSystem()->pathman;
+}
+
 //*******************************************************************//
 ////
 //NavPath Class                          //
@@ -139,6 +151,8 @@ string NavPath::getDescription() const {
         temp += "#n#INCOMPLETE#n#";
     } else if (!isComplete()) {
         temp += "#n#PATH CHAIN IS UNSOLVED BEFORE THIS POINT#n#";
+    } else if (isSearching()) {
+        temp += "#n#SEARCHING#n#";
     } else if (!isEvaluated()) {
         temp += "#n#PATH NOT FOUND#n#";
     }
@@ -305,168 +319,107 @@ bool NavPath::checkForCycles() const {
     return cycle;
 }
 
+bool NavPath::getAbsoluteEnds(unsigned &origin, unsigned &dest) const {
+    if (!isAbsolute()) {
+        return false;
+    }
+    origin = source->initSearchQueue().front();
+    dest = destination->initSearchQueue().front();
+    return true;
+}
+
 bool NavPath::evaluate() {
-    NavigationSystem::CachedSystemIterator &systemIter = _Universe->AccessCockpit()->AccessNavSystem()->systemIter;
+    std::shared_ptr<const NavGraph> graph = pathManager()->getGraph();
     path.clear();
-    static size_t max_size = XMLSupport::parse_int(vs_config->getVariable("graphics", "nav_max_search_size", "16384"));
+    searchedGraph.reset();
     if (!isComplete()) {
         return false;
     }
-    if (isAbsolute()) {
-        //Using a double-rooted BFS search
-        unsigned originIndex = source->initSearchQueue().front();
-        unsigned destIndex = destination->initSearchQueue().front();
-        if (originIndex == destIndex) {
-            path.push_back(originIndex);
-            return true;
-        }
-        vector<unsigned> prev(systemIter.size());
-        vector<unsigned> visited(systemIter.size(), 0);
-        deque<unsigned> oriFront, destFront;
-        bool found = false;
-        unsigned midNode;
-        unsigned midNodePrevOri;
-        unsigned midNodePrevDest;
-        midNodePrevOri = midNodePrevDest =
-                0; //to shut up a warning about possibly used uninitialized --chuck_starchaser
-        bool oriTurn = true;
-        deque<unsigned> *front;
-        unsigned visitMark;
-        if (originIndex >= visited.size() || destIndex >= visited.size()) {
+    unsigned originIndex, destIndex;
+    if (getAbsoluteEnds(originIndex, destIndex)) {
+        if (originIndex != destIndex && (originIndex >= graph->size() || destIndex >= graph->size())) {
             VS_LOG_AND_FLUSH(error,
                     (boost::format(
                             "(previously) FATAL error with nav system, referencing value too big %1% %2% with visited size %3%")
                             % ((int) originIndex)
                             % ((int) destIndex)
-                            % ((int) visited.size())));
+                            % ((int) graph->size())));
             return false;
         }
-        oriFront.push_back(originIndex);
-        visited[originIndex] = 1;
-        destFront.push_back(destIndex);
-        visited[destIndex] = 2;
-        while (oriFront.size() < max_size && destFront.size() < max_size && !oriFront.empty() && !destFront.empty()
-                && !found) {
-            //stay within memory bounds in case something goes wrong (it has, unfortunately on occasion)
-            if (oriTurn) {
-                front = &oriFront;
-                visitMark = 1;
-            } else {
-                front = &destFront;
-                visitMark = 2;
-            }
-            unsigned index = front->front();
-            front->pop_front();
-            for (unsigned adjs = 0; adjs < systemIter[index].GetDestinationSize(); ++adjs) {
-                unsigned adjIndex = systemIter[index].GetDestinationIndex(adjs);
-                if (systemIter[adjIndex].isDrawable()) {
-                    if (visited[adjIndex] == 0) {
-                        visited[adjIndex] = visitMark;
-                        prev[adjIndex] = index;
-                        front->push_back(adjIndex);
-                    } else if (visited[adjIndex] != visitMark) {
-                        midNode = adjIndex;
-                        if (oriTurn) {
-                            midNodePrevDest = prev[adjIndex];
-                            midNodePrevOri = index;
-                        } else {
-                            midNodePrevOri = prev[adjIndex];
-                            midNodePrevDest = index;
-                        }
-                        found = true;
-                        break;
-                    }
-                }
-            }
-            oriTurn = !oriTurn;
-        }
-        if (found) {
-            unsigned index = midNodePrevOri;
-            while (index != originIndex) {
-                path.push_front(index);
-                index = prev[index];
-                if (path.size() >= max_size) {
-                    //this prevents some odd "out of memory" crashes we were getting where there might have been a loop in the path somehow
-                    path.clear();
-                    found = false;
-                    return false;
-                }
-            }
-            path.push_front(originIndex);
-            if (destIndex == midNode) {
-                path.push_back(destIndex);
-            } else {
-                path.push_back(midNode);
-
-                unsigned index = midNodePrevDest;
-                while (index != destIndex) {
-                    path.push_back(index);
-                    index = prev[index];
-                    if (path.size() >= max_size) {
-                        //this prevents some odd "out of memory" crashes we were getting where there might have been a loop in the path somehow
-                        path.clear();
-                        found = false;
-                        return false;
-                    }
-                }
-                path.push_back(destIndex);
-            }
-        }
-        return found;
+        searchedGraph = graph;
+        searchedOrigin = originIndex;
+        searchedDestination = destIndex;
+        return graph->findRoute(originIndex, destIndex, maxSearchSize(), path);
     } else {
-        //Using single-rooted BFS search
-        vector<unsigned> prev(systemIter.size());
-        vector<bool> visited(systemIter.size(), false);
-        deque<unsigned> frontier = source->initSearchQueue();
-        set<unsigned> origins;
-        bool found = false;
-        unsigned index, destIndex = 0;
-        for (unsigned i = 0; i < frontier.size(); ++i) {
-            index = frontier.front();
-            frontier.pop_front();
-            visited[index] = true;
-            frontier.push_back(index);
-            origins.insert(index);
-            if (destination->isDestination(index)) {
-                path.push_back(index);
-                return true;
-            }
-        }
-        while (frontier.size() < max_size && !frontier.empty() && !found) {
-            index = frontier.front();
-            frontier.pop_front();
-            for (unsigned adjs = 0; adjs < systemIter[index].GetDestinationSize(); ++adjs) {
-                unsigned adjIndex = systemIter[index].GetDestinationIndex(adjs);
-                if (!visited[adjIndex] && systemIter[adjIndex].isDrawable()) {
-                    visited[adjIndex] = true;
-                    prev[adjIndex] = index;
-                    frontier.push_back(adjIndex);
-                    if (destination->isDestination(adjIndex)) {
-                        found = true;
-                        destIndex = adjIndex;
-                        break;
-                    }
-                }
-            }
-        }
-        if (found) {
-            index = destIndex;
-            path.push_front(index);
-            do {
-                index = prev[index];
-                path.push_front(index);
-                if (path.size() >= max_size) {
-                    //this prevents some odd "out of memory" crashes we were getting where there might have been a loop in the path somehow
-                    path.clear();
-                    found = false;
-                    return false;
-                }
-            } while (!origins.count(index));             //While the index is not an origin
-        }
-        return found;
+        const PathNode *dest = destination;
+        return graph->findRoute(source->initSearchQueue(),
+                [dest](unsigned index) {
+                    return dest->isDestination(index);
+                },
+                maxSearchSize(),
+                path);
     }
 }
 
+bool NavPath::isUpToDate() const {
+    unsigned originIndex, destIndex;
+    if (!searchedGraph || !getAbsoluteEnds(originIndex, destIndex)) {
+        return false;
+    }
+    return searchedGraph == pathManager()->getGraph() && searchedOrigin == originIndex
+            && searchedDestination == destIndex;
+}
+
+bool NavPath::startSearch() {
+    unsigned originIndex, destIndex;
+    if (isSearching() || !getAbsoluteEnds(originIndex, destIndex) || isUpToDate()) {
+        return false;
+    }
+    std::shared_ptr<const NavGraph> graph = pathManager()->getGraph();
+    if (originIndex == destIndex || originIndex >= graph->size() || destIndex >= graph->size()) {
+        return false;
+    }
+    //Criteria and chained searches call back into the universe, so only
+    //searches between two known systems go to the workers
+    const size_t max_size = maxSearchSize();
+    search = VegaStrike::SubmitWork([graph, originIndex, destIndex, max_size]() {
+        Search result;
+        result.graph = graph;
+        result.origin = originIndex;
+        result.destination = destIndex;
+        graph->findRoute(originIndex, destIndex, max_size, result.route);
+        return result;
+    });
+    return true;
+}
+
+bool NavPath::isSearching() const {
+    return search.valid();
+}
+
+bool NavPath::finishSearch() {
+    if (search.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    Search result = search.get();
+    unsigned originIndex, destIndex;
+    if (!getAbsoluteEnds(originIndex, destIndex) || originIndex != result.origin
+            || destIndex != result.destination || result.graph != pathManager()->getGraph()) {
+        //The path or the map changed while we were searching
+        update();
+        return true;
+    }
+    removeOldPath();
+    path.swap(result.route);
+    searchedGraph = result.graph;
+    searchedOrigin = originIndex;
+    searchedDestination = destIndex;
+    if (isEvaluated()) {
+        addNewPath();
+    }
+    return true;
+}
+
 void NavPath::removeOldPath() {
     NavigationSystem::CachedSystemIterator &systemIter = _Universe->AccessCockpit()->AccessNavSystem()->systemIter;
     //Erase old path
@@ -519,6 +472,9 @@ bool NavPath::isNeighborPath(unsigned system, unsigned neighbor) {
 }
 
 bool NavPath::update() {
+    if (isUpToDate()) {
+        return isEvaluated();
+    }
     removeOldPath();
     if (evaluate()) {
         addNewPath();
@@ -534,6 +490,7 @@ NavPath::NavPath() {
     color = GFXColor(1, 0, 0);
     source = NULL;
     destination = NULL;
+    searchedOrigin = searchedDestination = 0;
 }
 
 NavPath::~NavPath() {
@@ -578,6 +535,7 @@ void PathManager::addPath() {
 }
 
 bool PathManager::removePath(NavPath *path) {
+    queued.erase(std::remove(queued.begin(), queued.end(), path), queued.end());
     bool ret = false;
     for (std::vector<NavPath *>::iterator i = paths.begin(); i < paths.end(); ++i) {
         if ((*i) == path) {
@@ -611,32 +569,62 @@ bool PathManager::updateSpecificPath(NavPath *path) {
 void PathManager::updatePaths(UpdateType type) {
     std::list<NavPath *>::iterator i;
     DFS();
-    if (type == ALL) {
-        for (std::vector<NavPath *>::iterator j = paths.begin(); j < paths.end(); ++j) {
-            VS_LOG(info, (boost::format("Updating path: %1%") % (*j)->getName()));
-            (*j)->update();
-        }
-    } else if (type == CURRENT) {
-        for (i = topoOrder.begin(); i != topoOrder.end(); ++i) {
-            (*i)->updated = false;
-        }
-        for (i = topoOrder.begin(); i != topoOrder.end(); ++i) {
-            if ((*i)->updated == false && (*i)->isCurrentDependant()) {
-                VS_LOG(info, (boost::format("Updating path: %1%") % (*i)->getName()));
-                updateSpecificPath(*i);
+    for (i = topoOrder.begin(); i != topoOrder.end(); ++i) {
+        if (type == ALL || (type == CURRENT && (*i)->isCurrentDependant())
+                || (type == TARGET && (*i)->isTargetDependant())) {
+            VS_LOG(info, (boost::format("Updating path: %1%") % (*i)->getName()));
+            queueUpdate(*i);
+        }
+    }
+    poll();
+}
+
+void PathManager::queueUpdate(NavPath *path) {
+    //Dependants must come after whatever they depend on
+    queued.erase(std::remove(queued.begin(), queued.end(), path), queued.end());
+    queued.push_back(path);
+}
+
+void PathManager::poll() {
+    //Start every search that can go to the workers now, all on the same
+    //snapshot, rather than one per trip through the queue
+    for (std::deque<NavPath *>::iterator i = queued.begin(); i != queued.end(); ++i) {
+        (*i)->startSearch();
+    }
+    while (!queued.empty()) {
+        NavPath *path = queued.front();
+        if (path->isSearching()) {
+            if (!path->finishSearch()) {
+                return;
             }
+        } else {
+            path->update();
         }
-    } else {
-        for (i = topoOrder.begin(); i != topoOrder.end(); ++i) {
-            (*i)->updated = false;
+        queued.pop_front();
+        set<NavPath *> *dependants = path->getDependants();
+        for (std::set<NavPath *>::iterator j = dependants->begin(); j != dependants->end(); ++j) {
+            queueUpdate(*j);
+            (*j)->startSearch();
         }
-        for (i = topoOrder.begin(); i != topoOrder.end(); ++i) {
-            if ((*i)->updated == false && (*i)->isTargetDependant()) {
-                VS_LOG(info, (boost::format("Updating path: %1%") % (*i)->getName()));
-                updateSpecificPath(*i);
+    }
+}
+
+std::shared_ptr<const NavGraph> PathManager::getGraph() {
+    NavigationSystem::CachedSystemIterator &systemIter = _Universe->AccessCockpit()->AccessNavSystem()->systemIter;
+    if (!graph || graphGeneration != systemIter.getGeneration()) {
+        std::shared_ptr<NavGraph> newGraph = std::make_shared<NavGraph>();
+        vector<unsigned> destinations;
+        for (unsigned system = 0; system < systemIter.size(); ++system) {
+            destinations.clear();
+            for (unsigned adjs = 0; adjs < systemIter[system].GetDestinationSize(); ++adjs) {
+                destinations.push_back(systemIter[system].GetDestinationIndex(adjs));
             }
+            newGraph->addSystem(systemIter[system].isDrawable(), destinations);
         }
+        graph = newGraph;
+        graphGeneration = systemIter.getGeneration();
     }
+    return graph;
 }
 
 void PathManager::updateDependants(NavPath *parent) {
@@ -675,7 +663,7 @@ void PathManager::dfsVisit(NavPath *path) {
     topoOrder.push_front(path);
 }
 
-PathManager::PathManager() {
+PathManager::PathManager() : graphGeneration(0) {
 }
 
 PathManager::~PathManager() {
@@ -28,11 +28,14 @@
 
 #include <vector>
 #include <deque>
+#include <future>
 #include <list>
+#include <memory>
 #include <set>
 #include <map>
 #include <string>
 #include "criteria.h"
+#include "gfx/nav/nav_graph.h"
 
 #include "src/gfxlib.h"
 
@@ -105,6 +108,15 @@ public:
     void addNewPath();
     bool update();
 
+    //True IFF the path was last searched between the same two systems on the same map
+    bool isUpToDate() const;
+    //Starts searching for an absolute path on a worker thread. False if
+    //the path has to be updated here instead, or needs no update at all.
+    bool startSearch();
+    bool isSearching() const;
+    //Takes the route the background search found. False while it still runs.
+    bool finishSearch();
+
     bool isNeighborPath(unsigned system, unsigned neighbor);
 
     NavPath();
@@ -125,6 +137,21 @@ protected:
     TopoColor topoColor;
     unsigned topoTime;
     bool updated;
+
+    struct Search {
+        std::shared_ptr<const NavGraph> graph;
+        unsigned origin;
+        unsigned destination;
+        std::list<unsigned> route;
+    };
+
+    //What the current path was searched with
+    std::shared_ptr<const NavGraph> searchedGraph;
+    unsigned searchedOrigin;
+    unsigned searchedDestination;
+    std::future<Search> search;
+
+    bool getAbsoluteEnds(unsigned &origin, unsigned &dest) const;
 };
 
 //*******************************************************************//
@@ -142,8 +169,15 @@ public:
 
     enum UpdateType { ALL, CURRENT, TARGET };
     bool updateSpecificPath(NavPath *path);
+    //Queues the paths for update; poll does the updating
     void updatePaths(UpdateType type = ALL);
     void updateDependants(NavPath *parent);
+    //Works through the queued paths, searching off the render thread
+    //where it can, with all such searches started at once. Call once a frame.
+    void poll();
+
+    //The galaxy map as a NavGraph, rebuilt when the map has changed
+    std::shared_ptr<const NavGraph> getGraph();
 
     PathManager();
     ~PathManager();
@@ -154,6 +188,11 @@ protected:
 
     std::vector<NavPath *> paths;
     std::list<NavPath *> topoOrder;
+    std::deque<NavPath *> queued;
+    std::shared_ptr<const NavGraph> graph;
+    unsigned graphGeneration;
+
+    void queueUpdate(NavPath *path);
 
     void DFS();
     void dfsVisit(NavPath *path);
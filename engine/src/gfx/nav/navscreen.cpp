@@ -902,6 +902,10 @@ void NavigationSystem::SetDraw(bool n) {
         ClearPriorities();
         scrolloffset = 0;
         draw = n ? 1 : 0;
+        if (n) {
+            //the map keeps the visited state of every system, the savegame may have been loaded since
+            systemIter.updateVisited();
+        }
     }
 }
 //**********************************
@@ -997,11 +1001,11 @@ QVector NavigationSystem::dxyz(QVector vector, double x_, double y_, double z_)
 //**********************************
 
 void NavigationSystem::setCurrentSystem(string newSystem) {
-    for (unsigned i = 0; i < systemIter.size(); ++i) {
-        if (systemIter[i].GetName() == newSystem) {
-            setCurrentSystemIndex(i);
-            break;
-        }
+    unsigned i = systemIter.find(newSystem);
+    if (i < systemIter.size()) {
+        //called when the system is visited, which may put its neighbours on the map
+        systemIter.visit(i);
+        setCurrentSystemIndex(i);
     }
 }
 
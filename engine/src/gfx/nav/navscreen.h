@@ -69,7 +69,14 @@ public:
             GFXColor col;
             bool part_of_path;
             std::set<NavPath *> paths;
+            //name split by Beautify, done once instead of every frame
+            string sector;
+            string label;
+            //visited state from the savegame: 'v', 'm' or '?' (see GetSystemColor), and whether it is on the map
+            char visit;
+            bool drawable;
             void UpdateColor();
+            void UpdateVisited();
             string &GetName();
             const string &GetName() const;
             bool isDrawable() const;
@@ -83,15 +90,18 @@ public:
                     const QVector &position,
                     const std::vector<std::string> &destinations,
                     CachedSystemIterator *csi);
-            void loadData(std::map<string, unsigned> *index_table);
+            void loadData(std::map<string, unsigned> *index_table, const std::vector<std::string> &destinations);
         };
 
     private:
         friend struct SystemInfo;        //inner class needs to be friend in gcc-295
         vector<SystemInfo> systems;
+        std::map<string, unsigned> index_table;
         unsigned currentPosition;
+        unsigned generation;
         CachedSystemIterator(const CachedSystemIterator &other);       //May be really slow. Don't try this at home.
         CachedSystemIterator operator++(int);         //Also really slow because it has to use the copy constructor.
+        void updateVisited(SystemInfo &system);
 
     public:
         CachedSystemIterator();
@@ -109,6 +119,14 @@ public:
         const SystemInfo *operator->() const;
         CachedSystemIterator &next();
         CachedSystemIterator &operator++();
+        //index of the named system, or size() if it is not on the map
+        unsigned find(const string &name) const;
+        //rereads the visited state of a system and its neighbours, which is what visiting it changes
+        void visit(unsigned index);
+        //rereads the visited state of every system, for when the savegame may have changed
+        void updateVisited();
+        //changes whenever the systems, their jumps or which of them are drawable may have changed
+        unsigned getGeneration() const;
     };
 
     class CachedSectorIterator {
@@ -160,6 +178,7 @@ private:
     friend class CriteriaOwnedBy;
     friend class CriteriaSector;
     friend class NavPath;
+    friend class PathManager;
     NavComputer *navcomp;
     unsigned currentsystemindex;
     unsigned focusedsystemindex;
@@ -0,0 +1,177 @@
+/*
+ * screen_grid.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_NAV_SCREEN_GRID_H
+#define VEGA_STRIKE_ENGINE_GFX_NAV_SCREEN_GRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+// Uniform grid over the area of the nav screen, refilled every frame with what
+// the galaxy map has projected onto it. Answers what lies under the mouse
+// without testing every system, and keeps track of where labels were drawn
+// so that the next one can tell whether it would land on top of another, and
+// find a free spot next to it if so.
+class ScreenGrid {
+public:
+    ScreenGrid() : x0(0), y0(0), cell_size(1), columns(1), rows(1), max_radius(0), cells(1), claimed(1, false) {
+    }
+
+    // Covers [x0, x1] x [y0, y1] with square cells of cell_size and forgets everything stored
+    void reset(float x0, float x1, float y0, float y1, float cell_size) {
+        this->x0 = x0;
+        this->y0 = y0;
+        this->cell_size = cell_size > 0 ? cell_size : 1;
+        columns = std::max(1, static_cast<int>(std::ceil((x1 - x0) / this->cell_size)));
+        rows = std::max(1, static_cast<int>(std::ceil((y1 - y0) / this->cell_size)));
+        const size_t count = static_cast<size_t>(columns) * rows;
+        if (cells.size() != count) {
+            cells.assign(count, std::vector<Circle>());
+        } else {
+            for (auto &cell : cells) {
+                cell.clear();
+            }
+        }
+        claimed.assign(count, false);
+        max_radius = 0;
+    }
+
+    // Points outside the covered area are kept in the nearest border cell
+    void insert(float x, float y, float radius, unsigned item) {
+        cells[index(column(x), row(y))].push_back(Circle{x, y, radius, item});
+        max_radius = std::max(max_radius, radius);
+    }
+
+    // Calls found(item) for every circle that the point (x, y) lies strictly inside of
+    template<typename Found>
+    void query(float x, float y, Found found) const {
+        const int c0 = column(x - max_radius), c1 = column(x + max_radius);
+        const int r0 = row(y - max_radius), r1 = row(y + max_radius);
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                for (const Circle &circle : cells[index(c, r)]) {
+                    const float dx = circle.x - x, dy = circle.y - y;
+                    if (dx * dx + dy * dy < circle.radius * circle.radius) {
+                        found(circle.item);
+                    }
+                }
+            }
+        }
+    }
+
+    // Marks the cells under the rectangle as taken, unless one of them already is
+    bool claim(float left, float bottom, float right, float top) {
+        const int c0 = column(left), c1 = column(right);
+        const int r0 = row(bottom), r1 = row(top);
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                if (claimed[index(c, r)]) {
+                    return false;
+                }
+            }
+        }
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                claimed[index(c, r)] = true;
+            }
+        }
+        return true;
+    }
+
+    // Like claim, but if the rectangle is taken it is moved by up to reach cells each way, trying the
+    // closest free spot first and moving along the rows before across them. Moves the rectangle to where
+    // it was claimed, or returns false if nothing within reach was free
+    bool claimNear(float &left, float &bottom, float &right, float &top, int reach) {
+        if (claim(left, bottom, right, top)) {
+            return true;
+        }
+        std::vector<std::pair<int, int> > offsets;
+        for (int dr = -reach; dr <= reach; ++dr) {
+            for (int dc = -reach; dc <= reach; ++dc) {
+                if (dr != 0 || dc != 0) {
+                    offsets.push_back(std::make_pair(dc, dr));
+                }
+            }
+        }
+        std::stable_sort(offsets.begin(), offsets.end(), [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+            const int da = a.first * a.first + a.second * a.second, db = b.first * b.first + b.second * b.second;
+            return da != db ? da < db : std::abs(a.first) < std::abs(b.first);
+        });
+        for (const auto &offset : offsets) {
+            const float dx = offset.first * cell_size, dy = offset.second * cell_size;
+            if (!inside(left + dx, bottom + dy) || !inside(right + dx, top + dy)) {
+                continue;
+            }
+            if (claim(left + dx, bottom + dy, right + dx, top + dy)) {
+                left += dx;
+                right += dx;
+                bottom += dy;
+                top += dy;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Circle {
+        float x;
+        float y;
+        float radius;
+        unsigned item;
+    };
+
+    int column(float x) const {
+        return std::min(columns - 1, std::max(0, static_cast<int>(std::floor((x - x0) / cell_size))));
+    }
+
+    int row(float y) const {
+        return std::min(rows - 1, std::max(0, static_cast<int>(std::floor((y - y0) / cell_size))));
+    }
+
+    bool inside(float x, float y) const {
+        return x >= x0 && y >= y0 && x < x0 + columns * cell_size && y < y0 + rows * cell_size;
+    }
+
+    size_t index(int column, int row) const {
+        return static_cast<size_t>(row) * columns + column;
+    }
+
+    float x0;
+    float y0;
+    float cell_size;
+    int columns;
+    int rows;
+    float max_radius;
+    std::vector<std::vector<Circle>> cells;
+    std::vector<bool> claimed;
+};
+
+#endif //VEGA_STRIKE_ENGINE_GFX_NAV_SCREEN_GRID_H
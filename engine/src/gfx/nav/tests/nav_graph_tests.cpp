@@ -0,0 +1,222 @@
+/*
+ * nav_graph_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "gfx/nav/nav_graph.h"
+#include "vs_thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace {
+// Random galaxy with two-way jumps, like CachedSystemIterator builds them
+NavGraph makeGalaxy(unsigned systems, unsigned jumps, unsigned seed, std::vector<std::vector<unsigned>> &lanes,
+        std::vector<bool> &drawable) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<unsigned> system(0, systems - 1);
+    lanes.assign(systems, std::vector<unsigned>());
+    drawable.assign(systems, true);
+    for (unsigned i = 1; i < systems; ++i) {
+        // A spanning tree first, so most systems are reachable
+        unsigned other = system(generator) % i;
+        lanes[i].push_back(other);
+        lanes[other].push_back(i);
+    }
+    for (unsigned i = 0; i < jumps; ++i) {
+        unsigned a = system(generator);
+        unsigned b = system(generator);
+        if (a != b) {
+            lanes[a].push_back(b);
+            lanes[b].push_back(a);
+        }
+    }
+    for (unsigned i = 0; i < systems / 20; ++i) {
+        drawable[system(generator)] = false;
+    }
+    NavGraph graph;
+    for (unsigned i = 0; i < systems; ++i) {
+        graph.addSystem(drawable[i], lanes[i]);
+    }
+    return graph;
+}
+
+// Jumps from origin to every system, through drawable systems only; the
+// destination itself need not be drawable
+std::vector<int> distances(const std::vector<std::vector<unsigned>> &lanes, const std::vector<bool> &drawable,
+        unsigned origin, unsigned destination) {
+    std::vector<int> distance(lanes.size(), -1);
+    std::deque<unsigned> frontier(1, origin);
+    distance[origin] = 0;
+    while (!frontier.empty()) {
+        unsigned index = frontier.front();
+        frontier.pop_front();
+        for (unsigned next : lanes[index]) {
+            if ((drawable[next] || next == destination) && distance[next] == -1) {
+                distance[next] = distance[index] + 1;
+                frontier.push_back(next);
+            }
+        }
+    }
+    return distance;
+}
+
+bool isRoute(const std::vector<std::vector<unsigned>> &lanes, const std::vector<bool> &drawable,
+        const std::list<unsigned> &route) {
+    std::list<unsigned>::const_iterator previous = route.begin();
+    for (std::list<unsigned>::const_iterator i = std::next(route.begin()); i != route.end(); ++i, ++previous) {
+        if (previous != route.begin() && !drawable[*previous]) {
+            return false;
+        }
+        const std::vector<unsigned> &jumps = lanes[*previous];
+        if (std::find(jumps.begin(), jumps.end(), *i) == jumps.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+// The two fronts take turns node by node, so a route may run a jump longer
+// than the shortest one; that is how the map has always routed.
+TEST(NavGraph, ValidRoutes) {
+    std::vector<std::vector<unsigned>> lanes;
+    std::vector<bool> drawable;
+    NavGraph graph = makeGalaxy(2000, 1000, 3, lanes, drawable);
+    ASSERT_EQ(graph.size(), 2000);
+
+    std::mt19937 generator(9);
+    std::uniform_int_distribution<unsigned> system(0, graph.size() - 1);
+    int found = 0;
+    for (int i = 0; i < 50; ++i) {
+        unsigned origin = system(generator);
+        unsigned destination = system(generator);
+        std::vector<int> distance = distances(lanes, drawable, origin, destination);
+
+        std::list<unsigned> route;
+        bool routed = graph.findRoute(origin, destination, 16384, route);
+        if (origin == destination) {
+            EXPECT_TRUE(routed);
+            EXPECT_EQ(route.size(), 1);
+        } else if (distance[destination] == -1) {
+            EXPECT_FALSE(routed);
+            EXPECT_TRUE(route.empty());
+        } else {
+            ASSERT_TRUE(routed);
+            EXPECT_EQ(route.front(), origin);
+            EXPECT_EQ(route.back(), destination);
+            EXPECT_TRUE(isRoute(lanes, drawable, route));
+            EXPECT_GE(static_cast<int>(route.size()) - 1, distance[destination]);
+            ++found;
+        }
+    }
+    EXPECT_GT(found, 40);
+}
+
+TEST(NavGraph, RouteToFirstMatch) {
+    // 0 - 1 - 2 - 3 - 4, with 5 hanging off 1 and not on the map
+    std::vector<std::vector<unsigned>> lanes = {{1}, {0, 2, 5}, {1, 3}, {2, 4}, {3}, {1}};
+    NavGraph graph;
+    for (unsigned i = 0; i < lanes.size(); ++i) {
+        graph.addSystem(i != 5, lanes[i]);
+    }
+
+    std::list<unsigned> route;
+    EXPECT_TRUE(graph.findRoute(std::deque<unsigned>(1, 0), [](unsigned index) {
+        return index >= 3;
+    }, 16384, route));
+    EXPECT_EQ(route, std::list<unsigned>({0, 1, 2, 3}));
+
+    // From several origins, the nearest one wins
+    EXPECT_TRUE(graph.findRoute(std::deque<unsigned>({0, 3}), [](unsigned index) {
+        return index == 4;
+    }, 16384, route));
+    EXPECT_EQ(route, std::list<unsigned>({3, 4}));
+
+    // An origin that already matches
+    EXPECT_TRUE(graph.findRoute(std::deque<unsigned>({2}), [](unsigned index) {
+        return index == 2;
+    }, 16384, route));
+    EXPECT_EQ(route, std::list<unsigned>({2}));
+
+    EXPECT_FALSE(graph.findRoute(std::deque<unsigned>(1, 0), [](unsigned index) {
+        return index == 5;
+    }, 16384, route));
+    EXPECT_TRUE(route.empty());
+    // A route can end in a system off the map
+    EXPECT_TRUE(graph.findRoute(0, 5, 16384, route));
+    EXPECT_EQ(route, std::list<unsigned>({0, 1, 5}));
+    EXPECT_FALSE(graph.findRoute(0, 17, 16384, route));
+}
+
+TEST(NavGraph, SearchesOnWorkers) {
+    std::vector<std::vector<unsigned>> lanes;
+    std::vector<bool> drawable;
+    std::shared_ptr<const NavGraph> graph =
+            std::make_shared<NavGraph>(makeGalaxy(20000, 10000, 5, lanes, drawable));
+
+    std::mt19937 generator(13);
+    std::uniform_int_distribution<unsigned> system(0, graph->size() - 1);
+    std::vector<std::pair<unsigned, unsigned>> ends;
+    for (int i = 0; i < 64; ++i) {
+        ends.push_back(std::make_pair(system(generator), system(generator)));
+    }
+
+    const auto here_start = std::chrono::steady_clock::now();
+    std::vector<std::list<unsigned>> expected(ends.size());
+    for (size_t i = 0; i < ends.size(); ++i) {
+        graph->findRoute(ends[i].first, ends[i].second, 16384, expected[i]);
+    }
+    const auto workers_start = std::chrono::steady_clock::now();
+
+    // One shared snapshot, searched from several threads at once
+    std::vector<std::future<std::list<unsigned>>> searches;
+    for (size_t i = 0; i < ends.size(); ++i) {
+        const std::pair<unsigned, unsigned> end = ends[i];
+        searches.push_back(VegaStrike::SubmitWork([graph, end]() {
+            std::list<unsigned> route;
+            graph->findRoute(end.first, end.second, 16384, route);
+            return route;
+        }));
+    }
+    for (size_t i = 0; i < searches.size(); ++i) {
+        EXPECT_EQ(searches[i].get(), expected[i]);
+    }
+    const auto workers_end = std::chrono::steady_clock::now();
+
+    const std::chrono::duration<double, std::milli> here_time = workers_start - here_start;
+    const std::chrono::duration<double, std::milli> workers_time = workers_end - workers_start;
+    std::cout << ends.size() << " routes over " << graph->size() << " systems: " << here_time.count()
+              << " ms in one thread, " << workers_time.count() << " ms on the workers" << std::endl;
+}
@@ -0,0 +1,137 @@
+/*
+ * screen_grid_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "gfx/nav/screen_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+struct Node {
+    float x;
+    float y;
+    float radius;
+};
+}
+
+TEST(ScreenGrid, Query) {
+    ScreenGrid grid;
+    grid.reset(-0.5f, 0.5f, -0.5f, 0.5f, 0.1f);
+    grid.insert(0.0f, 0.0f, 0.05f, 1);
+    grid.insert(0.08f, 0.0f, 0.05f, 2);
+    grid.insert(0.3f, 0.3f, 0.05f, 3);
+    grid.insert(0.9f, 0.0f, 0.45f, 4);   // off the screen, but its circle is not
+
+    std::vector<unsigned> found;
+    auto collect = [&found](unsigned item) {
+        found.push_back(item);
+    };
+    grid.query(0.04f, 0.0f, collect);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, (std::vector<unsigned>{1, 2}));
+
+    found.clear();
+    grid.query(0.46f, 0.0f, collect);
+    EXPECT_EQ(found, (std::vector<unsigned>{4}));
+
+    found.clear();
+    grid.query(-0.3f, -0.3f, collect);
+    EXPECT_TRUE(found.empty());
+}
+
+TEST(ScreenGrid, MatchesBruteForce) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> coordinate(-0.6f, 0.6f);
+    std::uniform_real_distribution<float> radius(0.001f, 0.03f);
+    std::vector<Node> nodes;
+    ScreenGrid grid;
+    grid.reset(-0.5f, 0.5f, -0.5f, 0.5f, 1.0f / 31);
+    for (unsigned i = 0; i < 10000; ++i) {
+        nodes.push_back(Node{coordinate(random), coordinate(random), radius(random)});
+        grid.insert(nodes.back().x, nodes.back().y, nodes.back().radius, i);
+    }
+    for (int n = 0; n < 500; ++n) {
+        const float x = coordinate(random), y = coordinate(random);
+        std::vector<unsigned> expected, found;
+        for (unsigned i = 0; i < nodes.size(); ++i) {
+            const float dx = nodes[i].x - x, dy = nodes[i].y - y;
+            if (dx * dx + dy * dy < nodes[i].radius * nodes[i].radius) {
+                expected.push_back(i);
+            }
+        }
+        grid.query(x, y, [&found](unsigned item) {
+            found.push_back(item);
+        });
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+}
+
+TEST(ScreenGrid, Claim) {
+    ScreenGrid grid;
+    grid.reset(0.0f, 1.0f, 0.0f, 1.0f, 0.1f);
+    EXPECT_TRUE(grid.claim(0.12f, 0.5f, 0.28f, 0.5f));
+    EXPECT_FALSE(grid.claim(0.25f, 0.52f, 0.45f, 0.52f));  // overlaps the first one
+    EXPECT_TRUE(grid.claim(0.32f, 0.52f, 0.45f, 0.52f));   // the failed claim took nothing
+    EXPECT_TRUE(grid.claim(0.12f, 0.65f, 0.28f, 0.65f));   // a row further up
+
+    grid.reset(0.0f, 1.0f, 0.0f, 1.0f, 0.1f);
+    EXPECT_TRUE(grid.claim(0.12f, 0.5f, 0.28f, 0.5f));
+}
+
+TEST(ScreenGrid, ClaimNear) {
+    ScreenGrid grid;
+    grid.reset(0.0f, 1.0f, 0.0f, 1.0f, 0.1f);
+    EXPECT_TRUE(grid.claim(0.42f, 0.55f, 0.58f, 0.55f));
+
+    // taken, so it moves one row away rather than sideways
+    float left = 0.42f, bottom = 0.55f, right = 0.58f, top = 0.55f;
+    EXPECT_TRUE(grid.claimNear(left, bottom, right, top, 2));
+    EXPECT_FLOAT_EQ(left, 0.42f);
+    EXPECT_FLOAT_EQ(right, 0.58f);
+    EXPECT_NEAR(std::abs(bottom - 0.55f), 0.1f, 1e-5f);
+    EXPECT_FLOAT_EQ(bottom, top);
+
+    // a free spot is claimed where it is
+    left = 0.12f, bottom = 0.15f, right = 0.18f, top = 0.15f;
+    EXPECT_TRUE(grid.claimNear(left, bottom, right, top, 2));
+    EXPECT_FLOAT_EQ(left, 0.12f);
+    EXPECT_FLOAT_EQ(bottom, 0.15f);
+
+    // nothing free within reach, and nothing is taken by trying
+    grid.reset(0.0f, 1.0f, 0.0f, 1.0f, 0.1f);
+    EXPECT_TRUE(grid.claim(0.0f, 0.0f, 0.99f, 0.99f));
+    left = 0.42f, bottom = 0.55f, right = 0.58f, top = 0.55f;
+    EXPECT_FALSE(grid.claimNear(left, bottom, right, top, 2));
+    EXPECT_FLOAT_EQ(left, 0.42f);
+    EXPECT_FLOAT_EQ(bottom, 0.55f);
+}
@@ -34,10 +34,6 @@
 #include "gldrv/gl_globals.h"
 #include "src/universe.h"
 
-#include <iterator>
-#include <limits>
-
-#include "aligned.h"
 #include "src/vs_logging.h"
 
 ParticleTrail particleTrail("sparkle", 500, SRCALPHA, ONE, 0.05f, false, true);
@@ -75,148 +71,6 @@ void ParticleTrail::ChangeMax(unsigned int max) {
     this->max_particles = max;
 }
 
-//Write 12 * 3 pos and 12 * 4 col and 12 * 2 tex float values into v and increment v by 108
-static inline void SetQuadVertex(const QVector &loc,
-        const GFXColor &col,
-        const float psize,
-        const float grow,
-        const float trans,
-        std::back_insert_iterator<std::vector<float> > &v,
-        const QVector &campos) {
-    float size = psize * (grow * (1 - col.a) + col.a);
-    float maxsize = (psize > size) ? psize : size;
-    float minsize = (psize <= size) ? psize : size;
-
-    //Squared, surface-linked decay - looks nicer, more real for emissive gasses
-    //NOTE: maxsize/minsize allows for inverted growth (shrinkage) while still fading correctly. Cheers!
-    GFXColor c = col * (col.a * trans * (minsize / ((maxsize > 0) ? maxsize : 1.f)));
-    QVector l = loc - campos;
-
-    *v++ = l.i + size;
-    *v++ = l.j + size;
-    *v++ = l.k;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 0;
-    *v++ = 0;
-    *v++ = l.i + size;
-    *v++ = l.j - size;
-    *v++ = l.k;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 0;
-    *v++ = 1;
-    *v++ = l.i - size;
-    *v++ = l.j - size;
-    *v++ = l.k;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 1;
-    *v++ = 1;
-    *v++ = l.i - size;
-    *v++ = l.j + size;
-    *v++ = l.k;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 1;
-    *v++ = 0;
-
-    *v++ = l.i;
-    *v++ = l.j + size;
-    *v++ = l.k + size;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 0;
-    *v++ = 0;
-    *v++ = l.i;
-    *v++ = l.j - size;
-    *v++ = l.k + size;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 0;
-    *v++ = 1;
-    *v++ = l.i;
-    *v++ = l.j - size;
-    *v++ = l.k - size;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 1;
-    *v++ = 1;
-    *v++ = l.i;
-    *v++ = l.j + size;
-    *v++ = l.k - size;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 1;
-    *v++ = 0;
-
-    *v++ = l.i + size;
-    *v++ = l.j;
-    *v++ = l.k + size;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 0;
-    *v++ = 0;
-    *v++ = l.i + size;
-    *v++ = l.j;
-    *v++ = l.k - size;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 0;
-    *v++ = 1;
-    *v++ = l.i - size;
-    *v++ = l.j;
-    *v++ = l.k - size;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 1;
-    *v++ = 1;
-    *v++ = l.i - size;
-    *v++ = l.j;
-    *v++ = l.k + size;
-    *v++ = c.r;
-    *v++ = c.g;
-    *v++ = c.b;
-    *v++ = c.a;
-    *v++ = 1;
-    *v++ = 0;
-}
-
-template<typename R, typename T>
-class IndexCompare {
-    const std::vector<R> &ref;
-
-public:
-    explicit IndexCompare(const std::vector<R> &ref_) : ref(ref_) {
-    }
-
-    bool operator()(const T &a, const T &b) const {
-        return ref[a] > ref[b];
-    }
-};
-
 ParticleTrail::Config::Config(const std::string &prefix) {
     texture = nullptr;
     initialized = false;
@@ -310,37 +164,14 @@ void ParticleTrail::DrawAndUpdate() {
             GFXBlendMode(ONE, ZERO);
         }
 
-        particleVert.clear();
-        particleVert.reserve(particles.size() * (3 + 4));
-        std::back_insert_iterator<std::vector<float> > v(particleVert);
-        for (size_t i = 0; i < nparticles; ++i) {
-            const QVector &loc = particles[i].location;
-            std::back_insert_iterator<std::vector<float>> &v_1 = v;
-            float size = particles[i].size * (pgrow * (1.0f - particles[i].color.a) + particles[i].color.a);
-            float maxsize = (particles[i].size > size) ? particles[i].size : size;
-            float minsize = (particles[i].size <= size) ? particles[i].size : size;
-
-            //Squared, surface-linked decay - looks nicer, more real for emissive gasses
-            //NOTE: maxsize/minsize allows for inverted growth (shrinkage) while still fading correctly. Cheers!
-            GFXColor c_1 =
-                    particles[i].color * (particles[i].color.a * ptrans * (minsize / ((maxsize > 0) ? maxsize : 1.0F)));
-            QVector l = loc - kCameraPosition;
-
-            *v_1++ = l.x;
-            *v_1++ = l.y;
-            *v_1++ = l.y;
-            *v_1++ = c_1.r;
-            *v_1++ = c_1.g;
-            *v_1++ = c_1.b;
-            *v_1++ = c_1.a;
-        }
-        GFXDraw(GFXPOINT, &particleVert[0], particles.size(), 3, 4);
+        particles.WritePoints(kCameraPosition, pgrow, ptrans, particleVert);
+        GFXDraw(GFXPOINT, &particleVert[0], nparticles, 3, 4);
 
         glDisable(GL_POINT_SMOOTH);
         GFXPointSize(1);
     } else {
         Texture *t = config.texture;
-        const int vertsPerParticle = 12;
+        const int vertsPerParticle = ParticleStreams::kVerticesPerQuad;
         bool dosort = blenddst != ONE && (blenddst != ZERO || !writeDepth);
 
         GFXEnable(TEXTURE0);
@@ -357,49 +188,18 @@ void ParticleTrail::DrawAndUpdate() {
         t->MakeActive();
 
         if (dosort) {
-            // Must sort
-            distances.clear();
-            distances.reserve(nparticles);
-            {
-                for (const auto & it : particles) {
-                    distances.push_back((kCameraPosition - it.location).MagnitudeSquared());
-                }
-            }
-            IndexCompare<float, unsigned short> dcomp(distances);
-
-            unsigned short nindices;
-            if (nparticles >= (size_t) std::numeric_limits<unsigned short>::max() / vertsPerParticle) {
-                nindices = (unsigned short) std::numeric_limits<unsigned short>::max() / vertsPerParticle;
-            } else {
-                nindices = (unsigned short) nparticles;
-            }
-            pointIndices.clear();
-            pointIndices.reserve(nindices);
-            {
-                for (unsigned short i = 0; i < nindices; ++i) {
-                    pointIndices.push_back(i);
-                }
-            }
-
-            std::sort(pointIndices.begin(), pointIndices.end(), dcomp);
-
-            indices.clear();
-            indices.reserve(static_cast<size_t>(nindices) * vertsPerParticle);
-            {
-                for (unsigned short point_index : pointIndices) {
-                    for (int i = 0; i < vertsPerParticle; ++i) {
-                        indices.push_back(point_index * vertsPerParticle + i);
-                    }
+            // Must sort, back to front
+            const std::vector<unsigned int> &order = particles.DepthOrder(kCameraPosition);
+            indices.resize(nparticles * vertsPerParticle);
+            unsigned int *index = indices.data();
+            for (unsigned int point_index : order) {
+                for (int i = 0; i < vertsPerParticle; ++i) {
+                    *index++ = point_index * vertsPerParticle + i;
                 }
             }
         }
 
-        particleVert.clear();
-        particleVert.reserve(nparticles * vertsPerParticle * (3 + 4 + 2));
-        std::back_insert_iterator<std::vector<float> > v(particleVert);
-        for (size_t i = 0; i < nparticles; ++i) {
-            SetQuadVertex(particles[i].location, particles[i].color, particles[i].size, pgrow, ptrans, v, kCameraPosition);
-        }
+        particles.WriteQuads(kCameraPosition, pgrow, ptrans, particleVert);
 
         if (dosort) {
             VS_LOG(trace, (boost::format("Drawing %1%/%2% sorted particles") % nparticles % max_particles));
@@ -409,7 +209,7 @@ void ParticleTrail::DrawAndUpdate() {
                     3, 4, 2);
         } else {
             VS_LOG(trace, (boost::format("Drawing %1%/%2% unsorted particles") % nparticles % max_particles));
-            GFXDraw(GFXQUAD, &particleVert[0], nparticles * 12, 3, 4, 2);
+            GFXDraw(GFXQUAD, &particleVert[0], nparticles * vertsPerParticle, 3, 4, 2);
         }
 
         if (alphaMask > 0) {
@@ -421,75 +221,11 @@ void ParticleTrail::DrawAndUpdate() {
     GFXLoadIdentity(MODEL);
 
     // Update particles
-    const double elapsed_time_as_double = GetElapsedTime();
-    const float elapsed_time_as_float = static_cast<float>(elapsed_time_as_double);
-    if (fadeColor) {
-        float fadetimef = pfade * elapsed_time_as_double;
-        _ALIGNED(16) GFXColor fadetime = GFXColor(fadetimef, fadetimef, fadetimef, fadetimef);
-
-        for (auto & particle : particles) {
-            particle.location += particle.velocity * elapsed_time_as_double;
-            particle.color = particle.color - fadetime;
-            particle.color.clamp();
-        }
-    } else {
-        for (auto & particle : particles) {
-            particle.location += particle.velocity * elapsed_time_as_double;
-            particle.color.a = std::max(0.0F, particle.color.a - pfade * elapsed_time_as_float);
-        }
-    }
-
-    // Compute alpha for dead particles
-    float min_alpha = (ptrans > 0.0f) ? sqrtf(alphaMask / ptrans) : 0.0f;
-
-    //if (nparticles) {
-    //VS_LOG(trace, (boost::format("Drawn %1% particles, min_alpha %2%") % nparticles % min_alpha));
-    //}
-
-//    // Quickly remove dead particles at the end
-//    while (!particleColor.empty() && particleColor.back().a <= min_alpha) {
-//        particleVel.pop_back();
-//        particleLoc.pop_back();
-//        particleColor.pop_back();
-//        particleSize.pop_back();
-//    }
+    particles.Integrate(GetElapsedTime(), pfade, fadeColor);
 
     // Remove dead particles anywhere
-    auto first_to_remove = std::stable_partition(particles.begin(), particles.end(), [min_alpha](Particle& item){ return item.color.a > min_alpha; });
-//    std::for_each(first_to_remove, particles.end(), [](Particle& particle){ delete });
-    particles.erase(first_to_remove, particles.end());
-//    vector<Vector, aligned_allocator<Vector> >::iterator v = particleVel.begin();
-//    vector<QVector, aligned_allocator<QVector> >::iterator loc = particleLoc.begin();
-//    vector<GFXColor, aligned_allocator<GFXColor> >::iterator col = particleColor.begin();
-//    vector<float, aligned_allocator<float> >::iterator sz = particleSize.begin();
-//    while (col != particleColor.end()) {
-//        if (!(col->a > min_alpha)) {
-//            vector<Vector, aligned_allocator<Vector> >::iterator vlast = particleVel.end() - 1;
-//            vector<QVector, aligned_allocator<QVector> >::iterator loclast = particleLoc.end() - 1;
-//            vector<GFXColor, aligned_allocator<GFXColor> >::iterator collast = particleColor.end() - 1;
-//            vector<float, aligned_allocator<float> >::iterator szlast = particleSize.end() - 1;
-//            if (col != collast) {
-//                *v = *vlast;
-//                *loc = *loclast;
-//                *col = *collast;
-//                *sz = *szlast;
-//            }
-//            size_t index = col - particleColor.begin();
-//            particleColor.pop_back();
-//            particleVel.pop_back();
-//            particleLoc.pop_back();
-//            particleSize.pop_back();
-//            col = particleColor.begin() + index;
-//            v = particleVel.begin() + index;
-//            loc = particleLoc.begin() + index;
-//            sz = particleSize.begin() + index;
-//        } else {
-//            ++loc;
-//            ++col;
-//            ++sz;
-//            ++v;
-//        }
-//    }
+    float min_alpha = (ptrans > 0.0f) ? sqrtf(alphaMask / ptrans) : 0.0f;
+    particles.Compact(min_alpha);
 }
 
 void ParticleTrail::AddParticle(const ParticlePoint &P, const Vector &V, float size) {
@@ -500,17 +236,11 @@ void ParticleTrail::AddParticle(const ParticlePoint &P, const Vector &V, float s
         return;
     }
 
-    Particle particle{};
-    particle.velocity = V;
-    particle.location = P.loc;
-    particle.color = P.col;
-    particle.size = P.size;
-
     if (particles.size() >= max_particles) {
         size_t off = ((size_t) rand()) % particles.size();
-        particles.at(off) = particle;
+        particles.Set(off, P.loc, V, P.col, P.size);
     } else {
-        particles.push_back(particle);
+        particles.Add(P.loc, V, P.col, P.size);
     }
 }
 
@@ -28,9 +28,9 @@
 #include <string>
 #include <memory>
 #include <string>
-#include "aligned.h"
 #include "gfx_generic/vec.h"
 #include "src/gfxlib_struct.h"
+#include "gfx/particle_streams.h"
 
 class Texture;
 
@@ -40,13 +40,6 @@ struct ParticlePoint {
     float size;
 };
 
-struct Particle {
-    Vector velocity{};
-    QVector location{};
-    GFXColor color{};
-    float size{};
-};
-
 /**
  * Particle system class, contains regularly updated geometry for all active
  * particles of the same kind.
@@ -54,11 +47,9 @@ struct Particle {
  * Can be instantiated statically.
  */
 class ParticleTrail {
-    std::vector<Particle, aligned_allocator<Particle>> particles;
+    ParticleStreams particles;
     std::vector<float> particleVert;
-    std::vector<float> distances;
-    std::vector<unsigned short> pointIndices;
-    std::vector<unsigned short> indices;
+    std::vector<unsigned int> indices;
     unsigned int max_particles{};
     BLENDFUNC blendsrc, blenddst;
     float alphaMask;
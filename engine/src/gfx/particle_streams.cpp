@@ -0,0 +1,257 @@
+/*
+ * particle_streams.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gfx/particle_streams.h"
+
+#include <algorithm>
+
+void ParticleStreams::clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    vx.clear();
+    vy.clear();
+    vz.clear();
+    r.clear();
+    g.clear();
+    b.clear();
+    a.clear();
+    sizes.clear();
+    order.clear();
+}
+
+void ParticleStreams::Add(const QVector &location, const Vector &velocity, const GFXColor &color, float size) {
+    order.push_back(static_cast<unsigned int>(a.size()));
+    x.push_back(location.i);
+    y.push_back(location.j);
+    z.push_back(location.k);
+    vx.push_back(velocity.i);
+    vy.push_back(velocity.j);
+    vz.push_back(velocity.k);
+    r.push_back(color.r);
+    g.push_back(color.g);
+    b.push_back(color.b);
+    a.push_back(color.a);
+    sizes.push_back(size);
+}
+
+void ParticleStreams::Set(size_t index,
+        const QVector &location,
+        const Vector &velocity,
+        const GFXColor &color,
+        float size) {
+    x[index] = location.i;
+    y[index] = location.j;
+    z[index] = location.k;
+    vx[index] = velocity.i;
+    vy[index] = velocity.j;
+    vz[index] = velocity.k;
+    r[index] = color.r;
+    g[index] = color.g;
+    b[index] = color.b;
+    a[index] = color.a;
+    sizes[index] = size;
+}
+
+void ParticleStreams::Integrate(double elapsed, float fade, bool fade_color) {
+    const size_t n = size();
+    for (size_t i = 0; i < n; ++i) {
+        x[i] += vx[i] * elapsed;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        y[i] += vy[i] * elapsed;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        z[i] += vz[i] * elapsed;
+    }
+    const float fadetime = fade * static_cast<float>(elapsed);
+    if (fade_color) {
+        for (size_t i = 0; i < n; ++i) {
+            r[i] = std::max(0.0f, r[i] - fadetime);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            g[i] = std::max(0.0f, g[i] - fadetime);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            b[i] = std::max(0.0f, b[i] - fadetime);
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = std::max(0.0f, a[i] - fadetime);
+    }
+}
+
+void ParticleStreams::Compact(float min_alpha) {
+    const size_t n = size();
+    const unsigned int dead = static_cast<unsigned int>(-1);
+    remap.resize(n);
+    size_t kept = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (!(a[i] > min_alpha)) {
+            remap[i] = dead;
+            continue;
+        }
+        if (kept != i) {
+            x[kept] = x[i];
+            y[kept] = y[i];
+            z[kept] = z[i];
+            vx[kept] = vx[i];
+            vy[kept] = vy[i];
+            vz[kept] = vz[i];
+            r[kept] = r[i];
+            g[kept] = g[i];
+            b[kept] = b[i];
+            a[kept] = a[i];
+            sizes[kept] = sizes[i];
+        }
+        remap[i] = static_cast<unsigned int>(kept++);
+    }
+    if (kept == n) {
+        return;
+    }
+    x.resize(kept);
+    y.resize(kept);
+    z.resize(kept);
+    vx.resize(kept);
+    vy.resize(kept);
+    vz.resize(kept);
+    r.resize(kept);
+    g.resize(kept);
+    b.resize(kept);
+    a.resize(kept);
+    sizes.resize(kept);
+
+    size_t survivors = 0;
+    for (unsigned int index : order) {
+        if (remap[index] != dead) {
+            order[survivors++] = remap[index];
+        }
+    }
+    order.resize(survivors);
+}
+
+const std::vector<unsigned int> &ParticleStreams::DepthOrder(const QVector &camera) {
+    const size_t n = size();
+    distances.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const double dx = x[i] - camera.i;
+        const double dy = y[i] - camera.j;
+        const double dz = z[i] - camera.k;
+        distances[i] = static_cast<float>(dx * dx + dy * dy + dz * dz);
+    }
+
+    // Insertion sort from the previous frame's order, farthest first. Give up
+    // on it once it has shifted a few entries per particle and sort instead.
+    size_t budget = 4 * n + 64;
+    bool sorted = true;
+    for (size_t i = 1; i < n && sorted; ++i) {
+        const unsigned int index = order[i];
+        const float distance = distances[index];
+        size_t j = i;
+        while (j > 0 && distances[order[j - 1]] < distance) {
+            order[j] = order[j - 1];
+            --j;
+        }
+        order[j] = index;
+        if (i - j > budget) {
+            sorted = false;
+        } else {
+            budget -= i - j;
+        }
+    }
+    if (!sorted) {
+        const std::vector<float> &ref = distances;
+        std::sort(order.begin(), order.end(), [&ref](unsigned int lhs, unsigned int rhs) {
+            return ref[lhs] > ref[rhs];
+        });
+    }
+    return order;
+}
+
+GFXColor ParticleStreams::FadedColor(size_t index, float grow, float trans, float &size) const {
+    const float psize = sizes[index];
+    const float alpha = a[index];
+    size = psize * (grow * (1.0f - alpha) + alpha);
+    const float maxsize = (psize > size) ? psize : size;
+    const float minsize = (psize <= size) ? psize : size;
+
+    //Squared, surface-linked decay - looks nicer, more real for emissive gasses
+    //NOTE: maxsize/minsize allows for inverted growth (shrinkage) while still fading correctly. Cheers!
+    return Color(index) * (alpha * trans * (minsize / ((maxsize > 0) ? maxsize : 1.0f)));
+}
+
+void ParticleStreams::WritePoints(const QVector &camera, float grow, float trans, std::vector<float> &out) const {
+    const size_t n = size();
+    out.resize(n * (3 + 4));
+    float *v = out.data();
+    for (size_t i = 0; i < n; ++i) {
+        float size;
+        const GFXColor c = FadedColor(i, grow, trans, size);
+        *v++ = static_cast<float>(x[i] - camera.i);
+        *v++ = static_cast<float>(y[i] - camera.j);
+        *v++ = static_cast<float>(z[i] - camera.k);
+        *v++ = c.r;
+        *v++ = c.g;
+        *v++ = c.b;
+        *v++ = c.a;
+    }
+}
+
+//Write 12 * 3 pos and 12 * 4 col and 12 * 2 tex float values into v and advance it by 108
+static inline void SetQuadVertex(float li, float lj, float lk, float size, const GFXColor &c, float *&v) {
+    const float corners[ParticleStreams::kVerticesPerQuad][5] = {
+            {size, size, 0, 0, 0}, {size, -size, 0, 0, 1}, {-size, -size, 0, 1, 1}, {-size, size, 0, 1, 0},
+            {0, size, size, 0, 0}, {0, -size, size, 0, 1}, {0, -size, -size, 1, 1}, {0, size, -size, 1, 0},
+            {size, 0, size, 0, 0}, {size, 0, -size, 0, 1}, {-size, 0, -size, 1, 1}, {-size, 0, size, 1, 0}
+    };
+    for (const auto &corner : corners) {
+        *v++ = li + corner[0];
+        *v++ = lj + corner[1];
+        *v++ = lk + corner[2];
+        *v++ = c.r;
+        *v++ = c.g;
+        *v++ = c.b;
+        *v++ = c.a;
+        *v++ = corner[3];
+        *v++ = corner[4];
+    }
+}
+
+void ParticleStreams::WriteQuads(const QVector &camera, float grow, float trans, std::vector<float> &out) const {
+    const size_t n = size();
+    out.resize(n * kVerticesPerQuad * kFloatsPerQuadVertex);
+    float *v = out.data();
+    for (size_t i = 0; i < n; ++i) {
+        float size;
+        const GFXColor c = FadedColor(i, grow, trans, size);
+        SetQuadVertex(static_cast<float>(x[i] - camera.i),
+                static_cast<float>(y[i] - camera.j),
+                static_cast<float>(z[i] - camera.k),
+                size, c, v);
+    }
+}
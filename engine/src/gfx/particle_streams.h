@@ -0,0 +1,111 @@
+/*
+ * particle_streams.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_PARTICLE_STREAMS_H
+#define VEGA_STRIKE_ENGINE_GFX_PARTICLE_STREAMS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "gfx_generic/vec.h"
+#include "src/gfxlib_struct.h"
+
+/**
+ * Particle storage for ParticleTrail, one array per component so that the
+ * per-frame passes run as straight loops the compiler can vectorize. Holds
+ * no GL state; ParticleTrail feeds the vertex arrays it writes to GFXDraw.
+ */
+class ParticleStreams {
+public:
+    size_t size() const {
+        return a.size();
+    }
+
+    bool empty() const {
+        return a.empty();
+    }
+
+    void clear();
+
+    void Add(const QVector &location, const Vector &velocity, const GFXColor &color, float size);
+    void Set(size_t index, const QVector &location, const Vector &velocity, const GFXColor &color, float size);
+
+    QVector Location(size_t index) const {
+        return QVector(x[index], y[index], z[index]);
+    }
+
+    GFXColor Color(size_t index) const {
+        return GFXColor(r[index], g[index], b[index], a[index]);
+    }
+
+    float Size(size_t index) const {
+        return sizes[index];
+    }
+
+    /**
+     * Moves every particle along its velocity and fades it. With fade_color
+     * all four channels fade, otherwise only alpha does; neither goes below 0.
+     */
+    void Integrate(double elapsed, float fade, bool fade_color);
+
+    /**
+     * Drops the particles with alpha at or below min_alpha in one pass,
+     * keeping the order of the survivors (and of the depth order).
+     */
+    void Compact(float min_alpha);
+
+    /**
+     * Indices of all particles from the farthest to the nearest to camera.
+     * The order is kept between calls and repaired by insertion, which is
+     * linear while particles and camera move little from frame to frame; a
+     * full sort is used when that stops paying off.
+     */
+    const std::vector<unsigned int> &DepthOrder(const QVector &camera);
+
+    /// 3 position and 4 color floats per particle, relative to camera
+    void WritePoints(const QVector &camera, float grow, float trans, std::vector<float> &out) const;
+
+    /// 12 vertices of 3 position, 4 color and 2 texture floats per particle, relative to camera
+    void WriteQuads(const QVector &camera, float grow, float trans, std::vector<float> &out) const;
+
+    static const int kVerticesPerQuad = 12;
+    static const int kFloatsPerQuadVertex = 3 + 4 + 2;
+
+private:
+    GFXColor FadedColor(size_t index, float grow, float trans, float &size) const;
+
+    std::vector<double> x, y, z;
+    std::vector<float> vx, vy, vz;
+    std::vector<float> r, g, b, a;
+    std::vector<float> sizes;
+
+    std::vector<unsigned int> order;
+    std::vector<float> distances;
+    std::vector<unsigned int> remap;
+};
+
+#endif //VEGA_STRIKE_ENGINE_GFX_PARTICLE_STREAMS_H
@@ -30,8 +30,8 @@
 #include "cmd/unit_generic.h"
 #include "cmd/planet.h"
 #include "cmd/unit_util.h"
-#include "cmd/unit_find.h"
 #include "sensor.h"
+#include "sensor_snapshot.h"
 #include "src/universe.h"
 
 extern Unit *getTopLevelOwner(); // located in star_system.cpp
@@ -116,68 +116,79 @@ bool Sensor::InRange(const Track &track) const {
     return (track.GetDistance() <= GetMaxRange());
 }
 
-// FIXME: This is a convoluted way to obtain the radar tracks
+Track Sensor::CreateTrack(const SensorSnapshot &snapshot, size_t index) const {
+    assert(player);
+
+    return Track(player, snapshot, index);
+}
 
+// Applies the radar rules of one player to the units of the frame's snapshot
 class CollectRadarTracks {
 public:
-    CollectRadarTracks()
-            : sensor(NULL),
-            player(NULL),
-            collection(NULL) {
+    CollectRadarTracks(const Sensor *sensor, const SensorSnapshot &snapshot, Sensor::TrackCollection *collection)
+            : sensor(sensor),
+            snapshot(snapshot),
+            player(sensor->GetPlayer()),
+            collection(collection),
+            drawSignificantBlips(configuration()->graphics.hud.draw_significant_blips),
+            untargetOutCone(configuration()->graphics.hud.untarget_beyond_cone),
+            minRadarBlipSize(configuration()->graphics.hud.min_radar_blip_size),
+            maxRange(sensor->GetMaxRange()) {
     }
 
-    void init(const Sensor *sensor, Sensor::TrackCollection *collection, Unit *player) {
-        this->sensor = sensor;
-        this->collection = collection;
-        this->player = player;
-    }
+    void acquire(size_t index, float distance) {
+        const Unit *target = snapshot.GetUnit(index);
+        if (!detect(target, snapshot.Has(index, SensorSnapshot::Flags::PlayerOwned), distance)) {
+            return;
+        }
 
-    bool acquire(const Unit *target, float distance) {
-        assert(sensor);
-        assert(collection);
-        assert(player);
-        assert(target);
+        // Blips will be sorted later as different radars need to sort them differently
+        if (snapshot.GetSize(index) > minRadarBlipSize) {
+            collection->push_back(sensor->CreateTrack(snapshot, index));
+            // sub units of planets are shown when the planet is
+            snapshot.ForEachChild(index, [this](size_t child) {
+                collection->push_back(sensor->CreateTrack(snapshot, child));
+            });
+        }
+    }
 
-        const bool draw_significant_blips = configuration()->graphics.hud.draw_significant_blips;
-        const bool untarget_out_cone = configuration()->graphics.hud.untarget_beyond_cone;
-        const float min_radar_blip_size = configuration()->graphics.hud.min_radar_blip_size;
+    // For a unit that did not make it into the snapshot
+    void acquire(const Unit *target) {
+        if (detect(target, getTopLevelOwner() == target->owner, UnitUtil::getDistance(player, target))
+                && target->rSize() > minRadarBlipSize) {
+            collection->push_back(sensor->CreateTrack(target));
+        }
+    }
 
-        if (target != player) {
-            const bool isCurrentTarget = (player->Target() == target);
-            double dummy;
-            if (!player->InRange(target, dummy, isCurrentTarget && untarget_out_cone, true, true)) {
-                if (isCurrentTarget) {
-                    player->Target(NULL);
-                }
-                return true;
-            }
-            if (!isCurrentTarget &&
-                    !draw_significant_blips &&
-                    (getTopLevelOwner() == target->owner) &&
-                    (distance > player->radar.GetMaxRange())) {
-                return true;
-            }
+private:
+    bool detect(const Unit *target, bool playerOwned, float distance) {
+        assert(target);
 
-            // Blips will be sorted later as different radars need to sort them differently
-            if (target->rSize() > min_radar_blip_size) {
-                collection->push_back(sensor->CreateTrack(target));
-            }
-            if (target->isPlanet() == Vega_UnitType::planet && target->radial_size > 0) {
-                const Unit *sub = NULL;
-                for (un_kiter i = target->viewSubUnits(); (sub = *i) != NULL; ++i) {
-                    if (target->rSize() > min_radar_blip_size) {
-                        collection->push_back(sensor->CreateTrack(sub));
-                    }
-                }
+        if (target == player) {
+            return false;
+        }
+        const bool isCurrentTarget = (player->Target() == target);
+        double dummy;
+        if (!player->InRange(target, dummy, isCurrentTarget && untargetOutCone, true, true)) {
+            if (isCurrentTarget) {
+                player->Target(NULL);
             }
+            return false;
+        }
+        if (!isCurrentTarget && !drawSignificantBlips && playerOwned && (distance > maxRange)) {
+            return false;
         }
         return true;
     }
 
-private:
     const Sensor *sensor;
+    const SensorSnapshot &snapshot;
     Unit *player;
     Sensor::TrackCollection *collection;
+    const bool drawSignificantBlips;
+    const bool untargetOutCone;
+    const float minRadarBlipSize;
+    const float maxRange;
 };
 
 // FIXME: Scale objects according to distance and ignore those below a given threshold (which improves with better sensors)
@@ -190,27 +201,29 @@ const Sensor::TrackCollection &Sensor::FindTracksInRange() const {
     const float kMaxUnitRadius = configuration()->graphics.hud.radar_search_extra_radius;
     const bool kDrawGravitationalObjects = configuration()->graphics.hud.draw_gravitational_objects;
 
-    UnitWithinRangeLocator<CollectRadarTracks> unitLocator(GetMaxRange(), kMaxUnitRadius);
-    unitLocator.action.init(this, &collection, player);
-    if (!is_null(player->location[Unit::UNIT_ONLY])) {
-        findObjects(_Universe->activeStarSystem()->collide_map[Unit::UNIT_ONLY],
-                player->location[Unit::UNIT_ONLY],
-                &unitLocator);
-    }
+    const SensorSnapshot &snapshot = SensorSnapshot::ForActiveSystem();
+    CollectRadarTracks collector(this, snapshot, &collection);
+    snapshot.Query(player->Position(), player->rSize(), GetMaxRange(), kMaxUnitRadius,
+            [&collector](size_t index, float distance) {
+                collector.acquire(index, distance);
+            });
     if (kDrawGravitationalObjects) {
-        Unit *target = player->Target();
-        const Unit *gravUnit;
+        const Unit *target = player->Target();
         bool foundtarget = false;
-        for (un_kiter i = _Universe->activeStarSystem()->gravitationalUnits().constIterator();
-                (gravUnit = *i) != NULL;
-                ++i) {
-            unitLocator.action.acquire(gravUnit, UnitUtil::getDistance(player, gravUnit));
+        for (size_t index : snapshot.GetGravitational()) {
+            const Unit *gravUnit = snapshot.GetUnit(index);
+            collector.acquire(index, snapshot.GetDistance(index, player->Position(), player->rSize()));
             if (gravUnit == target) {
                 foundtarget = true;
             }
         }
         if (target && !foundtarget) {
-            unitLocator.action.acquire(target, UnitUtil::getDistance(player, target));
+            const size_t index = snapshot.Find(target);
+            if (index != snapshot.Size()) {
+                collector.acquire(index, snapshot.GetDistance(index, player->Position(), player->rSize()));
+            } else {
+                collector.acquire(target);
+            }
         }
     }
     return collection;
@@ -40,6 +40,8 @@ struct GFXColor;  // Edit from class to struct as defined in gfxlib_struct.
 
 namespace Radar {
 
+class SensorSnapshot;
+
 // Sensor is a proxy for two types of information:
 //   1. The operational parameters of the radar (e.g. range)
 //   2. Information detected by the radar (e.g. tracks)
@@ -82,6 +84,7 @@ public:
 
     Track CreateTrack(const Unit *) const;
     Track CreateTrack(const Unit *, const Vector &) const;
+    Track CreateTrack(const SensorSnapshot &, size_t) const;
 
     // I am tracking target
     bool IsTracking(const Track &) const;
@@ -0,0 +1,133 @@
+/*
+ * sensor_snapshot.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sensor_snapshot.h"
+#include "cmd/unit_generic.h"
+#include "cmd/unit_util.h"
+#include "root_generic/lin_time.h"
+#include "src/star_system.h"
+#include "src/universe.h"
+
+extern Unit *getTopLevelOwner(); // located in star_system.cpp
+
+namespace Radar {
+
+const SensorSnapshot &SensorSnapshot::ForActiveSystem() {
+    static SensorSnapshot snapshot;
+    static StarSystem *captured_system = nullptr;
+    static double captured_time = -1.0;
+
+    StarSystem *system = _Universe->activeStarSystem();
+    const double now = getNewTime();
+    if (system != captured_system || now != captured_time) {
+        snapshot.Capture(system);
+        captured_system = system;
+        captured_time = now;
+    }
+    return snapshot;
+}
+
+void SensorSnapshot::Capture(StarSystem *system) {
+    Clear();
+    if (system == nullptr) {
+        Finish();
+        return;
+    }
+
+    CollideMap *collide_map = system->collide_map[Unit::UNIT_ONLY];
+    for (CollideMap::iterator it = collide_map->begin(); it != collide_map->end(); ++it) {
+        const Unit *unit = it->radius > 0 ? it->ref.unit : nullptr;
+        if (unit == nullptr || Find(unit) != Size()) {
+            continue;
+        }
+        Describe(Add(unit, unit->Position(), unit->rSize(), Flags::Indexed));
+    }
+
+    const Unit *unit;
+    for (un_kiter i = system->gravitationalUnits().constIterator(); (unit = *i) != NULL; ++i) {
+        size_t index = Find(unit);
+        if (index == Size()) {
+            Describe(Add(unit, unit->Position(), unit->rSize(), Flags::Gravitational));
+        } else {
+            flags[index] |= Flags::Gravitational;
+            gravitational.push_back(index);
+        }
+    }
+
+    // planets carry their sub units (e.g. space elevators) onto the radar;
+    // children are appended behind all parents so that each parent's list is contiguous
+    const size_t parents = Size();
+    for (size_t parent = 0; parent < parents; ++parent) {
+        const Unit *planet = units[parent];
+        if (planet->isPlanet() != Vega_UnitType::planet || planet->radial_size <= 0) {
+            continue;
+        }
+        const Unit *sub;
+        for (un_kiter i = planet->viewSubUnits(); (sub = *i) != NULL; ++i) {
+            size_t child = Find(sub);
+            if (child == Size()) {
+                child = Add(sub, sub->Position(), sub->rSize(), Flags::None);
+                Describe(child);
+            }
+            AddChild(parent, child);
+        }
+    }
+    Finish();
+}
+
+void SensorSnapshot::Describe(size_t index) {
+    const Unit *unit = units[index];
+    faction[index] = unit->faction;
+    type[index] = Track::IdentifyType(unit);
+    if (UnitUtil::getECM(unit) > 0) {
+        flags[index] |= Flags::ECM;
+    }
+    if (unit->cloak.Cloaked()) {
+        flags[index] |= Flags::Cloaked;
+    }
+    if (unit->IsExploding()) {
+        flags[index] |= Flags::Exploding;
+        exploding_progress[index] = unit->ExplodingProgress();
+    }
+    if (unit->getNumMounts() > 0) {
+        flags[index] |= Flags::Weapons;
+    }
+    if (!unit->SubUnits.empty()) {
+        flags[index] |= Flags::Turrets;
+    }
+    if (unit->owner == getTopLevelOwner()) {
+        flags[index] |= Flags::PlayerOwned;
+    }
+    const Unit *targeted = unit->Target();
+    target[index] = targeted;
+    if (targeted != nullptr && unit->TargetLocked(targeted)) {
+        locked[index] = targeted;
+    }
+}
+
+} // namespace Radar
@@ -0,0 +1,242 @@
+/*
+ * sensor_snapshot.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_RADAR_SENSOR_SNAPSHOT_H
+#define VEGA_STRIKE_ENGINE_GFX_RADAR_SENSOR_SNAPSHOT_H
+
+#include <algorithm>
+#include <vector>
+
+#include "gfx_generic/vec.h"
+#include "src/gnuhash.h"
+#include "track.h"
+
+class Unit;
+class StarSystem;
+
+namespace Radar {
+
+// What every sensor in a star system can see during one frame, captured once
+// and shared by all radar displays and anyone else asking for tracks.
+// The data is kept column by column, so that range queries only walk the
+// positions and the rest is read for the few units that pass.
+class SensorSnapshot {
+public:
+    struct Flags {
+        enum Value {
+            None = 0,
+            Indexed = 1 << 0,       // found by Query, i.e. in the unit collide map
+            Gravitational = 1 << 1,
+            ECM = 1 << 2,
+            Cloaked = 1 << 3,
+            Exploding = 1 << 4,
+            Weapons = 1 << 5,
+            Turrets = 1 << 6,
+            PlayerOwned = 1 << 7    // launched by the player, e.g. a missile
+        };
+    };
+
+    // Returns the snapshot of the active star system, capturing it on the first call of a frame
+    static const SensorSnapshot &ForActiveSystem();
+
+    void Clear() {
+        units.clear();
+        position.clear();
+        size.clear();
+        faction.clear();
+        flags.clear();
+        type.clear();
+        exploding_progress.clear();
+        target.clear();
+        locked.clear();
+        children_begin.clear();
+        children_end.clear();
+        children.clear();
+        gravitational.clear();
+        order.clear();
+        order_key.clear();
+        index_of.clear();
+    }
+
+    // Appends a unit and returns its index; the other columns start empty
+    size_t Add(const Unit *unit, const QVector &centre, float radius, unsigned int flags_value) {
+        const size_t index = units.size();
+        units.push_back(unit);
+        position.push_back(centre);
+        size.push_back(radius);
+        faction.push_back(0);
+        flags.push_back(flags_value);
+        type.push_back(Track::Type::Unknown);
+        exploding_progress.push_back(0.0f);
+        target.push_back(nullptr);
+        locked.push_back(nullptr);
+        children_begin.push_back(0);
+        children_end.push_back(0);
+        if (unit) {
+            index_of[unit] = index;
+        }
+        if (flags_value & Flags::Gravitational) {
+            gravitational.push_back(index);
+        }
+        return index;
+    }
+
+    // Makes child the next of the units listed under parent, which must be the last parent given
+    void AddChild(size_t parent, size_t child) {
+        if (children_begin[parent] == children_end[parent]) {
+            children_begin[parent] = children.size();
+        }
+        children.push_back(child);
+        children_end[parent] = children.size();
+    }
+
+    // Sorts the indexed units along x; call after the last Add
+    void Finish() {
+        order.clear();
+        for (size_t i = 0; i < units.size(); ++i) {
+            if (flags[i] & Flags::Indexed) {
+                order.push_back(i);
+            }
+        }
+        std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+            return position[a].i < position[b].i;
+        });
+        order_key.resize(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order_key[i] = position[order[i]].i;
+        }
+    }
+
+    size_t Size() const {
+        return units.size();
+    }
+
+    // Calls found(index, distance) for every indexed unit whose surface is less than
+    // range away from the sphere at centre. Like the collide map locators, only
+    // units whose centre is within range + max_radius along x are considered.
+    template<typename Found>
+    void Query(const QVector &centre, float radius, float range, float max_radius, Found found) const {
+        const double reach = range + max_radius;
+        auto first = std::lower_bound(order_key.begin(), order_key.end(), centre.i - reach);
+        auto last = std::upper_bound(first, order_key.end(), centre.i + reach);
+        for (auto key = first; key != last; ++key) {
+            const size_t index = order[key - order_key.begin()];
+            const float distance = GetDistance(index, centre, radius);
+            if (distance < range) {
+                found(index, distance);
+            }
+        }
+    }
+
+    // Distance between the surfaces of a unit and the sphere at centre
+    float GetDistance(size_t index, const QVector &centre, float radius) const {
+        return (position[index] - centre).Magnitude() - size[index] - radius;
+    }
+
+    // Returns the index of unit, or Size() if it was not captured
+    size_t Find(const Unit *unit) const {
+        auto found = index_of.find(unit);
+        return found == index_of.end() ? units.size() : found->second;
+    }
+
+    const Unit *GetUnit(size_t index) const {
+        return units[index];
+    }
+
+    const QVector &GetPosition(size_t index) const {
+        return position[index];
+    }
+
+    float GetSize(size_t index) const {
+        return size[index];
+    }
+
+    int GetFaction(size_t index) const {
+        return faction[index];
+    }
+
+    bool Has(size_t index, Flags::Value flag) const {
+        return (flags[index] & flag) != 0;
+    }
+
+    Track::Type::Value GetType(size_t index) const {
+        return type[index];
+    }
+
+    float GetExplodingProgress(size_t index) const {
+        return exploding_progress[index];
+    }
+
+    // The unit this one targets
+    const Unit *GetTarget(size_t index) const {
+        return target[index];
+    }
+
+    // The unit this one has a weapon lock on, if any
+    const Unit *GetLocked(size_t index) const {
+        return locked[index];
+    }
+
+    const std::vector<size_t> &GetGravitational() const {
+        return gravitational;
+    }
+
+    // Calls visit(child index) for the sub units shown along with a planet
+    template<typename Visit>
+    void ForEachChild(size_t parent, Visit visit) const {
+        for (size_t i = children_begin[parent]; i < children_end[parent]; ++i) {
+            visit(children[i]);
+        }
+    }
+
+    // Captures the units of a star system
+    void Capture(StarSystem *system);
+
+private:
+    void Describe(size_t index);
+
+    std::vector<const Unit *> units;
+    std::vector<QVector> position;
+    std::vector<float> size;
+    std::vector<int> faction;
+    std::vector<unsigned int> flags;
+    std::vector<Track::Type::Value> type;
+    std::vector<float> exploding_progress;
+    std::vector<const Unit *> target;
+    std::vector<const Unit *> locked;
+    std::vector<size_t> children_begin;
+    std::vector<size_t> children_end;
+    std::vector<size_t> children;
+    std::vector<size_t> gravitational;
+    std::vector<size_t> order;
+    std::vector<double> order_key;
+    vsUMap<const Unit *, size_t> index_of;
+};
+
+} // namespace Radar
+
+#endif //VEGA_STRIKE_ENGINE_GFX_RADAR_SENSOR_SNAPSHOT_H
@@ -0,0 +1,112 @@
+/*
+ * sensor_snapshot_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "gfx/radar/sensor_snapshot.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using Radar::SensorSnapshot;
+
+namespace {
+// The snapshot only compares unit pointers, so any distinct addresses will do
+const Unit *FakeUnit(size_t i) {
+    static char storage[20000];
+    return reinterpret_cast<const Unit *>(&storage[i]);
+}
+}
+
+TEST(SensorSnapshot, QueryMatchesBruteForce) {
+    std::mt19937 random(11);
+    std::uniform_real_distribution<double> coordinate(-100000.0, 100000.0);
+    std::uniform_real_distribution<float> size(1.0f, 500.0f);
+    SensorSnapshot snapshot;
+    for (size_t i = 0; i < 5000; ++i) {
+        const QVector position(coordinate(random), coordinate(random) * 0.1, coordinate(random) * 0.1);
+        const unsigned int flags = (i % 7 == 0) ? SensorSnapshot::Flags::Gravitational : SensorSnapshot::Flags::Indexed;
+        snapshot.Add(FakeUnit(i), position, size(random), flags);
+    }
+    snapshot.Finish();
+    ASSERT_EQ(snapshot.Size(), 5000u);
+
+    for (int n = 0; n < 200; ++n) {
+        const QVector centre(coordinate(random), 0, 0);
+        const float range = 20000.0f;
+        std::vector<size_t> expected, found;
+        for (size_t i = 0; i < snapshot.Size(); ++i) {
+            if (snapshot.Has(i, SensorSnapshot::Flags::Indexed) && snapshot.GetDistance(i, centre, 10.0f) < range) {
+                expected.push_back(i);
+            }
+        }
+        snapshot.Query(centre, 10.0f, range, 500.0f, [&](size_t index, float distance) {
+            EXPECT_FLOAT_EQ(distance, snapshot.GetDistance(index, centre, 10.0f));
+            found.push_back(index);
+        });
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+}
+
+TEST(SensorSnapshot, Bookkeeping) {
+    SensorSnapshot snapshot;
+    const size_t ship = snapshot.Add(FakeUnit(0), QVector(10, 0, 0), 5, SensorSnapshot::Flags::Indexed);
+    const size_t planet = snapshot.Add(FakeUnit(1), QVector(0, 0, 0), 1000,
+            SensorSnapshot::Flags::Indexed | SensorSnapshot::Flags::Gravitational);
+    const size_t elevator = snapshot.Add(FakeUnit(2), QVector(0, 1000, 0), 50, SensorSnapshot::Flags::None);
+    snapshot.AddChild(planet, elevator);
+    snapshot.Finish();
+
+    EXPECT_EQ(snapshot.Find(FakeUnit(2)), elevator);
+    EXPECT_EQ(snapshot.Find(FakeUnit(3)), snapshot.Size());
+    EXPECT_EQ(snapshot.GetGravitational(), std::vector<size_t>{planet});
+
+    std::vector<size_t> children;
+    snapshot.ForEachChild(planet, [&children](size_t child) {
+        children.push_back(child);
+    });
+    EXPECT_EQ(children, std::vector<size_t>{elevator});
+    snapshot.ForEachChild(ship, [](size_t) {
+        ADD_FAILURE() << "a ship has no children";
+    });
+
+    // children are only reachable through their parent
+    std::vector<size_t> found;
+    snapshot.Query(QVector(0, 0, 0), 0, 1e6f, 1e4f, [&found](size_t index, float) {
+        found.push_back(index);
+    });
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, (std::vector<size_t>{ship, planet}));
+
+    snapshot.Clear();
+    snapshot.Finish();
+    EXPECT_EQ(snapshot.Size(), 0u);
+    EXPECT_EQ(snapshot.Find(FakeUnit(0)), snapshot.Size());
+}
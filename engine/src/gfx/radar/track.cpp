@@ -33,16 +33,34 @@
 #include "cmd/planet.h"
 #include "cmd/unit_util.h"
 #include "track.h"
+#include "sensor_snapshot.h"
 
 namespace Radar {
 
+namespace {
+
+Track::Relation::Value IdentifyRelation(Unit *player, const Unit *target) {
+    const float relation = player->getRelation(target);
+    if (relation > 0) {
+        return Track::Relation::Friend;
+    }
+
+    if (relation < 0) {
+        return Track::Relation::Enemy;
+    }
+
+    return Track::Relation::Neutral;
+}
+
+} // anonymous namespace
+
 Track::Track(Unit *player, const Unit *target)
         : player(player),
         target(target),
         distance(0.0) {
     position = player->LocalCoordinates(target);
     distance = UnitUtil::getDistance(player, target);
-    type = IdentifyType();
+    Observe();
 }
 
 Track::Track(Unit *player, const Unit *target, const Vector &position)
@@ -50,7 +68,7 @@ Track::Track(Unit *player, const Unit *target, const Vector &position)
         target(target),
         position(position) {
     distance = UnitUtil::getDistance(player, target);
-    type = IdentifyType();
+    Observe();
 }
 
 Track::Track(Unit *player, const Unit *target, const Vector &position, float distance)
@@ -58,7 +76,41 @@ Track::Track(Unit *player, const Unit *target, const Vector &position, float dis
         target(target),
         position(position),
         distance(distance) {
-    type = IdentifyType();
+    Observe();
+}
+
+Track::Track(Unit *player, const SensorSnapshot &snapshot, size_t index)
+        : player(player),
+        target(snapshot.GetUnit(index)),
+        type(snapshot.GetType(index)),
+        size(snapshot.GetSize(index)),
+        explodingProgress(snapshot.GetExplodingProgress(index)),
+        exploding(snapshot.Has(index, SensorSnapshot::Flags::Exploding)),
+        weapons(snapshot.Has(index, SensorSnapshot::Flags::Weapons)),
+        turrets(snapshot.Has(index, SensorSnapshot::Flags::Turrets)),
+        activeECM(snapshot.Has(index, SensorSnapshot::Flags::ECM)),
+        lock(snapshot.GetTarget(index) == player),
+        weaponLock(snapshot.GetLocked(index) == player) {
+    const QVector offset = snapshot.GetPosition(index) - player->Position();
+    position = player->ToLocalCoordinates(offset.Cast());
+    distance = offset.Magnitude() - player->rSize() - size;
+    relation = IdentifyRelation(player, target);
+}
+
+void Track::Observe() {
+    assert(player);
+    assert(target);
+
+    type = IdentifyType(target);
+    size = target->rSize();
+    exploding = target->IsExploding();
+    explodingProgress = exploding ? target->ExplodingProgress() : 0.0f;
+    weapons = (target->getNumMounts() > 0);
+    turrets = !(target->SubUnits.empty());
+    activeECM = (UnitUtil::getECM(target) > 0);
+    lock = (player == target->Target());
+    weaponLock = target->TargetLocked(player);
+    relation = IdentifyRelation(player, target);
 }
 
 const Vector &Track::GetPosition() const {
@@ -74,56 +126,40 @@ Track::Type::Value Track::GetType() const {
 }
 
 float Track::GetSize() const {
-    assert(target);
-
-    return target->rSize();
+    return size;
 }
 
 bool Track::IsExploding() const {
-    assert(target);
-
-    return target->IsExploding();
+    return exploding;
 }
 
 float Track::ExplodingProgress() const {
     assert(IsExploding());
 
-    return target->ExplodingProgress();
+    return explodingProgress;
 }
 
 bool Track::HasWeapons() const {
-    assert(target);
-
-    return (target->getNumMounts() > 0);
+    return weapons;
 }
 
 bool Track::HasTurrets() const {
-    assert(target);
-
-    return !(target->SubUnits.empty());
+    return turrets;
 }
 
 bool Track::HasActiveECM() const {
-    assert(target);
-
-    return (UnitUtil::getECM(target) > 0);
+    return activeECM;
 }
 
 bool Track::HasLock() const {
-    assert(player);
-    assert(target);
-
-    return (player == target->Target());
+    return lock;
 }
 
 bool Track::HasWeaponLock() const {
-    assert(player);
-    assert(target);
-
-    return (target->TargetLocked(player));
+    return weaponLock;
 }
 
-Track::Type::Value Track::IdentifyType() const {
+Track::Type::Value Track::IdentifyType(const Unit *target) {
     assert(target);
 
     switch (target->isUnit()) {
@@ -185,19 +221,7 @@ Track::Type::Value Track::IdentifyType() const {
 }
 
 Track::Relation::Value Track::GetRelation() const {
-    assert(player);
-    assert(target);
-
-    const float relation = player->getRelation(target);
-    if (relation > 0) {
-        return Relation::Friend;
-    }
-
-    if (relation < 0) {
-        return Relation::Enemy;
-    }
-
-    return Relation::Neutral;
+    return relation;
 }
 
 } // namespace Radar
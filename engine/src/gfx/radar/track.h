@@ -27,6 +27,7 @@
 #ifndef VEGA_STRIKE_ENGINE_GFX_RADAR_TRACK_H
 #define VEGA_STRIKE_ENGINE_GFX_RADAR_TRACK_H
 
+#include <cstddef>
 #include "gfx_generic/vec.h"
 
 class Unit;
@@ -35,6 +36,7 @@ struct GFXColor;  // Edit from class to struct as defined in gfxlib_struct.
 namespace Radar {
 
 class Sensor;
+class SensorSnapshot;
 
 // Track is a wrapper for Unit that restricts the available functionality
 // to that which can be detected through the radar.
@@ -94,14 +96,19 @@ public:
     // Determine if track is friend or foe
     Relation::Value GetRelation() const;
 
+    // What kind of object a unit looks like on the radar
+    static Type::Value IdentifyType(const Unit *);
+
 protected:
     // Produced by Sensor::CreateTrack
     friend class Sensor;
     Track(Unit *, const Unit *);
     Track(Unit *, const Unit *, const Vector &);
     Track(Unit *, const Unit *, const Vector &, float);
+    Track(Unit *, const SensorSnapshot &, size_t);
 
-    Type::Value IdentifyType() const;
+    // Reads what the radar shows of the target from the live unit
+    void Observe();
 
 protected:
     Unit *player;
@@ -109,6 +116,16 @@ protected:
     Vector position;
     float distance;
     Type::Value type;
+    // Everything below is read once when the track is made
+    float size;
+    float explodingProgress;
+    bool exploding;
+    bool weapons;
+    bool turrets;
+    bool activeECM;
+    bool lock;
+    bool weaponLock;
+    Relation::Value relation;
 };
 
 } // namespace Radar
@@ -35,6 +35,12 @@
 #include "root_generic/galaxy_xml.h"
 #include "src/universe.h"
 #include "src/vs_logging.h"
+#include "src/configuration/configuration.h"
+#include "gfx/starfield.h"
+
+#include <algorithm>
+#include <random>
+#include <boost/filesystem.hpp>
 
 // See https://github.com/vegastrike/Vega-Strike-Engine-Source/pull/851#discussion_r1589254766
 #if defined(__APPLE__) && defined (__MACH__)
@@ -114,50 +120,9 @@ public:
     }
 };
 
-//bool shouldwedraw
-static void saturate(float &r, float &g, float &b) {
-    static float conemin = XMLSupport::parse_float(vs_config->getVariable("graphics", "starmincolorval", ".3"));
-    static float colorpower = XMLSupport::parse_float(vs_config->getVariable("graphics", "starcolorpower", ".25"));
-    if (r < conemin) {
-        r += conemin;
-    }
-    if (g < conemin) {
-        g += conemin;
-    }
-    if (b < conemin) {
-        b += conemin;
-    }
-    r = std::pow(r, colorpower);
-    g = std::pow(g, colorpower);
-    b = std::pow(b, colorpower);
-}
-
-bool computeStarColor(float &r, float &g, float &b, Vector luminmax, float distance, float maxdistance) {
-    saturate(r, g, b);
-    static float luminscale = XMLSupport::parse_float(vs_config->getVariable("graphics", "starluminscale", ".001"));
-    static float
-            starcoloraverage = XMLSupport::parse_float(vs_config->getVariable("graphics", "starcoloraverage", ".6"));
-    static float starcolorincrement =
-            XMLSupport::parse_float(vs_config->getVariable("graphics", "starcolorincrement", "100"));
-    float dissqr = distance * distance / (maxdistance * maxdistance);
-    float lum = 100 * luminmax.i / (luminmax.k * dissqr);
-    lum = log((double) luminmax.i * 10. / (double) luminmax.j) * luminscale / dissqr;
-    float clamp = starcoloraverage + lum / starcolorincrement;
-    if (clamp > 1) {
-        clamp = 1;
-    }
-    if (lum > clamp) {
-        lum = clamp;
-    }
-    r *= lum;
-    g *= lum;
-    b *= lum;
-    static float starcolorcutoff = XMLSupport::parse_float(vs_config->getVariable("graphics", "starcolorcutoff", ".1"));
-    return lum > starcolorcutoff;
-}
-
 namespace StarSystemGent {
-extern GFXColor getStarColorFromRadius(float radius);
+extern void loadStarColors();
+extern GFXColor getStarColorFromRadius(float radius, const float variation[3]);
 }
 
 StarVlist::StarVlist(float spread) {
@@ -168,181 +133,187 @@ StarVlist::StarVlist(float spread) {
     this->spread = spread;
 }
 
-static GFXColorVertex *AllocVerticesForSystem(std::string our_system_name, float spread, int *num, int repetition) {
+// A star of the galaxy as loaded, before it is placed around a system
+struct GalaxyStar {
+    bool placed = false;
+    float x = 0, y = 0, z = 0;
+    bool has_radius = false;
+    float radius = 0;
+    bool luminous = false;
+    float luminosity = 1;
+};
+
+typedef std::vector<GalaxyStar> GalaxyStars;
+
+// The galaxy's stars, read once on the main thread. Later changes to the
+// galaxy tree, which is not safe to walk off the main thread, do not show
+// in star fields; the stars' places, radii and luminosities never change.
+static std::shared_ptr<const GalaxyStars> GalaxyStarsSnapshot() {
+    static std::shared_ptr<const GalaxyStars> snapshot;
+    if (!snapshot) {
+        std::shared_ptr<GalaxyStars> stars = std::make_shared<GalaxyStars>();
+        stars->reserve(NumStarsInGalaxy());
+        for (StarIter si; !si.Done(); ++si) {
+            GalaxyStar star;
+            star.placed = 3 == sscanf((*si.Get())["xyz"].c_str(), "%f %f %f", &star.x, &star.y, &star.z);
+            std::string radstr = (*si.Get())["sun_radius"];
+            if (radstr.size()) {
+                star.has_radius = true;
+                star.radius = XMLSupport::parse_float(radstr);
+            }
+            star.luminous = 1 == sscanf((*si.Get())["luminosity"].c_str(), "%f", &star.luminosity);
+            if (!star.luminous) {
+                star.luminosity = 1;
+            }
+            stars->push_back(star);
+        }
+        snapshot = stars;
+    }
+    return snapshot;
+}
+
+// Reads the options the field of our_system_name is generated with. A
+// system outside the sectors whose neighbours are drawn at their actual
+// places, or without a luminosity, gets random stars.
+static StarfieldRequest MakeStarfieldRequest(std::string our_system_name,
+        const std::string &seed,
+        float spread,
+        int num,
+        int repetition) {
     static float staroverlap = XMLSupport::parse_float(vs_config->getVariable("graphics", "star_overlap", "1"));
-    float xyzspread = spread * 2 * staroverlap;
     static string allowedSectors = vs_config->getVariable("graphics", "star_allowable_sectors", "Vega Sol");
     if (our_system_name.size() > 0) {
-        string lumi = _Universe->getGalaxyProperty(our_system_name, "luminosity");
-        if (lumi.length() == 0 || strtod(lumi.c_str(), NULL) == 0) {
-            our_system_name = "";
-        } else {
-            string::size_type slash = our_system_name.find("/");
-            if (slash != string::npos) {
-                string sec = our_system_name.substr(0, slash);
-                if (allowedSectors.find(sec) == string::npos) {
-                    our_system_name = "";
-                }
-            } else {
+        string::size_type slash = our_system_name.find("/");
+        if (slash != string::npos) {
+            string sec = our_system_name.substr(0, slash);
+            if (allowedSectors.find(sec) == string::npos) {
                 our_system_name = "";
             }
+        } else {
+            our_system_name = "";
         }
     }
+    StarfieldRequest request;
+    request.system = our_system_name;
+    request.seed = seed;
+    request.spread = spread;
+    request.count = num;
+    request.repetition = repetition;
+    request.overlap = staroverlap;
+    request.color.min_color = XMLSupport::parse_float(vs_config->getVariable("graphics", "starmincolorval", ".3"));
+    request.color.color_power = XMLSupport::parse_float(vs_config->getVariable("graphics", "starcolorpower", ".25"));
+    request.color.lumin_scale = XMLSupport::parse_float(vs_config->getVariable("graphics", "starluminscale", ".001"));
+    request.color.color_average =
+            XMLSupport::parse_float(vs_config->getVariable("graphics", "starcoloraverage", ".6"));
+    request.color.color_increment =
+            XMLSupport::parse_float(vs_config->getVariable("graphics", "starcolorincrement", "100"));
+    request.color.color_cutoff = XMLSupport::parse_float(vs_config->getVariable("graphics", "starcolorcutoff", ".1"));
     if (!our_system_name.empty()) {
-        *num = NumStarsInGalaxy();
+        string lumi = _Universe->getGalaxyProperty(our_system_name, "luminosity");
+        if (lumi.length() == 0 || strtod(lumi.c_str(), NULL) == 0) {
+            request.system = "";
+        } else {
+            //read stars.txt here, the file system is not thread safe
+            StarSystemGent::loadStarColors();
+        }
     }
-    GFXColorVertex *tmpvertex = new GFXColorVertex[(*num) * repetition];
-//    memset( tmpvertex, 0, sizeof (GFXVertex)*(*num)*repetition ); //This is already initialized
-    StarIter si;
-    int starcount = 0;
-    int j = 0;
-    float xcent = 0;
-    float ycent = 0;
-    float zcent = 0;
-    Vector starmin(0, 0, 0);
-    Vector starmax(0, 0, 0);
-    float minlumin = 1;
-    float maxlumin = 1;
-    float maxdistance = -1;
-    float mindistance = -1;
-    if (our_system_name.size() > 0) {
-        sscanf(_Universe->getGalaxyProperty(our_system_name, "xyz").c_str(),
-                "%f %f %f",
-                &xcent,
-                &ycent,
-                &zcent);
-        for (StarIter i; !i.Done(); ++i) {
-            float xx, yy, zz;
-            if (3 == sscanf((*i.Get())["xyz"].c_str(), "%f %f %f", &xx, &yy, &zz)) {
-                xx -= xcent;
-                yy -= ycent;
-                zz -= zcent;
-                if (xx < starmin.i) {
-                    starmin.i = xx;
-                }
-                if (yy < starmin.j) {
-                    starmin.j = yy;
-                }
-                if (zz < starmin.k) {
-                    starmin.k = zz;
-                }
-                if (xx > starmax.i) {
-                    starmax.i = xx;
-                }
-                if (yy > starmax.j) {
-                    starmax.j = yy;
-                }
-                if (zz > starmax.k) {
-                    starmax.k = zz;
-                }
-                float magsqr = xx * xx + yy * yy + zz * zz;
-                if ((maxdistance < 0) || (maxdistance < magsqr)) {
-                    maxdistance = magsqr;
-                }
-                if ((mindistance < 0) || (mindistance > magsqr)) {
-                    mindistance = magsqr;
-                }
-                float lumin;
-                if (1 == sscanf((*i.Get())["luminosity"].c_str(), "%f", &lumin)) {
-                    if (lumin > maxlumin) {
-                        maxlumin = lumin;
-                    }
-                    if (lumin < minlumin) {
-                        if (lumin > 0) {
-                            minlumin = lumin;
-                        }
-                    }
-                }
-            }
+    return request;
+}
+
+// Fills in the catalogue of the galaxy as seen from the system at centre.
+// Runs on a worker while the caller loads textures, so it only reads the
+// snapshot and never the galaxy itself.
+static void GatherCatalog(StarfieldRequest &request,
+        const GalaxyStars &stars,
+        float xcent,
+        float ycent,
+        float zcent) {
+    //the color variation of each star, the same every time for a system
+    std::seed_seq seed(request.system.begin(), request.system.end());
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    request.catalog.reserve(stars.size());
+    for (const GalaxyStar &galaxy_star : stars) {
+        CatalogStar star;
+        if (galaxy_star.placed) {
+            star.placed = true;
+            star.x = galaxy_star.x - xcent;
+            star.y = galaxy_star.y - ycent;
+            star.z = galaxy_star.z - zcent;
         }
+        if (galaxy_star.has_radius) {
+            const float variation[3] = {unit(random), unit(random), unit(random)};
+            GFXColor suncolor(StarSystemGent::getStarColorFromRadius(galaxy_star.radius, variation));
+            star.colored = true;
+            star.r = suncolor.r;
+            star.g = suncolor.g;
+            star.b = suncolor.b;
+        }
+        star.luminous = galaxy_star.luminous;
+        star.luminosity = galaxy_star.luminosity;
+        request.catalog.push_back(star);
     }
-    if (maxdistance < 0) {
-        maxdistance = 0;
-    }
-    if (mindistance < 0) {
-        mindistance = 0;
-    }
-    maxdistance = sqrt(maxdistance);
-    mindistance = sqrt(mindistance);
-    VS_LOG(info, (boost::format("Min (%1$f, %2$f, %3$f) Max(%4$f, %5$f, %6$f) MinLumin %7$f, MaxLumin %8$f")
-            % starmin.i % starmin.j % starmin.k % starmax.i % starmax.j % starmax.k % minlumin % maxlumin));
-    for (int y = 0; y < *num; ++y) {
-        tmpvertex[j + repetition - 1].x = -.5 * xyzspread + rand() * ((float) xyzspread / RAND_MAX);
-        tmpvertex[j + repetition - 1].y = -.5 * xyzspread + rand() * ((float) xyzspread / RAND_MAX);
-        tmpvertex[j + repetition - 1].z = -.5 * xyzspread + rand() * ((float) xyzspread / RAND_MAX);
-        float brightness = .1 + .9 * ((float) rand()) / RAND_MAX;
-        tmpvertex[j + repetition - 1].r = brightness;
-        tmpvertex[j + repetition - 1].g = brightness;
-        tmpvertex[j + repetition - 1].b = brightness;
-        tmpvertex[j + repetition - 1].a = 1;
-        tmpvertex[j + repetition - 1].i = .57735;
-        tmpvertex[j + repetition - 1].j = .57735;
-        tmpvertex[j + repetition - 1].k = .57735;
-        int incj = repetition;
-        if (our_system_name.size() > 0 && !si.Done()) {
-            starcount++;
-            float xorig, yorig, zorig;
-            if (3 == sscanf((*si.Get())["xyz"].c_str(),
-                    "%f %f %f",
-                    &xorig,
-                    &yorig,
-                    &zorig)) {
-                if (xcent != xorig) {
-                    tmpvertex[j + repetition - 1].x = xorig - xcent;
-                }
-                if (ycent != yorig) {
-                    tmpvertex[j + repetition - 1].y = yorig - ycent;
-                }
-                if (zcent != zorig) {
-                    tmpvertex[j + repetition - 1].z = zorig - zcent;
-                }
-            }
-            std::string radstr = (*si.Get())["sun_radius"];
-            if (radstr.size()) {
-                float rad = XMLSupport::parse_float(radstr);
-                GFXColor suncolor(StarSystemGent::getStarColorFromRadius(rad));
-                tmpvertex[j + repetition - 1].r = suncolor.r;
-                tmpvertex[j + repetition - 1].g = suncolor.g;
-                tmpvertex[j + repetition - 1].b = suncolor.b;
-            }
-            float lumin = 1;
-            sscanf((*si.Get())["luminosity"].c_str(), "%f", &lumin);
-
-            float distance = Vector(tmpvertex[j + repetition - 1].x,
-                    tmpvertex[j + repetition - 1].y,
-                    tmpvertex[j + repetition - 1].z).Magnitude();
-            if (!computeStarColor(tmpvertex[j + repetition - 1].r,
-                    tmpvertex[j + repetition - 1].g,
-                    tmpvertex[j + repetition - 1].b,
-                    Vector(lumin, minlumin, maxlumin),
-                    distance, maxdistance)) {
-                incj = 0;
-            }
-            ++si;
+}
+
+static StarfieldCache &Starfields() {
+    static StarfieldCache cache([]() {
+        if (!configuration()->graphics.starfield_disk_cache) {
+            return std::string();
         }
-        for (int LC = repetition - 2; LC >= 0; --LC) {
-            tmpvertex[j + LC].i = tmpvertex[j + repetition - 1].i;
-            tmpvertex[j + LC].j = tmpvertex[j + repetition - 1].j;
-            tmpvertex[j + LC].k = tmpvertex[j + repetition - 1].k;
-            tmpvertex[j + LC].x = tmpvertex[j + repetition - 1].x;             //+spread*.01;
-            tmpvertex[j + LC].y = tmpvertex[j + repetition - 1].y;             //;+spread*.01;
-            tmpvertex[j + LC].z = tmpvertex[j + repetition - 1].z;
-            tmpvertex[j + LC].r = 0;
-            tmpvertex[j + LC].g = 0;
-            tmpvertex[j + LC].b = 0;
-            tmpvertex[j + LC].a = 0;
+        const std::string directory = VSFileSystem::homedir + "/cache/starfields";
+        boost::system::error_code error;
+        boost::filesystem::create_directories(directory, error);
+        if (error) {
+            VS_LOG(warning, (boost::format("Not caching star fields in %1%: %2%") % directory % error.message()));
+            return std::string();
         }
-        j += incj;
+        return directory;
+    }(), 8);
+    return cache;
+}
+
+static StarfieldFuture RequestStarfield(const std::string &our_system_name,
+        const std::string &seed,
+        float spread,
+        int num,
+        int repetition) {
+    StarfieldRequest request = MakeStarfieldRequest(our_system_name, seed, spread, num, repetition);
+    if (request.system.empty()) {
+        return Starfields().Request(request);
     }
-    VS_LOG(info, (boost::format("Read In Star Count %1$d used: %2$d\n") % starcount % (j / 2)));
-    *num = j;
+    float xcent = 0;
+    float ycent = 0;
+    float zcent = 0;
+    sscanf(_Universe->getGalaxyProperty(request.system, "xyz").c_str(),
+            "%f %f %f",
+            &xcent,
+            &ycent,
+            &zcent);
+    std::shared_ptr<const GalaxyStars> stars = GalaxyStarsSnapshot();
+    return Starfields().Request(request, [stars, xcent, ycent, zcent](StarfieldRequest &request) {
+        GatherCatalog(request, *stars, xcent, ycent, zcent);
+    });
+}
+
+static GFXColorVertex *AllocVertices(const StarfieldFuture &starfield, int *num, int repetition) {
+    StarfieldCache::Field field = starfield.get();
+    VS_LOG(info, (boost::format("Star field with %1% stars") % (field->size() / repetition)));
+    *num = static_cast<int>(field->size());
+    GFXColorVertex *tmpvertex = new GFXColorVertex[std::max(*num, 1)];
+    std::copy(field->begin(), field->end(), tmpvertex);
     return tmpvertex;
 }
 
-PointStarVlist::PointStarVlist(int num, float spread, const std::string &sysnam) : StarVlist(spread) {
+StarfieldFuture PointStarVlist::Request(int num, float spread, const std::string &our_system_name,
+        const std::string &seed) {
+    return RequestStarfield(our_system_name, seed, spread, num, 2);
+}
+
+PointStarVlist::PointStarVlist(const StarfieldFuture &field, float spread) : StarVlist(spread) {
     smoothstreak = 0;
     //static bool StarStreaks=XMLSupport::parse_bool(vs_config->getVariable("graphics","star_streaks","false"));
-    GFXColorVertex *tmpvertex = AllocVerticesForSystem(sysnam, this->spread, &num, 2);
+    int num;
+    GFXColorVertex *tmpvertex = AllocVertices(field, &num, 2);
     //if(StarStreaks) {
     vlist = new GFXVertexList(GFXLINE, num, tmpvertex, num, true, 0);
     //}else {
@@ -458,17 +429,25 @@ PointStarVlist::~PointStarVlist() {
     delete nonstretchvlist;
 }
 
-Stars::Stars(int num, float spread) : vlist(NULL), spread(spread) {
+Stars::Stars(const StarfieldFuture &field, float spread) : vlist(NULL), spread(spread) {
     static string starspritetextures = vs_config->getVariable("graphics", "near_stars_sprite_texture", "");
     static float starspritesize =
             XMLSupport::parse_float(vs_config->getVariable("graphics", "near_stars_sprite_size", "2"));
     if (starspritetextures.length() == 0) {
-        vlist = new PointStarVlist((num / STARnumvlist) + 1, spread, "");
+        vlist = new PointStarVlist(field, spread);
     } else {
-        vlist = new SpriteStarVlist((num / STARnumvlist) + 1, spread, "", starspritetextures, starspritesize);
+        vlist = new SpriteStarVlist(field, spread, starspritetextures, starspritesize);
     }
     fade = blend = true;
-    ResetPosition(QVector(0, 0, 0));
+}
+
+StarfieldFuture Stars::Request(int num, float spread, const std::string &seed) {
+    static string starspritetextures = vs_config->getVariable("graphics", "near_stars_sprite_texture", "");
+    if (starspritetextures.length() == 0) {
+        return PointStarVlist::Request((num / STARnumvlist) + 1, spread, "", seed);
+    } else {
+        return SpriteStarVlist::Request((num / STARnumvlist) + 1, spread, "", seed);
+    }
 }
 
 void Stars::SetBlend(bool blendit, bool fadeit) {
@@ -483,7 +462,7 @@ void Stars::Draw() {
         return;
     }
     const QVector cp(_Universe->AccessCamera()->GetPosition());
-    UpdatePosition(cp);
+    const QVector origin(Origin(cp));
     //GFXLightContextAmbient(GFXColor(0,0,0,1));
     GFXColor(1, 1, 1, 1);
     GFXLoadIdentity(MODEL);
@@ -534,16 +513,19 @@ void Stars::Draw() {
         bool stretch = vlist->BeginDrawState(_Universe->AccessCamera()->GetR().Scale(
                         -spread).Cast(), _Universe->AccessCamera()->GetVelocity(),
                 _Universe->AccessCamera()->GetAngularVelocity(), false, false, LC);
-        int i;
-        for (i = 0; i < STARnumvlist; i++) {
-            if (i >= 1) {
-                GFXTranslateModel(pos[i] - pos[i - 1]);
-            } else {
-                GFXTranslateModel(pos[i]);
+        //the same block of stars, around origin and on each side of it
+        GFXTranslateModel(origin - QVector(spread, spread, spread));
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                for (int k = 0; k < 3; k++) {
+                    vlist->Draw(stretch, LC);
+                    GFXTranslateModel(QVector(0, 0, k < 2 ? spread : -2.0 * spread));
+                }
+                GFXTranslateModel(QVector(0, j < 2 ? spread : -2.0 * spread, 0));
             }
-            vlist->Draw(stretch, LC);
+            GFXTranslateModel(QVector(i < 2 ? spread : -2.0 * spread, 0, 0));
         }
-        GFXTranslateModel(-pos[i - 1]);
+        GFXTranslateModel(QVector(spread, spread, spread) - origin);
         vlist->EndDrawState(stretch, LC);
     }
     if (near_stars_alpha) {
@@ -563,84 +545,12 @@ void Stars::Draw() {
     GFXLoadIdentity(MODEL);
 }
 
-static void upd(double &a,
-        double &b,
-        double &c,
-        double &d,
-        double &e,
-        double &f,
-        double &g,
-        double &h,
-        double &i,
-        const double cp,
-        const float spread) {
-    //assert (a==b&&b==c&&c==d&&d==e&&e==f);
-    if (a != b || a != c || a != d || a != e || a != f || !FINITE(a)) {
-        a = b = c = d = e = f = 0;
-    }
-    while (a - cp > 1.5 * spread) {
-        a -= 3 * spread;
-        b -= 3 * spread;
-        c -= 3 * spread;
-        d -= 3 * spread;
-        e -= 3 * spread;
-        f -= 3 * spread;
-        g -= 3 * spread;
-        h -= 3 * spread;
-        i -= 3 * spread;
-    }
-    while (a - cp < -1.5 * spread) {
-        a += 3 * spread;
-        b += 3 * spread;
-        c += 3 * spread;
-        d += 3 * spread;
-        e += 3 * spread;
-        f += 3 * spread;
-        g += 3 * spread;
-        h += 3 * spread;
-        i += 3 * spread;
-    }
-}
-
-void Stars::ResetPosition(const QVector &cent) {
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            for (int k = 0; k < 3; k++) {
-                const double spread_temp = spread;
-                pos[i * 9 + j * 3 + k].Set((i - 1) * spread_temp, (j - 1) * spread_temp, (k - 1) * spread_temp);
-                pos[i * 9 + j * 3 + k] += cent;
-            }
-        }
-    }
-}
-
-void Stars::UpdatePosition(const QVector &cp) {
-    if (fabs(pos[0].i - cp.i) > 3 * spread || fabs(pos[0].j - cp.j) > 3 * spread
-            || fabs(pos[0].k - cp.k) > 3 * spread) {
-        ResetPosition(cp);
-        return;
-    }
-    upd(pos[0].i, pos[1].i, pos[2].i, pos[3].i, pos[4].i, pos[5].i, pos[6].i, pos[7].i, pos[8].i, cp.i, spread);
-    upd(pos[9].i, pos[10].i, pos[11].i, pos[12].i, pos[13].i, pos[14].i, pos[15].i, pos[16].i, pos[17].i, cp.i, spread);
-    upd(pos[18].i,
-            pos[19].i,
-            pos[20].i,
-            pos[21].i,
-            pos[22].i,
-            pos[23].i,
-            pos[24].i,
-            pos[25].i,
-            pos[26].i,
-            cp.i,
-            spread);
-
-    upd(pos[0].j, pos[1].j, pos[2].j, pos[9].j, pos[10].j, pos[11].j, pos[18].j, pos[19].j, pos[20].j, cp.j, spread);
-    upd(pos[3].j, pos[4].j, pos[5].j, pos[12].j, pos[13].j, pos[14].j, pos[21].j, pos[22].j, pos[23].j, cp.j, spread);
-    upd(pos[6].j, pos[7].j, pos[8].j, pos[15].j, pos[16].j, pos[17].j, pos[24].j, pos[25].j, pos[26].j, cp.j, spread);
-
-    upd(pos[0].k, pos[3].k, pos[6].k, pos[9].k, pos[12].k, pos[15].k, pos[18].k, pos[21].k, pos[24].k, cp.k, spread);
-    upd(pos[1].k, pos[4].k, pos[7].k, pos[10].k, pos[13].k, pos[16].k, pos[19].k, pos[22].k, pos[25].k, cp.k, spread);
-    upd(pos[2].k, pos[5].k, pos[8].k, pos[11].k, pos[14].k, pos[17].k, pos[20].k, pos[23].k, pos[26].k, cp.k, spread);
+QVector Stars::Origin(const QVector &cp) const {
+    //the camera is always within the middle block
+    const double spread_temp = spread;
+    return QVector(spread_temp * std::floor(cp.i / spread_temp + .5),
+            spread_temp * std::floor(cp.j / spread_temp + .5),
+            spread_temp * std::floor(cp.k / spread_temp + .5));
 }
 
 Stars::~Stars() {
@@ -651,7 +561,7 @@ static Vector GetConstVertex(const GFXColorVertex &c) {
     return Vector(c.x, c.y, c.z);
 }
 
-SpriteStarVlist::SpriteStarVlist(int num, float spread, std::string sysnam, std::string texturenames,
+SpriteStarVlist::SpriteStarVlist(const StarfieldFuture &field, float spread, std::string texturenames,
         float size) : StarVlist(spread) {
     int curtexture = 0;
     vector<AnimatedTexture *> animations;
@@ -689,8 +599,9 @@ SpriteStarVlist::SpriteStarVlist(int num, float spread, std::string sysnam, std:
             decal[curtexture] = new Texture(texturename.c_str());
         }
     }
-    int numVerticesPer = near_stars_alpha ? 4 : 12;
-    GFXColorVertex *tmpvertex = AllocVerticesForSystem(sysnam, this->spread, &num, numVerticesPer);
+    int numVerticesPer = SpriteVerticesPerStar();
+    int num;
+    GFXColorVertex *tmpvertex = AllocVertices(field, &num, numVerticesPer);
     for (int LC = 0; LC < num; LC += numVerticesPer) {
         int LAST = LC + numVerticesPer - 1;
         for (int i = LC; i <= LAST; ++i) {
@@ -777,6 +688,17 @@ SpriteStarVlist::SpriteStarVlist(int num, float spread, std::string sysnam, std:
     delete[] tmpvertex;
 }
 
+int SpriteStarVlist::SpriteVerticesPerStar() {
+    static bool
+            near_stars_alpha = XMLSupport::parse_bool(vs_config->getVariable("graphics", "near_stars_alpha", "false"));
+    return near_stars_alpha ? 4 : 12;
+}
+
+StarfieldFuture SpriteStarVlist::Request(int num, float spread, const std::string &our_system_name,
+        const std::string &seed) {
+    return RequestStarfield(our_system_name, seed, spread, num, SpriteVerticesPerStar());
+}
+
 int SpriteStarVlist::NumTextures() {
     return NUM_ACTIVE_ANIMATIONS;
 }
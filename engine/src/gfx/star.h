@@ -28,6 +28,7 @@
 #include "src/gfxlib.h"
 
 #include "src/gfxlib_struct.h"
+#include "gfx/starfield.h"
 const int STARnumvlist = 27;
 #include <string>
 
@@ -80,8 +81,11 @@ class PointStarVlist : public StarVlist {
     GFXVertexList *vlist;
     GFXVertexList *nonstretchvlist;
 public:
-    PointStarVlist(int num, float spread, const std::string &our_system_name);
+    PointStarVlist(const StarfieldFuture &field, float spread);
     ~PointStarVlist();
+    ///Starts generating num stars around our_system_name, or random ones picked by seed, in the background
+    static StarfieldFuture Request(int num, float spread, const std::string &our_system_name,
+            const std::string &seed);
     bool BeginDrawState(const QVector &center,
             const Vector &vel,
             const Vector &angular_vel,
@@ -98,8 +102,12 @@ class SpriteStarVlist : public StarVlist {
     GFXVertexList *vlist[NUM_ACTIVE_ANIMATIONS];
     class Texture *decal[NUM_ACTIVE_ANIMATIONS];
 public:
-    SpriteStarVlist(int num, float spread, std::string our_system_name, std::string texturename, float size);
+    SpriteStarVlist(const StarfieldFuture &field, float spread, std::string texturename, float size);
     ~SpriteStarVlist();
+    ///Starts generating num stars around our_system_name, or random ones picked by seed, in the background
+    static StarfieldFuture Request(int num, float spread, const std::string &our_system_name,
+            const std::string &seed);
+    static int SpriteVerticesPerStar();
     int NumTextures();
     bool BeginDrawState(const QVector &center,
             const Vector &vel,
@@ -114,14 +122,15 @@ public:
 class Stars {
 private:
     StarVlist *vlist;
-    QVector pos[STARnumvlist];
     float spread;
     bool blend;
     bool fade;
-    void ResetPosition(const QVector &cent);
-    void UpdatePosition(const QVector &cp);
+    ///Where the middle one of the STARnumvlist blocks of stars goes for a camera at cp
+    QVector Origin(const QVector &cp) const;
 public:
-    Stars(int num, float spread);
+    Stars(const StarfieldFuture &field, float spread);
+    ///Starts generating num random stars in the background, the same ones for the same seed
+    static StarfieldFuture Request(int num, float spread, const std::string &seed);
     void SetBlend(bool blendit, bool fadeit);
     void Draw();
     ~Stars();
@@ -0,0 +1,298 @@
+/*
+ * starfield.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gfx/starfield.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "vs_thread_pool.h"
+
+namespace {
+
+// FNV-1a, to seed the generator and name cache files the same on every platform
+uint64_t HashKey(const std::string &key) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void Saturate(const StarColorOptions &options, float &r, float &g, float &b) {
+    if (r < options.min_color) {
+        r += options.min_color;
+    }
+    if (g < options.min_color) {
+        g += options.min_color;
+    }
+    if (b < options.min_color) {
+        b += options.min_color;
+    }
+    r = std::pow(r, options.color_power);
+    g = std::pow(g, options.color_power);
+    b = std::pow(b, options.color_power);
+}
+
+// Returns whether the star is bright enough to be drawn at all
+bool ComputeStarColor(const StarColorOptions &options,
+        float &r,
+        float &g,
+        float &b,
+        float lumin,
+        float minlumin,
+        float distance,
+        float maxdistance) {
+    Saturate(options, r, g, b);
+    float dissqr = distance * distance / (maxdistance * maxdistance);
+    float lum = log((double) lumin * 10. / (double) minlumin) * options.lumin_scale / dissqr;
+    float clamp = options.color_average + lum / options.color_increment;
+    if (clamp > 1) {
+        clamp = 1;
+    }
+    if (lum > clamp) {
+        lum = clamp;
+    }
+    r *= lum;
+    g *= lum;
+    b *= lum;
+    return lum > options.color_cutoff;
+}
+
+const char kCacheMagic[8] = {'V', 'S', 'S', 'T', 'A', 'R', 'F', '1'};
+
+std::string CachePath(const std::string &directory, const std::string &key) {
+    std::ostringstream name;
+    name << directory << "/" << std::hex << HashKey(key) << ".stars";
+    return name.str();
+}
+
+bool ReadCached(const std::string &path, const std::string &key, StarfieldVertices &vertices) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    char magic[sizeof(kCacheMagic)];
+    uint32_t vertex_size = 0;
+    uint32_t key_size = 0;
+    uint32_t count = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char *>(&vertex_size), sizeof(vertex_size));
+    in.read(reinterpret_cast<char *>(&key_size), sizeof(key_size));
+    if (!in || memcmp(magic, kCacheMagic, sizeof(magic)) != 0 || vertex_size != sizeof(GFXColorVertex)
+            || key_size != key.size()) {
+        return false;
+    }
+    std::string stored_key(key_size, '\0');
+    in.read(&stored_key[0], key_size);
+    in.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!in || stored_key != key) {
+        return false;
+    }
+    vertices.resize(count);
+    in.read(reinterpret_cast<char *>(vertices.data()), static_cast<std::streamsize>(count) * sizeof(GFXColorVertex));
+    return static_cast<bool>(in);
+}
+
+void WriteCached(const std::string &path, const std::string &key, const StarfieldVertices &vertices) {
+    // written aside and renamed, so that a crash never leaves half a file behind
+    const std::string partial = path + ".part";
+    {
+        std::ofstream out(partial.c_str(), std::ios::binary | std::ios::trunc);
+        const uint32_t vertex_size = sizeof(GFXColorVertex);
+        const uint32_t key_size = static_cast<uint32_t>(key.size());
+        const uint32_t count = static_cast<uint32_t>(vertices.size());
+        out.write(kCacheMagic, sizeof(kCacheMagic));
+        out.write(reinterpret_cast<const char *>(&vertex_size), sizeof(vertex_size));
+        out.write(reinterpret_cast<const char *>(&key_size), sizeof(key_size));
+        out.write(key.data(), key_size);
+        out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char *>(vertices.data()),
+                static_cast<std::streamsize>(count) * sizeof(GFXColorVertex));
+        if (!out) {
+            return;
+        }
+    }
+    std::rename(partial.c_str(), path.c_str());
+}
+
+} // namespace
+
+std::string StarfieldRequest::Key() const {
+    std::ostringstream key;
+    key.precision(9);
+    key << system << '|' << seed << '|' << spread << '|' << (system.empty() ? count : static_cast<int>(catalog.size())) << '|'
+            << repetition << '|' << overlap << '|' << color.min_color << ' ' << color.color_power << ' '
+            << color.lumin_scale << ' ' << color.color_average << ' ' << color.color_increment << ' '
+            << color.color_cutoff;
+    if (!catalog.empty()) {
+        // a changed galaxy makes another field
+        std::string bytes;
+        for (const CatalogStar &star : catalog) {
+            const float values[] = {star.x, star.y, star.z, star.r, star.g, star.b, star.luminosity};
+            bytes.append(reinterpret_cast<const char *>(values), sizeof(values));
+            bytes += static_cast<char>(star.placed + 2 * star.colored + 4 * star.luminous);
+        }
+        key << '|' << std::hex << HashKey(bytes);
+    }
+    return key.str();
+}
+
+void GenerateStarfield(const StarfieldRequest &request, StarfieldVertices &vertices) {
+    const float xyzspread = request.spread * 2 * request.overlap;
+    const bool named = !request.system.empty();
+    const int num = named ? static_cast<int>(request.catalog.size()) : request.count;
+    const int repetition = request.repetition;
+
+    float minlumin = 1;
+    float maxdistance = -1;
+    for (const CatalogStar &star : request.catalog) {
+        if (star.placed) {
+            const float magsqr = star.x * star.x + star.y * star.y + star.z * star.z;
+            if ((maxdistance < 0) || (maxdistance < magsqr)) {
+                maxdistance = magsqr;
+            }
+            if (star.luminous && star.luminosity < minlumin && star.luminosity > 0) {
+                minlumin = star.luminosity;
+            }
+        }
+    }
+    if (maxdistance < 0) {
+        maxdistance = 0;
+    }
+    maxdistance = sqrt(maxdistance);
+
+    std::mt19937 random(static_cast<std::mt19937::result_type>(HashKey(request.Key())));
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    vertices.assign(static_cast<size_t>(std::max(num, 0)) * repetition, GFXColorVertex());
+    int j = 0;
+    for (int y = 0; y < num; ++y) {
+        GFXColorVertex &star = vertices[j + repetition - 1];
+        star.x = -.5 * xyzspread + unit(random) * xyzspread;
+        star.y = -.5 * xyzspread + unit(random) * xyzspread;
+        star.z = -.5 * xyzspread + unit(random) * xyzspread;
+        float brightness = .1 + .9 * unit(random);
+        star.r = brightness;
+        star.g = brightness;
+        star.b = brightness;
+        star.a = 1;
+        star.i = .57735;
+        star.j = .57735;
+        star.k = .57735;
+        int incj = repetition;
+        if (named) {
+            const CatalogStar &catalogued = request.catalog[y];
+            if (catalogued.placed) {
+                // a coordinate equal to that of the system keeps its random value
+                if (catalogued.x != 0) {
+                    star.x = catalogued.x;
+                }
+                if (catalogued.y != 0) {
+                    star.y = catalogued.y;
+                }
+                if (catalogued.z != 0) {
+                    star.z = catalogued.z;
+                }
+            }
+            if (catalogued.colored) {
+                star.r = catalogued.r;
+                star.g = catalogued.g;
+                star.b = catalogued.b;
+            }
+            const float distance = sqrt(star.x * star.x + star.y * star.y + star.z * star.z);
+            if (!ComputeStarColor(request.color, star.r, star.g, star.b, catalogued.luminosity, minlumin, distance,
+                    maxdistance)) {
+                incj = 0;
+            }
+        }
+        for (int LC = repetition - 2; LC >= 0; --LC) {
+            GFXColorVertex &copy = vertices[j + LC];
+            copy.i = star.i;
+            copy.j = star.j;
+            copy.k = star.k;
+            copy.x = star.x;
+            copy.y = star.y;
+            copy.z = star.z;
+            copy.r = 0;
+            copy.g = 0;
+            copy.b = 0;
+            copy.a = 0;
+        }
+        j += incj;
+    }
+    vertices.resize(j);
+}
+
+StarfieldCache::StarfieldCache(const std::string &disk_directory, size_t max_fields)
+        : disk_directory(disk_directory),
+        max_fields(std::max<size_t>(max_fields, 1)),
+        generated(std::make_shared<std::atomic<int> >(0)) {
+}
+
+std::shared_future<StarfieldCache::Field> StarfieldCache::Request(const StarfieldRequest &request,
+        std::function<void(StarfieldRequest &)> gather) {
+    const std::string key = request.Key();
+    auto found = fields.find(key);
+    if (found != fields.end()) {
+        return found->second;
+    }
+    const std::string directory = disk_directory;
+    std::shared_ptr<std::atomic<int> > counter = generated;
+    std::shared_future<Field> field = VegaStrike::SubmitWork([request, gather, directory, counter]() -> Field {
+        StarfieldRequest complete = request;
+        if (gather) {
+            gather(complete);
+        }
+        const std::string key = complete.Key();
+        const std::string path = directory.empty() ? std::string() : CachePath(directory, key);
+        std::shared_ptr<StarfieldVertices> vertices = std::make_shared<StarfieldVertices>();
+        if (!path.empty() && ReadCached(path, key, *vertices)) {
+            return vertices;
+        }
+        GenerateStarfield(complete, *vertices);
+        ++*counter;
+        if (!path.empty()) {
+            WriteCached(path, key, *vertices);
+        }
+        return vertices;
+    }).share();
+    fields[key] = field;
+    order.push_back(key);
+    if (order.size() > max_fields) {
+        // a job still running keeps its own copy of the future
+        fields.erase(order.front());
+        order.pop_front();
+    }
+    return field;
+}
@@ -0,0 +1,123 @@
+/*
+ * starfield.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_STARFIELD_H
+#define VEGA_STRIKE_ENGINE_GFX_STARFIELD_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/gfxlib_struct.h"
+
+// A star of the galaxy catalogue, as seen from the system a field is made for
+struct CatalogStar {
+    // false if the catalogue has no usable coordinates for it
+    bool placed = false;
+    float x = 0, y = 0, z = 0;
+    // false if it has no sun radius to take the color from
+    bool colored = false;
+    float r = 0, g = 0, b = 0;
+    // false if it has no usable luminosity; luminosity is 1 then
+    bool luminous = false;
+    float luminosity = 1;
+};
+
+// The graphics options that shape star colors
+struct StarColorOptions {
+    float min_color = .3f;
+    float color_power = .25f;
+    float lumin_scale = .001f;
+    float color_average = .6f;
+    float color_increment = 100.f;
+    float color_cutoff = .1f;
+};
+
+typedef std::vector<GFXColorVertex> StarfieldVertices;
+typedef std::shared_future<std::shared_ptr<const StarfieldVertices> > StarfieldFuture;
+
+// Everything a star field is generated from. The options are read on the
+// main thread; the catalogue may be filled in on the worker, see
+// StarfieldCache::Request. Generating from it only needs this.
+struct StarfieldRequest {
+    // empty for a field of random stars
+    std::string system;
+    // tells the random stars of one system from those of another
+    std::string seed;
+    float spread = 0;
+    // random stars to make; ignored when there is a catalogue
+    int count = 0;
+    // vertices per star, the star itself being the last of them
+    int repetition = 1;
+    float overlap = 1;
+    StarColorOptions color;
+    std::vector<CatalogStar> catalog;
+
+    // Identifies the generated field: same key, same vertices
+    std::string Key() const;
+};
+
+// Makes the vertices of a star field. Random stars come from a generator
+// seeded from the key, so a request always gives the same field.
+void GenerateStarfield(const StarfieldRequest &request, StarfieldVertices &vertices);
+
+// The last few star fields asked for, by key, optionally also kept on disk
+// across runs. Fields are generated on the worker pool; ask for one as early
+// as possible and only wait for it when the vertices are needed.
+class StarfieldCache {
+public:
+    typedef std::shared_ptr<const StarfieldVertices> Field;
+
+    // disk_directory may be empty, to keep fields in memory only
+    StarfieldCache(const std::string &disk_directory, size_t max_fields);
+
+    // gather, if given, completes the request on the worker before anything else, so that slow
+    // lookups such as the galaxy catalogue stay off the calling thread. Fields are told apart in
+    // memory by the key of the request as given, and on disk by that of the completed request
+    std::shared_future<Field> Request(const StarfieldRequest &request,
+            std::function<void(StarfieldRequest &)> gather = nullptr);
+
+    // The number of fields actually generated, not found in memory or on disk
+    int Generated() const {
+        return generated->load();
+    }
+
+private:
+    std::string disk_directory;
+    size_t max_fields;
+    std::map<std::string, std::shared_future<Field> > fields;
+    std::deque<std::string> order;
+    std::shared_ptr<std::atomic<int> > generated;
+};
+
+#endif //VEGA_STRIKE_ENGINE_GFX_STARFIELD_H
@@ -0,0 +1,218 @@
+/*
+ * particle_streams_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "gfx/particle_streams.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+// The array of structs ParticleTrail used to keep, updated the way it was.
+// It steps with a float displacement, the streams with a double one, hence
+// the small tolerance on positions.
+struct ReferenceParticle {
+    QVector location;
+    Vector velocity;
+    GFXColor color;
+    float size;
+};
+
+void referenceUpdate(std::vector<ReferenceParticle> &particles, double elapsed, float fade, float min_alpha) {
+    for (auto &particle : particles) {
+        particle.location += particle.velocity * elapsed;
+        particle.color.a = std::max(0.0f, particle.color.a - fade * static_cast<float>(elapsed));
+    }
+    particles.erase(std::stable_partition(particles.begin(), particles.end(), [min_alpha](const ReferenceParticle &p) {
+        return p.color.a > min_alpha;
+    }), particles.end());
+}
+
+std::vector<ReferenceParticle> makeParticles(size_t count, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> position(-5000.0, 5000.0);
+    std::uniform_real_distribution<float> velocity(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<ReferenceParticle> particles(count);
+    for (auto &particle : particles) {
+        particle.location = QVector(position(rng), position(rng), position(rng));
+        particle.velocity = Vector(velocity(rng), velocity(rng), velocity(rng));
+        particle.color = GFXColor(unit(rng), unit(rng), unit(rng), unit(rng));
+        particle.size = 1.0f + 4.0f * unit(rng);
+    }
+    return particles;
+}
+
+void fill(ParticleStreams &streams, const std::vector<ReferenceParticle> &particles) {
+    for (const auto &particle : particles) {
+        streams.Add(particle.location, particle.velocity, particle.color, particle.size);
+    }
+}
+
+bool isBackToFront(ParticleStreams &streams, const QVector &camera, const std::vector<unsigned int> &order) {
+    if (order.size() != streams.size()) {
+        return false;
+    }
+    std::vector<bool> seen(order.size());
+    double previous = HUGE_VAL;
+    for (unsigned int index : order) {
+        if (index >= order.size() || seen[index]) {
+            return false;
+        }
+        seen[index] = true;
+        const double distance = static_cast<float>((streams.Location(index) - camera).MagnitudeSquared());
+        if (distance > previous) {
+            return false;
+        }
+        previous = distance;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(ParticleStreams, MatchesArrayOfStructs) {
+    std::vector<ReferenceParticle> reference = makeParticles(2000, 1);
+    ParticleStreams streams;
+    fill(streams, reference);
+
+    for (int frame = 0; frame < 30; ++frame) {
+        referenceUpdate(reference, 0.05, 0.7f, 0.1f);
+        streams.Integrate(0.05, 0.7f, false);
+        streams.Compact(0.1f);
+
+        ASSERT_EQ(reference.size(), streams.size());
+        for (size_t i = 0; i < reference.size(); ++i) {
+            EXPECT_NEAR(0.0, (streams.Location(i) - reference[i].location).Magnitude(), 1e-4);
+            EXPECT_EQ(reference[i].color, streams.Color(i));
+            EXPECT_EQ(reference[i].size, streams.Size(i));
+        }
+    }
+    EXPECT_LT(streams.size(), 2000u);
+}
+
+TEST(ParticleStreams, FadeColorStopsAtZero) {
+    ParticleStreams streams;
+    streams.Add(QVector(0, 0, 0), Vector(1, 2, 3), GFXColor(0.1f, 0.5f, 1.0f, 1.0f), 1.0f);
+    streams.Integrate(1.0, 0.3f, true);
+    EXPECT_EQ(QVector(1, 2, 3), streams.Location(0));
+    const GFXColor color = streams.Color(0);
+    EXPECT_EQ(0.0f, color.r);
+    EXPECT_FLOAT_EQ(0.2f, color.g);
+    EXPECT_FLOAT_EQ(0.7f, color.b);
+    EXPECT_FLOAT_EQ(0.7f, color.a);
+}
+
+TEST(ParticleStreams, DepthOrderFollowsMovesAndRemovals) {
+    ParticleStreams streams;
+    fill(streams, makeParticles(3000, 2));
+    QVector camera(0, 0, 0);
+    ASSERT_TRUE(isBackToFront(streams, camera, streams.DepthOrder(camera)));
+
+    std::vector<ReferenceParticle> extra = makeParticles(200, 3);
+    for (int frame = 0; frame < 20; ++frame) {
+        streams.Integrate(0.02, 0.5f, false);
+        streams.Compact(0.05f);
+        streams.Add(extra[frame].location, extra[frame].velocity, extra[frame].color, extra[frame].size);
+        streams.Set(frame, extra[100 + frame].location, extra[100 + frame].velocity, extra[100 + frame].color, 1.0f);
+        camera += QVector(10, -5, 2);
+        ASSERT_TRUE(isBackToFront(streams, camera, streams.DepthOrder(camera))) << "frame " << frame;
+    }
+
+    // a jump across the system falls back to a full sort
+    camera = QVector(1e6, 1e6, 1e6);
+    EXPECT_TRUE(isBackToFront(streams, camera, streams.DepthOrder(camera)));
+}
+
+TEST(ParticleStreams, QuadVertices) {
+    ParticleStreams streams;
+    streams.Add(QVector(10, 20, 30), Vector(0, 0, 0), GFXColor(1, 1, 1, 1), 2.0f);
+    std::vector<float> vertices;
+    streams.WriteQuads(QVector(10, 20, 29), 50.0f, 1.0f, vertices);
+    ASSERT_EQ(static_cast<size_t>(ParticleStreams::kVerticesPerQuad * ParticleStreams::kFloatsPerQuadVertex),
+            vertices.size());
+    // first vertex: camera relative position offset by the size, full color, texture origin
+    const std::vector<float> first(vertices.begin(), vertices.begin() + ParticleStreams::kFloatsPerQuadVertex);
+    EXPECT_EQ((std::vector<float>{2, 2, 1, 1, 1, 1, 1, 0, 0}), first);
+
+    streams.WritePoints(QVector(0, 0, 0), 50.0f, 1.0f, vertices);
+    EXPECT_EQ((std::vector<float>{10, 20, 30, 1, 1, 1, 1}), vertices);
+}
+
+TEST(ParticleStreams, Benchmark100k) {
+    const size_t count = 100000;
+    const int frames = 20;
+    const std::vector<ReferenceParticle> particles = makeParticles(count, 4);
+    QVector camera(0, 0, 0);
+
+    // the previous per frame work: update, erase the dead, sort everything
+    std::vector<ReferenceParticle> reference = particles;
+    std::vector<float> distances;
+    std::vector<unsigned int> order;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        camera += QVector(1, 1, 1);
+        distances.clear();
+        for (const auto &particle : reference) {
+            distances.push_back((camera - particle.location).MagnitudeSquared());
+        }
+        order.resize(reference.size());
+        for (unsigned int i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&distances](unsigned int lhs, unsigned int rhs) {
+            return distances[lhs] > distances[rhs];
+        });
+        referenceUpdate(reference, 0.01, 0.2f, 0.01f);
+    }
+    const std::chrono::duration<double, std::milli> reference_time = std::chrono::steady_clock::now() - start;
+
+    ParticleStreams streams;
+    fill(streams, particles);
+    camera = QVector(0, 0, 0);
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        camera += QVector(1, 1, 1);
+        streams.DepthOrder(camera);
+        streams.Integrate(0.01, 0.2f, false);
+        streams.Compact(0.01f);
+    }
+    const std::chrono::duration<double, std::milli> streams_time = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(reference.size(), streams.size());
+    EXPECT_TRUE(isBackToFront(streams, camera, streams.DepthOrder(camera)));
+    std::cout << count << " particles, " << frames << " frames: "
+              << reference_time.count() / frames << " ms per frame sorting an array of structs, "
+              << streams_time.count() / frames << " ms per frame with the streams" << std::endl;
+}
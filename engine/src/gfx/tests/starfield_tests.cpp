@@ -0,0 +1,190 @@
+/*
+ * starfield_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "gfx/starfield.h"
+
+#include <atomic>
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace {
+
+StarfieldRequest randomRequest(int count, int repetition) {
+    StarfieldRequest request;
+    request.spread = 200;
+    request.count = count;
+    request.repetition = repetition;
+    return request;
+}
+
+bool sameVertices(const StarfieldVertices &a, const StarfieldVertices &b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(GFXColorVertex)) == 0;
+}
+
+std::string scratchDirectory() {
+    boost::filesystem::path path = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("starfield-%%%%-%%%%");
+    boost::filesystem::create_directories(path);
+    return path.string();
+}
+
+} // namespace
+
+TEST(Starfield, RandomFieldIsDeterministic) {
+    StarfieldVertices first;
+    StarfieldVertices second;
+    GenerateStarfield(randomRequest(500, 2), first);
+    GenerateStarfield(randomRequest(500, 2), second);
+    ASSERT_EQ(first.size(), 1000u);
+    EXPECT_TRUE(sameVertices(first, second));
+
+    StarfieldVertices other;
+    GenerateStarfield(randomRequest(501, 2), other);
+    EXPECT_FALSE(std::memcmp(first.data(), other.data(), first.size() * sizeof(GFXColorVertex)) == 0);
+}
+
+TEST(Starfield, SeedPicksTheRandomField) {
+    StarfieldRequest sol = randomRequest(500, 2);
+    sol.seed = "Sol/Sol";
+    StarfieldRequest vega = randomRequest(500, 2);
+    vega.seed = "Vega/Vega";
+    StarfieldVertices first;
+    StarfieldVertices again;
+    StarfieldVertices other;
+    GenerateStarfield(sol, first);
+    GenerateStarfield(sol, again);
+    GenerateStarfield(vega, other);
+    EXPECT_TRUE(sameVertices(first, again));
+    ASSERT_EQ(first.size(), other.size());
+    EXPECT_FALSE(sameVertices(first, other));
+}
+
+TEST(Starfield, RandomStarsStayWithinSpread) {
+    StarfieldVertices vertices;
+    const StarfieldRequest request = randomRequest(1000, 2);
+    GenerateStarfield(request, vertices);
+    const float half = request.spread * request.overlap;
+    for (size_t i = 0; i < vertices.size(); i += 2) {
+        const GFXColorVertex &star = vertices[i + 1];
+        EXPECT_LE(std::fabs(star.x), half);
+        EXPECT_LE(std::fabs(star.y), half);
+        EXPECT_LE(std::fabs(star.z), half);
+        EXPECT_GE(star.r, .1f);
+        EXPECT_EQ(star.a, 1.f);
+        // the leading vertices are the transparent tail at the same place
+        EXPECT_EQ(vertices[i].x, star.x);
+        EXPECT_EQ(vertices[i].a, 0.f);
+    }
+}
+
+TEST(Starfield, CatalogStarsArePlacedAndDimOnesCulled) {
+    StarfieldRequest request = randomRequest(0, 2);
+    request.system = "Sol/Sol";
+    CatalogStar near_star;
+    near_star.placed = true;
+    near_star.x = 10;
+    near_star.y = -2;
+    near_star.z = 3;
+    near_star.colored = true;
+    near_star.r = near_star.g = near_star.b = 1;
+    near_star.luminous = true;
+    near_star.luminosity = 1000;
+    CatalogStar far_star = near_star;
+    far_star.x = 1000;
+    far_star.luminosity = 1;
+    request.catalog.push_back(near_star);
+    request.catalog.push_back(far_star);
+
+    StarfieldVertices vertices;
+    GenerateStarfield(request, vertices);
+    ASSERT_EQ(vertices.size(), 2u);
+    EXPECT_EQ(vertices[1].x, 10.f);
+    EXPECT_EQ(vertices[1].y, -2.f);
+    EXPECT_EQ(vertices[1].z, 3.f);
+    EXPECT_GT(vertices[1].r, request.color.color_cutoff);
+}
+
+TEST(Starfield, CacheGeneratesEachFieldOnce) {
+    StarfieldCache cache("", 2);
+    StarfieldCache::Field first = cache.Request(randomRequest(100, 2)).get();
+    StarfieldCache::Field again = cache.Request(randomRequest(100, 2)).get();
+    EXPECT_EQ(first.get(), again.get());
+    EXPECT_EQ(cache.Generated(), 1);
+
+    cache.Request(randomRequest(101, 2)).get();
+    cache.Request(randomRequest(102, 2)).get();
+    EXPECT_EQ(cache.Generated(), 3);
+    // the first one was evicted to keep two fields
+    cache.Request(randomRequest(100, 2)).get();
+    EXPECT_EQ(cache.Generated(), 4);
+}
+
+TEST(Starfield, DiskCacheSurvivesTheMemoryCache) {
+    const std::string directory = scratchDirectory();
+    StarfieldCache::Field generated;
+    {
+        StarfieldCache cold(directory, 8);
+        generated = cold.Request(randomRequest(300, 4)).get();
+        EXPECT_EQ(cold.Generated(), 1);
+    }
+    StarfieldCache warm(directory, 8);
+    StarfieldCache::Field loaded = warm.Request(randomRequest(300, 4)).get();
+    EXPECT_EQ(warm.Generated(), 0);
+    EXPECT_TRUE(sameVertices(*generated, *loaded));
+    boost::filesystem::remove_all(directory);
+}
+
+TEST(Starfield, CacheGathersOnTheWorkerOnce) {
+    StarfieldCache cache("", 8);
+    std::atomic<int> gathered(0);
+    auto gather = [&gathered](StarfieldRequest &request) {
+        ++gathered;
+        CatalogStar star;
+        star.placed = true;
+        star.x = 10;
+        star.luminous = true;
+        star.luminosity = 1000;
+        request.catalog.push_back(star);
+        // far and dim, so culled
+        star.x = 1000;
+        star.luminosity = 1;
+        request.catalog.push_back(star);
+    };
+    StarfieldRequest request = randomRequest(0, 2);
+    request.system = "Sol/Sol";
+    StarfieldCache::Field first = cache.Request(request, gather).get();
+    StarfieldCache::Field again = cache.Request(request, gather).get();
+    EXPECT_EQ(gathered.load(), 1);
+    EXPECT_EQ(first.get(), again.get());
+    ASSERT_EQ(first->size(), 2u);
+    EXPECT_EQ((*first)[1].x, 10.f);
+}
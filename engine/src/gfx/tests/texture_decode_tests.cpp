@@ -0,0 +1,200 @@
+/*
+ * texture_decode_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "gfx/mip_chain.h"
+#include "vs_thread_pool.h"
+
+#include <boost/filesystem.hpp>
+#include <png.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// The engine decodes through VSImage, which needs the VSFile layer; the
+// benchmark reads the PNGs with libpng directly, which is what VSImage
+// does for them, and then builds the same mip chain the decode jobs build.
+namespace {
+struct DecodedImage {
+    int width = 0;
+    int height = 0;
+    int pixsize = 0;
+    std::vector<unsigned char> pixels;
+    std::vector<std::vector<unsigned char> > mips;
+};
+
+bool decodePng(const std::string &path, DecodedImage &image) {
+    std::unique_ptr<FILE, int (*)(FILE *)> file(fopen(path.c_str(), "rb"), fclose);
+    if (!file) {
+        return false;
+    }
+    png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop info = png ? png_create_info_struct(png) : nullptr;
+    if (!info || setjmp(png_jmpbuf(png))) {
+        png_destroy_read_struct(&png, &info, nullptr);
+        return false;
+    }
+    png_init_io(png, file.get());
+    png_read_info(png, info);
+    png_set_expand(png);
+    png_set_strip_16(png);
+    png_set_gray_to_rgb(png);
+    png_read_update_info(png, info);
+    image.width = png_get_image_width(png, info);
+    image.height = png_get_image_height(png, info);
+    image.pixsize = png_get_channels(png, info);
+    const size_t stride = png_get_rowbytes(png, info);
+    image.pixels.resize(stride * image.height);
+    std::vector<png_bytep> rows(image.height);
+    for (int y = 0; y < image.height; ++y) {
+        rows[y] = image.pixels.data() + y * stride;
+    }
+    png_read_image(png, rows.data());
+    png_destroy_read_struct(&png, &info, nullptr);
+    BuildMipChain(image.pixels.data(), image.width, image.height, image.pixsize, image.mips);
+    return true;
+}
+
+void writePng(const std::string &path, int size, unsigned seed) {
+    std::unique_ptr<FILE, int (*)(FILE *)> file(fopen(path.c_str(), "wb"), fclose);
+    ASSERT_TRUE(file != nullptr);
+    png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop info = png_create_info_struct(png);
+    png_init_io(png, file.get());
+    png_set_IHDR(png, info, size, size, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
+            PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(png, info);
+    // noise over a gradient, so that compression leaves libpng some work to do
+    std::mt19937 random(seed);
+    std::vector<unsigned char> row(size * 4);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size * 4; ++x) {
+            row[x] = static_cast<unsigned char>((x + y) / 4 + random() % 16);
+        }
+        png_write_row(png, row.data());
+    }
+    png_write_end(png, info);
+    png_destroy_write_struct(&png, &info);
+}
+
+std::vector<std::string> listTextures(const boost::filesystem::path &directory) {
+    std::vector<std::string> textures;
+    for (boost::filesystem::recursive_directory_iterator it(directory), end; it != end; ++it) {
+        if (boost::filesystem::is_regular_file(it->path()) && it->path().extension() == ".png") {
+            textures.push_back(it->path().string());
+        }
+    }
+    return textures;
+}
+}
+
+TEST(MipChain, BoxFilter) {
+    // 4x2 RGB: every level halves both sides until it is 1x1
+    const std::vector<unsigned char> pixels = {
+            0, 0, 0, 4, 4, 4, 8, 8, 8, 255, 255, 255,
+            2, 2, 2, 6, 6, 6, 0, 0, 0, 255, 255, 255,
+    };
+    std::vector<std::vector<unsigned char> > levels;
+    BuildMipChain(pixels.data(), 4, 2, 3, levels);
+    ASSERT_EQ(levels.size(), 2u);
+    EXPECT_EQ(levels[0], (std::vector<unsigned char>{3, 3, 3, 130, 130, 130}));
+    EXPECT_EQ(levels[1], (std::vector<unsigned char>{67, 67, 67}));
+}
+
+TEST(MipChain, OnePixelWide) {
+    const std::vector<unsigned char> pixels = {10, 20, 30, 41};
+    std::vector<std::vector<unsigned char> > levels;
+    BuildMipChain(pixels.data(), 1, 4, 1, levels);
+    ASSERT_EQ(levels.size(), 2u);
+    EXPECT_EQ(levels[0], (std::vector<unsigned char>{15, 36}));
+    EXPECT_EQ(levels[1], (std::vector<unsigned char>{26}));
+
+    BuildMipChain(pixels.data(), 1, 1, 4, levels);
+    EXPECT_TRUE(levels.empty());
+}
+
+// Set VS_TEXTURE_BENCH_DIR to a data directory to time real textures;
+// otherwise a set of generated ones is used.
+TEST(TextureDecode, SerialAgainstWorkerPool) {
+    boost::filesystem::path directory;
+    boost::filesystem::path generated;
+    const char *bench_dir = getenv("VS_TEXTURE_BENCH_DIR");
+    if (bench_dir && *bench_dir) {
+        directory = bench_dir;
+    } else {
+        generated = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("vs-textures-%%%%-%%%%");
+        boost::filesystem::create_directories(generated);
+        for (unsigned i = 0; i < 16; ++i) {
+            writePng((generated / ("texture" + std::to_string(i) + ".png")).string(), 512, i);
+        }
+        directory = generated;
+    }
+    const std::vector<std::string> textures = listTextures(directory);
+    ASSERT_FALSE(textures.empty());
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<DecodedImage> serial(textures.size());
+    for (size_t i = 0; i < textures.size(); ++i) {
+        decodePng(textures[i], serial[i]);
+    }
+    const std::chrono::duration<double, std::milli> serial_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::future<std::shared_ptr<DecodedImage> > > jobs;
+    for (const std::string &texture : textures) {
+        jobs.push_back(VegaStrike::SubmitWork([texture]() {
+            auto image = std::make_shared<DecodedImage>();
+            decodePng(texture, *image);
+            return image;
+        }));
+    }
+    std::vector<std::shared_ptr<DecodedImage> > pooled;
+    for (auto &job : jobs) {
+        pooled.push_back(job.get());
+    }
+    const std::chrono::duration<double, std::milli> pooled_time = std::chrono::steady_clock::now() - start;
+
+    for (size_t i = 0; i < textures.size(); ++i) {
+        EXPECT_EQ(pooled[i]->pixels, serial[i].pixels) << textures[i];
+        EXPECT_EQ(pooled[i]->mips, serial[i].mips) << textures[i];
+    }
+    std::cout << textures.size() << " textures: " << serial_time.count() << " ms decoding on one thread, "
+              << pooled_time.count() << " ms on the worker pool" << std::endl;
+
+    if (!generated.empty()) {
+        boost::filesystem::remove_all(generated);
+    }
+}
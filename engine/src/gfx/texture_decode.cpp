@@ -0,0 +1,104 @@
+/*
+ * texture_decode.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gfx/texture_decode.h"
+
+#include <cstdlib>
+
+#include "gfx/mip_chain.h"
+#include "src/vs_thread_pool.h"
+
+using VSFileSystem::VSFile;
+
+static bool IsPowerOfTwo(unsigned long n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+TextureDecodeJob::TextureDecodeJob(std::unique_ptr<VSFile> file, std::unique_ptr<VSFile> alpha, bool mipmaps) :
+        data(nullptr),
+        maxdimension(65536),
+        detailtexture(GFXFALSE),
+        file(std::move(file)),
+        alpha(std::move(alpha)),
+        build_mips(mipmaps) {
+    image.palette = nullptr;
+}
+
+TextureDecodeJob::~TextureDecodeJob() {
+    if (done.valid()) {
+        done.wait();
+    }
+    if (data != nullptr) {
+        free(data);
+        data = nullptr;
+    }
+    if (image.palette != nullptr) {
+        free(image.palette);
+        image.palette = nullptr;
+    }
+}
+
+bool TextureDecodeJob::ready() const {
+    return done.valid() && done.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void TextureDecodeJob::wait() const {
+    done.wait();
+}
+
+void TextureDecodeJob::Decode() {
+    data = image.ReadImage(file.get(), nullptr, true, alpha.get());
+    if (data != nullptr && build_mips && !image.isCube()
+            && (image.mode == VSImage::_24BIT || image.mode == VSImage::_24BITRGBA)
+            && IsPowerOfTwo(image.sizeX) && IsPowerOfTwo(image.sizeY)) {
+        BuildMipChain(data, int(image.sizeX), int(image.sizeY), image.mode == VSImage::_24BIT ? 3 : 4, mips);
+    }
+    file->Close();
+    if (alpha) {
+        alpha->Close();
+    }
+}
+
+std::shared_ptr<TextureDecodeJob> SubmitTextureDecode(std::unique_ptr<VSFile> file,
+        std::unique_ptr<VSFile> alpha,
+        bool mipmaps) {
+    // Files inside a volume are extracted on their first read, which goes through
+    // the volume table shared by all files; get that done here on the main thread
+    char probe;
+    if (file->UseVolume()) {
+        file->Read(&probe, 0);
+    }
+    if (alpha && alpha->UseVolume()) {
+        alpha->Read(&probe, 0);
+    }
+    std::shared_ptr<TextureDecodeJob> job = std::make_shared<TextureDecodeJob>(std::move(file), std::move(alpha), mipmaps);
+    job->done = VegaStrike::SubmitWork([job]() {
+        job->Decode();
+    }).share();
+    return job;
+}
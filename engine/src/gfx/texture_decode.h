@@ -0,0 +1,89 @@
+/*
+ * texture_decode.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_TEXTURE_DECODE_H
+#define VEGA_STRIKE_ENGINE_GFX_TEXTURE_DECODE_H
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gfx/vsimage.h"
+#include "root_generic/vsfilesystem.h"
+#include "src/gfxlib_struct.h"
+
+// One texture file being decoded on the worker pool (see vs_thread_pool.h).
+// The files are looked up and opened on the main thread, since the file system
+// is not thread safe; reading, decoding and building the mip chain of
+// uncompressed images happens on a worker. Texture picks up the result on the
+// render thread once ready(), and only the GL upload is left to do there.
+class TextureDecodeJob {
+public:
+    TextureDecodeJob(std::unique_ptr<VSFileSystem::VSFile> file,
+            std::unique_ptr<VSFileSystem::VSFile> alpha,
+            bool mipmaps);
+    ~TextureDecodeJob();
+
+    bool ready() const;
+    void wait() const;
+
+    // Everything below is only valid once ready()
+
+    // mode, sizeX, sizeY, palette and sides of the decoded image
+    VSImage image;
+    // As returned by VSImage::ReadImage, NULL if decoding failed
+    unsigned char *data;
+    // Levels after the first for uncompressed power of two images, see mip_chain.h
+    std::vector<std::vector<unsigned char> > mips;
+
+    // Upload parameters, kept here for Texture
+    int maxdimension;
+    GFXBOOL detailtexture;
+    // The file being decoded, and the one to load instead if it turns out to be broken (may be empty)
+    std::string filename;
+    std::string fallback;
+
+private:
+    friend std::shared_ptr<TextureDecodeJob> SubmitTextureDecode(std::unique_ptr<VSFileSystem::VSFile>,
+            std::unique_ptr<VSFileSystem::VSFile>,
+            bool);
+
+    void Decode();
+
+    std::unique_ptr<VSFileSystem::VSFile> file;
+    std::unique_ptr<VSFileSystem::VSFile> alpha;
+    bool build_mips;
+    std::shared_future<void> done;
+};
+
+// Starts decoding the opened file (and optional alpha map) in the background
+std::shared_ptr<TextureDecodeJob> SubmitTextureDecode(std::unique_ptr<VSFileSystem::VSFile> file,
+        std::unique_ptr<VSFileSystem::VSFile> alpha,
+        bool mipmaps);
+
+#endif //VEGA_STRIKE_ENGINE_GFX_TEXTURE_DECODE_H
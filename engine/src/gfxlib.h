@@ -292,6 +292,21 @@ GFXBOOL /*GFXDRVAPI*/ GFXTransferTexture(unsigned char *buffer,
         GFXBOOL detailtexture = GFXFALSE,
         unsigned int pageIndex = 0);
 
+/**
+ * Transfers an uncompressed RGB24 or RGBA32 texture whose mip levels were
+ * already built on the CPU. levels[0] is the full image, every following level
+ * halves both sides down to 1x1. Levels bigger than the maximum texture size
+ * are skipped instead of downsampled.
+ */
+GFXBOOL /*GFXDRVAPI*/ GFXTransferMipChain(const unsigned char *const *levels,
+        int levelcount,
+        int handle,
+        int inWidth,
+        int inHeight,
+        enum TEXTUREFORMAT internalformat,
+        enum TEXTURE_IMAGE_TARGET image2D = TEXTURE_2D,
+        int max_texture_dimension = 65536);
+
 GFXBOOL /*GFXDRVAPI*/ GFXTransferSubTexture(unsigned char *buffer,
         int handle,
         int x,
@@ -25,7 +25,8 @@
 #define VEGA_STRIKE_ENGINE_GLDRV_GL_LIGHT_H
 
 #include "src/gfxlib.h"
-#include "hashtable_3d.h"
+#include "src/linecollide.h"
+#include "gldrv/light_index.h"
 #include "gl_globals.h"
 extern GLint GFX_MAX_LIGHTS;
 extern GLint GFX_OPTIMAL_LIGHTS;
@@ -132,6 +133,9 @@ public:
 
     ///calculates bounds for the table given cutoffs!
     LineCollide CalculateBounds(bool &err);
+
+    ///bounds the given light properties would have, without a lightNum
+    static LineCollide CalculateBounds(const GFXLight &light, bool &err);
 };
 
 namespace OpenGLL {
@@ -170,32 +174,12 @@ extern int _GLLightsEnabled;
 ///currently stored GL lights!
 extern OpenGLLights *GLLights;
 
-///A sortable line collide object that will sort by object addr for dup elim
-struct LineCollideStar {
-    LineCollide *lc;
-
-    LineCollideStar() {
-        lc = NULL;
-    }
-
-    bool operator==(const LineCollideStar &b) const {
-        return lc->object.i == b.lc->object.i;
-    }
-
-    bool operator<(const LineCollideStar &b) const {
-        return *((int *) &(lc->object.i)) < *((int *) &(b.lc->object.i));
-    }
-
-    inline int GetIndex() {
-        return *((int *) (&lc->object.i));
-    }
-};
 ///Finds the local lights that are clobberable for new lights (permanent perhaps)
 int findLocalClobberable();
 
 #define CTACC 40000
 ///table to store local lights, numerical pointers to _llights (eg indices)
-extern Hashtable3d<LineCollideStar, 20, CTACC, lighthuge> lighttable;
+extern LightIndex lighttable;
 
 ///something that would normally round down
 extern float intensity_cutoff;
@@ -31,7 +31,6 @@
 #include <vector>
 #include <algorithm>
 using std::priority_queue;
-#include "hashtable_3d.h"
 //using std::list;
 using std::vector;
 //optimization globals
@@ -78,10 +77,6 @@ void removelightfromnewpick(int index) {
     }
 }
 
-inline int getIndex(const LineCollide &t) {
-    return t.object.i;
-}
-
 static void swappicked() {
     if (newpicked == &pickedlights[0]) {
         newpicked = &pickedlights[1];
@@ -138,8 +133,7 @@ static float attenuatedIntensity(const gfx_light &light, const Vector &center, c
     }
 }
 
-static bool picklight(const LineCollide &lightcollide,
-        const Vector &center,
+static bool picklight(const Vector &center,
         const float rad,
         const int lightsenabled,
         const int lightindex,
@@ -166,8 +160,6 @@ struct lightsort {
     }
 };
 
-typedef vector<LineCollideStar> veclinecol;
-
 void GFXGlobalLights(vector<int> &lights, const Vector &center, const float radius) {
     for (int i = 0; i < GFX_MAX_LIGHTS; ++i) {
         if ((GLLights[i].options & (OpenGLL::GL_ENABLED | OpenGLL::GLL_LOCAL)) == OpenGLL::GL_ENABLED) {
@@ -203,21 +195,15 @@ void GFXPickLights(const Vector &center,
         GFXGlobalLights(lights, center, radius);
     }
 
-    veclinecol *tmppickt[2];
-    lighttable.Get(center.Cast(), tmppickt);
-
-    for (int j = 0; j < 2; j++) {
-        veclinecol::iterator i;
-        float attenuated = 0, occlusion = 0;
-
-        for (i = tmppickt[j]->begin(); i != tmppickt[j]->end(); i++) {
-            if (picklight(*i->lc, center, radius, lightsenabled, i->GetIndex(), attenuated, occlusion)) {
-                int ix = i->GetIndex();
-                gfx_light &l = (*_llights)[ix];
-                l.occlusion = occlusion;
-                lights.push_back(ix);
-                lightsenabled++;
-            }
+    //consecutive picks (the meshes of one unit) mostly fall in the same cell
+    static LightCandidates candidates;
+    float attenuated = 0, occlusion = 0;
+    for (int ix : lighttable.Candidates(center.Cast(), candidates)) {
+        if (picklight(center, radius, lightsenabled, ix, attenuated, occlusion)) {
+            gfx_light &l = (*_llights)[ix];
+            l.occlusion = occlusion;
+            lights.push_back(ix);
+            lightsenabled++;
         }
     }
     std::sort(lights.begin(), lights.end(), lightsort(center, radius));
@@ -237,19 +223,12 @@ void GFXPickLights(vector<int>::const_iterator begin, vector<int>::const_iterato
 
 void gfx_light::dopickenables() {
     //sort it to find minimum num lights changed from last time.
-    sort(newpicked->begin(), newpicked->end());
-    //newpicked->sort();
+    //lights picked again that still hold their GL light are already taken care of. main screen turn on ;-)
+    ReconcilePickedLights(*newpicked, *oldpicked, [](int light) {
+        return (*_llights)[light].target >= 0;
+    });
     std::vector<int>::iterator traverse;
     std::vector<int>::iterator oldtrav;
-    for (traverse = newpicked->begin(); traverse != newpicked->end() && (!oldpicked->empty()); ++traverse) {
-        for (oldtrav = oldpicked->begin(); oldtrav != oldpicked->end() && *oldtrav < *traverse;) {
-            oldtrav++;
-        }
-        if (((*traverse) == (*oldtrav)) && ((*_llights)[*oldtrav].target >= 0)) {
-            //BOGUS ASSERT... just like this light wasn't on if it was somehow clobberedassert (GLLights[(*_llights)[oldpicked->front()].target].index == oldpicked->front());
-            oldpicked->erase(oldtrav);              //already taken care of. main screen turn on ;-)
-        }
-    }
     for (oldtrav = oldpicked->begin(); oldtrav != oldpicked->end(); ++oldtrav) {
         if (GLLights[(*_llights)[(*oldtrav)].target].index != (*oldtrav)) {
             continue;
@@ -27,8 +27,8 @@
 #include <cstring>
 //#include <vegastrike.h>
 #include "gl_globals.h"
-#include "hashtable_3d.h"
 #include "gl_light.h"
+#include "src/vs_logging.h"
 
 #include <math.h>
 #include "gfx_generic/matrix.h"
@@ -184,7 +184,7 @@ const float atten0scale = 1;
 const float atten1scale = 1. / GFX_SCALE;
 const float atten2scale = 1. / (GFX_SCALE * GFX_SCALE);
 int _GLLightsEnabled = 0;
-Hashtable3d<LineCollideStar, 20, CTACC, lighthuge> lighttable;
+LightIndex lighttable(CTACC, lighthuge);
 
 GFXLight gfx_light::operator=(const GFXLight &tmp) {   // Let's see if I can write a better copy operator
 //    memcpy( this, &tmp, sizeof (GFXLight) );
@@ -526,45 +526,27 @@ void gfx_light::TrashFromGLLights() {
 }
 
 void gfx_light::AddToTable() {
-    LineCollideStar tmp;
     bool err;
-    LineCollide *coltarg = new LineCollide(CalculateBounds(err));     //leak??
+    LineCollide coltarg(CalculateBounds(err));
     if (err) {
         return;
     }
-    tmp.lc = coltarg;
-    lighttable.Put(coltarg, tmp);
+    lighttable.Insert(lightNum(), coltarg.Mini, coltarg.Maxi);
 }
 
 bool gfx_light::RemoveFromTable(bool shouldremove, const GFXLight &t) {
-    LineCollideStar tmp;
-    bool err;
-    LineCollide coltarg(CalculateBounds(err));
-    if (!shouldremove) {
-        bool err2;
-        LineCollide coltarg2(CalculateBounds(err2));
-        if (lighttable.hash_int(coltarg2.Mini.i) == lighttable.hash_int(coltarg.Mini.i)
-                && lighttable.hash_int(coltarg2.Mini.j) == lighttable.hash_int(coltarg.Mini.j)
-                && lighttable.hash_int(coltarg2.Mini.k) == lighttable.hash_int(coltarg.Mini.k)
-                && lighttable.hash_int(coltarg2.Maxi.i) == lighttable.hash_int(coltarg.Maxi.i)
-                && lighttable.hash_int(coltarg2.Maxi.j) == lighttable.hash_int(coltarg.Maxi.j)
-                && lighttable.hash_int(coltarg2.Maxi.k) == lighttable.hash_int(coltarg.Maxi.k)) {
-            return false;
-        }
-    }
-    if (err) {
+    if (!lighttable.Contains(lightNum())) {
         return false;
     }
-    tmp.lc = &coltarg;
-    if (lighttable.Remove(&coltarg, tmp)) {
-        if (tmp.lc != nullptr) {
-            delete tmp.lc;
-            tmp.lc = nullptr;
-        } else {
-            assert(tmp.lc);
+    if (!shouldremove) {
+        //only move the light if its new bounds span other cells
+        bool err;
+        LineCollide coltarg(CalculateBounds(t, err));
+        if (!err && lighttable.SameCells(lightNum(), coltarg.Mini, coltarg.Maxi)) {
+            return false;
         }
     }
-    return true;
+    return lighttable.Remove(lightNum());
 }
 
 //unimplemented
@@ -613,6 +595,17 @@ void gfx_light::Disable() {
 //d= (-B + sqrtf (B*B + 4*C*(tot/i-A)))/ (2C)
 
 LineCollide gfx_light::CalculateBounds(bool &error) {
+    LineCollide retval(CalculateBounds(*this, error));
+    *((int *) (&retval.object)) = lightNum();       //put in a lightNum
+    return retval;
+}
+
+LineCollide gfx_light::CalculateBounds(const GFXLight &light, bool &error) {
+    const float *specular = light.specular;
+    const float *diffuse = light.diffuse;
+    const float *ambient = light.ambient;
+    const float *attenuate = light.attenuate;
+    const float *vect = light.vect;
     error = false;
     float tot_intensity = ((specular[0] + specular[1] + specular[2]) * specular[3]
             + (diffuse[0] + diffuse[1] + diffuse[2]) * diffuse[3]
@@ -632,9 +625,7 @@ LineCollide gfx_light::CalculateBounds(bool &error) {
 
     QVector st(vect[0] - ffastmathreallysucksd, vect[1] - ffastmathreallysucksd, vect[2] - ffastmathreallysucksd);
     QVector end(vect[0] + ffastmathreallysucksd, vect[1] + ffastmathreallysucksd, vect[2] + ffastmathreallysucksd);
-    LineCollide retval(NULL, LineCollide::UNIT, st, end);
-    *((int *) (&retval.object)) = lightNum();       //put in a lightNum
-    return retval;
+    return LineCollide(NULL, LineCollide::UNIT, st, end);
 }
 
 void light_rekey_frame() {
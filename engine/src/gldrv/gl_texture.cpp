@@ -1094,6 +1094,67 @@ GFXBOOL /*GFXDRVAPI*/ GFXTransferTexture(unsigned char *buffer,
     return GFXTRUE;
 }
 
+GFXBOOL /*GFXDRVAPI*/ GFXTransferMipChain(const unsigned char *const *levels,
+        int levelcount,
+        int handle,
+        int inWidth,
+        int inHeight,
+        TEXTUREFORMAT internformat,
+        enum TEXTURE_IMAGE_TARGET imagetarget,
+        int maxdimension) {
+    if (handle < 0 || levelcount <= 0 || (internformat != RGB24 && internformat != RGBA32)) {
+        return GFXFALSE;
+    }
+    GLTexture &texture = textures.at(handle);
+    GLenum image2D = GetImageTarget(imagetarget);
+    glBindTexture(texture.targets, texture.name);
+    if (maxdimension == 65536) {
+        maxdimension = gl_options.max_texture_dimension;
+    }
+    if (maxdimension > MAX_TEXTURE_SIZE) {
+        maxdimension = MAX_TEXTURE_SIZE;
+    }
+    //Start from the first level that fits, the chain already holds the downsampled images
+    int first = 0;
+    int width = inWidth;
+    int height = inHeight;
+    while (first < levelcount - 1 && (width > maxdimension || height > maxdimension)) {
+        width = width > 1 ? width >> 1 : 1;
+        height = height > 1 ? height >> 1 : 1;
+        ++first;
+    }
+    texture.iwidth = inWidth;
+    texture.iheight = inHeight;
+    texture.width = width;
+    texture.height = height;
+    GLenum internalformat = GetTextureFormat(internformat);
+    const bool mipmaps = (texture.mipmapped & (TRILINEAR | MIPMAP)) && gl_options.mipmap >= 2;
+    const int last = mipmaps ? levelcount : first + 1;
+    VS_LOG(debug,
+            (boost::format("Transferring %1%x%2% texture with %3% prebuilt mips (eff: %4%x%5% - limited at %6%), onto name %7%")
+                    % inWidth
+                    % inHeight
+                    % (last - first - 1)
+                    % width
+                    % height
+                    % maxdimension
+                    % texture.name));
+    for (int level = first; level < last; ++level) {
+        glTexImage2D(image2D,
+                level - first,
+                internalformat,
+                width,
+                height,
+                0,
+                texture.textureformat,
+                GL_UNSIGNED_BYTE,
+                levels[level]);
+        width = width > 1 ? width >> 1 : 1;
+        height = height > 1 ? height >> 1 : 1;
+    }
+    return GFXTRUE;
+}
+
 void /*GFXDRVAPI*/ GFXDeleteTexture(const size_t handle) {
     if (handle >= textures.size()) {
         VS_LOG(error, (boost::format("GFXDeleteTexture(const size_t handle) called with invalid handle value %1%, which is greater than textures.size(): %2%")
@@ -0,0 +1,142 @@
+/*
+ * light_index.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gldrv/light_index.h"
+
+#include <cmath>
+#include <limits>
+
+LightIndex::LightIndex(double cell_size, size_t huge_cells)
+        : cell_size(cell_size > 1.0 ? cell_size : 1.0), huge_cells(huge_cells), generation(0) {
+}
+
+void LightIndex::Clear() {
+    cells.clear();
+    placements.clear();
+    huge.clear();
+    ++generation;
+}
+
+int64_t LightIndex::CellOf(double coordinate) const {
+    // keep absurd coordinates from overflowing the cell numbers
+    const double limit = static_cast<double>(std::numeric_limits<int64_t>::max() / 4);
+    const double cell = std::floor(coordinate / cell_size);
+    return static_cast<int64_t>(std::max(-limit, std::min(limit, cell)));
+}
+
+LightIndex::Placement LightIndex::Place(const QVector &min, const QVector &max) const {
+    Placement placement;
+    placement.min = Cell{CellOf(min.i), CellOf(min.j), CellOf(min.k)};
+    placement.max = Cell{CellOf(max.i), CellOf(max.j), CellOf(max.k)};
+    const double count = double(placement.max.i - placement.min.i + 1) * double(placement.max.j - placement.min.j + 1)
+            * double(placement.max.k - placement.min.k + 1);
+    placement.huge = count > double(huge_cells);
+    return placement;
+}
+
+void LightIndex::Erase(std::vector<int> &lights, int light) {
+    lights.erase(std::remove(lights.begin(), lights.end(), light), lights.end());
+}
+
+void LightIndex::Insert(int light, const QVector &min, const QVector &max) {
+    Remove(light);
+    const Placement placement = Place(min, max);
+    placements[light] = placement;
+    ++generation;
+    if (placement.huge) {
+        huge.push_back(light);
+        return;
+    }
+    for (int64_t i = placement.min.i; i <= placement.max.i; ++i) {
+        for (int64_t j = placement.min.j; j <= placement.max.j; ++j) {
+            for (int64_t k = placement.min.k; k <= placement.max.k; ++k) {
+                cells[Cell{i, j, k}].push_back(light);
+            }
+        }
+    }
+}
+
+bool LightIndex::Remove(int light) {
+    auto found = placements.find(light);
+    if (found == placements.end()) {
+        return false;
+    }
+    const Placement placement = found->second;
+    placements.erase(found);
+    ++generation;
+    if (placement.huge) {
+        Erase(huge, light);
+        return true;
+    }
+    for (int64_t i = placement.min.i; i <= placement.max.i; ++i) {
+        for (int64_t j = placement.min.j; j <= placement.max.j; ++j) {
+            for (int64_t k = placement.min.k; k <= placement.max.k; ++k) {
+                auto bucket = cells.find(Cell{i, j, k});
+                if (bucket == cells.end()) {
+                    continue;
+                }
+                Erase(bucket->second, light);
+                if (bucket->second.empty()) {
+                    cells.erase(bucket);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool LightIndex::SameCells(int light, const QVector &min, const QVector &max) const {
+    auto found = placements.find(light);
+    if (found == placements.end()) {
+        return false;
+    }
+    const Placement placement = Place(min, max);
+    return placement.huge == found->second.huge && placement.min == found->second.min
+            && placement.max == found->second.max;
+}
+
+void LightIndex::Candidates(const QVector &position, std::vector<int> &lights) const {
+    lights.insert(lights.end(), huge.begin(), huge.end());
+    auto bucket = cells.find(Cell{CellOf(position.i), CellOf(position.j), CellOf(position.k)});
+    if (bucket != cells.end()) {
+        lights.insert(lights.end(), bucket->second.begin(), bucket->second.end());
+    }
+}
+
+const std::vector<int> &LightIndex::Candidates(const QVector &position, LightCandidates &cache) const {
+    const int64_t cell[3] = {CellOf(position.i), CellOf(position.j), CellOf(position.k)};
+    if (!cache.valid || cache.generation != generation || cache.cell[0] != cell[0] || cache.cell[1] != cell[1]
+            || cache.cell[2] != cell[2]) {
+        cache.lights.clear();
+        Candidates(position, cache.lights);
+        cache.valid = true;
+        cache.generation = generation;
+        std::copy(cell, cell + 3, cache.cell);
+    }
+    return cache.lights;
+}
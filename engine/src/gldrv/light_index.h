@@ -0,0 +1,147 @@
+/*
+ * light_index.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GLDRV_LIGHT_INDEX_H
+#define VEGA_STRIKE_ENGINE_GLDRV_LIGHT_INDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "gfx_generic/vec.h"
+
+// Lights that may reach the cell of the last queried position. Kept by the
+// caller and refilled by LightIndex::Candidates only when the position falls
+// in another cell or the index changed since.
+struct LightCandidates {
+    bool valid = false;
+    int64_t cell[3] = {0, 0, 0};
+    uint64_t generation = 0;
+    std::vector<int> lights;
+};
+
+// Sparse grid of the bounding boxes of local lights, keyed by light number.
+// Only cells that hold a light exist, and cells are told apart by their full
+// coordinates, so lights far apart never share a bucket. Boxes covering more
+// than huge_cells cells go to a list that every query returns.
+class LightIndex {
+public:
+    LightIndex(double cell_size, size_t huge_cells);
+
+    // Empties the index in time proportional to what it holds
+    void Clear();
+
+    // Puts light in every cell its box overlaps, replacing any previous placement
+    void Insert(int light, const QVector &min, const QVector &max);
+
+    // Returns whether light was in the index
+    bool Remove(int light);
+
+    bool Contains(int light) const {
+        return placements.count(light) != 0;
+    }
+
+    // True if light is in the index and a box of min, max would occupy the same cells
+    bool SameCells(int light, const QVector &min, const QVector &max) const;
+
+    // Appends the lights that may reach position: the huge ones, then those of its cell
+    void Candidates(const QVector &position, std::vector<int> &lights) const;
+
+    // As above, through cache
+    const std::vector<int> &Candidates(const QVector &position, LightCandidates &cache) const;
+
+    // Changes whenever a light is inserted or removed
+    uint64_t Generation() const {
+        return generation;
+    }
+
+    size_t size() const {
+        return placements.size();
+    }
+
+private:
+    struct Cell {
+        int64_t i, j, k;
+
+        bool operator==(const Cell &other) const {
+            return i == other.i && j == other.j && k == other.k;
+        }
+    };
+
+    struct CellHash {
+        size_t operator()(const Cell &cell) const {
+            uint64_t h = static_cast<uint64_t>(cell.i) * 0x9E3779B97F4A7C15ULL;
+            h ^= static_cast<uint64_t>(cell.j) + 0x7F4A7C159E3779B9ULL + (h << 6) + (h >> 2);
+            h ^= static_cast<uint64_t>(cell.k) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    struct Placement {
+        Cell min, max;
+        bool huge;
+    };
+
+    int64_t CellOf(double coordinate) const;
+    Placement Place(const QVector &min, const QVector &max) const;
+    static void Erase(std::vector<int> &lights, int light);
+
+    double cell_size;
+    size_t huge_cells;
+    uint64_t generation;
+    std::unordered_map<Cell, std::vector<int>, CellHash> cells;
+    std::unordered_map<int, Placement> placements;
+    std::vector<int> huge;
+};
+
+// Leaves in previous only the lights that were picked before and are not
+// picked again while still holding a GL light (has_gl_light(light) true),
+// i.e. those whose GL light has to be released. Sorts both lists; a single
+// merge pass instead of a search per picked light.
+template<typename HasGLLight>
+void ReconcilePickedLights(std::vector<int> &picked, std::vector<int> &previous, HasGLLight has_gl_light) {
+    std::sort(picked.begin(), picked.end());
+    std::sort(previous.begin(), previous.end());
+    size_t kept = 0;
+    size_t next = 0;
+    for (size_t i = 0; i < previous.size(); ++i) {
+        const int light = previous[i];
+        while (next < picked.size() && picked[next] < light) {
+            ++next;
+        }
+        if (next < picked.size() && picked[next] == light && has_gl_light(light)) {
+            ++next;
+            continue;
+        }
+        previous[kept++] = light;
+    }
+    previous.resize(kept);
+}
+
+#endif //VEGA_STRIKE_ENGINE_GLDRV_LIGHT_INDEX_H
@@ -21,12 +21,23 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
 #include "gldrv/sdds.h"
 #include "root_generic/vs_globals.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VS_SDDS_SSE2 1
+#include <emmintrin.h>
+#endif
+
 #ifndef GETL16
 #define GETL16(buf) ( ( (unsigned short) (buf)[0] )|( (unsigned short) (buf)[1]<<8 ) )
 #endif
+#ifndef GETL32
+#define GETL32(buf) ( ( (unsigned int) (buf)[0] )|( (unsigned int) (buf)[1]<<8 ) \
+                     |( (unsigned int) (buf)[2]<<16 )|( (unsigned int) (buf)[3]<<24 ) )
+#endif
 #ifndef GETL64
 #define GETL64(buf)                 \
     ( ( (unsigned int) (buf)[0] )     \
@@ -44,17 +55,16 @@
 
 /*	Software decompression for DDS files, helper functions */
 
-void decode_color_block(unsigned char *RESTRICT dst,
-        unsigned char *RESTRICT src,
-        int w,
-        int h,
-        int rowbytes,
-        TEXTUREFORMAT format) {
-    int i, x, y;
-    unsigned int indexes, idx;
-    unsigned char *d;
-    unsigned char colors[4][3];
+/*
+ *       The four colours of a colour block, packed as RGBA with red in the lowest byte.
+ *       Only DXT1 has the three colour mode (c0 <= c1) where the fourth colour is transparent
+ *       (white with alpha 0, as the original decoder produced it);
+ *       DXT3 and DXT5 always interpolate two colours between the end points.
+ */
+static void color_block_palette(const unsigned char *RESTRICT src, TEXTUREFORMAT format, unsigned int palette[4]) {
+    unsigned char colors[4][4];
     unsigned short c0, c1;
+    int i;
     c0 = GETL16(&src[0]);
     c1 = GETL16(&src[2]);
     colors[0][0] = ((c0 >> 11) & 0x1f) << 3;
@@ -63,7 +73,8 @@ void decode_color_block(unsigned char *RESTRICT dst,
     colors[1][0] = ((c1 >> 11) & 0x1f) << 3;
     colors[1][1] = ((c1 >> 5) & 0x3f) << 2;
     colors[1][2] = ((c1) & 0x1f) << 3;
-    if ((c0 > c1) || (format == DXT5)) {
+    colors[0][3] = colors[1][3] = colors[2][3] = colors[3][3] = 255;
+    if ((c0 > c1) || (format != DXT1 && format != DXT1RGBA)) {
         for (i = 0; i < 3; ++i) {
             colors[2][i] = (2 * colors[0][i] + colors[1][i] + 1) / 3;
             colors[3][i] = (2 * colors[1][i] + colors[0][i] + 1) / 3;
@@ -73,47 +84,51 @@ void decode_color_block(unsigned char *RESTRICT dst,
             colors[2][i] = (colors[0][i] + colors[1][i] + 1) >> 1;
             colors[3][i] = 255;
         }
+        colors[3][3] = 0;
     }
+    for (i = 0; i < 4; ++i) {
+        palette[i] = colors[i][0] | (colors[i][1] << 8) | (colors[i][2] << 16) | ((unsigned int) colors[i][3] << 24);
+    }
+}
+
+void decode_color_block(unsigned char *RESTRICT dst,
+        const unsigned char *RESTRICT src,
+        int w,
+        int h,
+        int rowbytes,
+        TEXTUREFORMAT format) {
+    int x, y;
+    unsigned int indexes, idx;
+    unsigned char *d;
+    unsigned int palette[4];
+    color_block_palette(src, format, palette);
     src += 4;
-    if (format == DXT1 || format == DXT1RGBA) {
-        for (y = 0; y < h; ++y) {
-            d = dst + (y * rowbytes);
-            indexes = src[y];
-            for (x = 0; x < w; ++x) {
-                idx = indexes & 0x03;
-                d[0] = colors[idx][0];
-                d[1] = colors[idx][1];
-                d[2] = colors[idx][2];
-                d[3] = ((c0 <= c1) && idx == 3) ? 0 : 255;
-                indexes >>= 2;
-                d += 4;
-            }
-        }
-    } else {
-        for (y = 0; y < h; ++y) {
-            d = dst + (y * rowbytes);
-            indexes = src[y];
-            for (x = 0; x < w; ++x) {
-                idx = indexes & 0x03;
-                d[0] = colors[idx][0];
-                d[1] = colors[idx][1];
-                d[2] = colors[idx][2];
-                indexes >>= 2;
-                d += 4;
+    //DXT3 and DXT5 blocks leave the alpha channel to the alpha decoders
+    const bool write_alpha = (format == DXT1 || format == DXT1RGBA);
+    for (y = 0; y < h; ++y) {
+        d = dst + (y * rowbytes);
+        indexes = src[y];
+        for (x = 0; x < w; ++x) {
+            idx = indexes & 0x03;
+            d[0] = palette[idx] & 0xff;
+            d[1] = (palette[idx] >> 8) & 0xff;
+            d[2] = (palette[idx] >> 16) & 0xff;
+            if (write_alpha) {
+                d[3] = palette[idx] >> 24;
             }
-
+            indexes >>= 2;
+            d += 4;
         }
     }
 }
 
-void decode_dxt3_alpha(unsigned char *RESTRICT dst, unsigned char *RESTRICT src, int w, int h, int rowbytes) {
+void decode_dxt3_alpha(unsigned char *RESTRICT dst, const unsigned char *RESTRICT src, int w, int h, int rowbytes) {
     int x, y;
     unsigned char *d;
     unsigned int bits;
     for (y = 0; y < h; ++y) {
         d = dst + (y * rowbytes);
         bits = GETL16(&src[2 * y]);
-        bits = GETL16(&src[2 * y]);
         for (x = 0; x < w; ++x) {
             d[0] = (bits & 0x0f) * 17;
             bits >>= 4;
@@ -122,7 +137,7 @@ void decode_dxt3_alpha(unsigned char *RESTRICT dst, unsigned char *RESTRICT src,
     }
 }
 
-void decode_dxt5_alpha(unsigned char *RESTRICT dst, unsigned char *RESTRICT src, int w, int h, int bpp, int rowbytes) {
+void decode_dxt5_alpha(unsigned char *RESTRICT dst, const unsigned char *RESTRICT src, int w, int h, int bpp, int rowbytes) {
     int x, y, code;
     unsigned char *d, a0 = src[0], a1 = src[1];
     unsigned long long bits = GETL64(src) >> 16;
@@ -148,36 +163,281 @@ void decode_dxt5_alpha(unsigned char *RESTRICT dst, unsigned char *RESTRICT src,
     }
 }
 
+static int block_bytes(TEXTUREFORMAT format) {
+    return (format == DXT3 || format == DXT5) ? 16 : 8;
+}
+
+void ddsDecodeBlockScalar(const unsigned char *src, unsigned char *dst, int rowbytes, TEXTUREFORMAT format) {
+    if (format == DXT3) {
+        decode_dxt3_alpha(dst + 3, src, 4, 4, rowbytes);
+        src += 8;
+    } else if (format == DXT5) {
+        decode_dxt5_alpha(dst + 3, src, 4, 4, 4, rowbytes);
+        src += 8;
+    }
+    decode_color_block(dst, src, 4, 4, rowbytes, format);
+}
+
+#ifdef VS_SDDS_SSE2
+/*
+ *       A row of a decoded block is four RGBA pixels, exactly one SSE2 register.
+ *       Every lane picks its palette entry from the two bits of its index with masks,
+ *       so a whole row is selected at once without branches or table lookups.
+ */
+static void decode_block_sse2(const unsigned char *src, unsigned char *dst, int rowbytes, TEXTUREFORMAT format) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i alpha = zero;
+    const bool separate_alpha = (format == DXT3 || format == DXT5);
+    if (format == DXT3) {
+        //sixteen 4 bit alphas, low nibble first; n * 17 == n | n << 4
+        const __m128i nibble = _mm_set1_epi8(0x0f);
+        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src));
+        const __m128i lo = _mm_and_si128(bytes, nibble);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble);
+        alpha = _mm_unpacklo_epi8(lo, hi);
+        alpha = _mm_or_si128(alpha, _mm_slli_epi16(alpha, 4));
+        src += 8;
+    } else if (format == DXT5) {
+        //3 bit indexes do not line up with lanes, so the alpha values are looked up one by one
+        unsigned char table[8], alphas[16];
+        const unsigned char a0 = src[0], a1 = src[1];
+        table[0] = a0;
+        table[1] = a1;
+        for (int code = 2; code < 8; ++code) {
+            if (a0 > a1) {
+                table[code] = ((8 - code) * a0 + (code - 1) * a1) / 7;
+            } else if (code >= 6) {
+                table[code] = (code == 6) ? 0 : 255;
+            } else {
+                table[code] = ((6 - code) * a0 + (code - 1) * a1) / 5;
+            }
+        }
+        unsigned long long bits = GETL64(src) >> 16;
+        for (int i = 0; i < 16; ++i) {
+            alphas[i] = table[bits & 0x07];
+            bits >>= 3;
+        }
+        alpha = _mm_loadu_si128(reinterpret_cast<const __m128i *>(alphas));
+        src += 8;
+    }
+    //alpha of pixel i moved to the top byte of lane i % 4 of row i / 4
+    const __m128i alpha_lo = _mm_unpacklo_epi8(zero, alpha);
+    const __m128i alpha_hi = _mm_unpackhi_epi8(zero, alpha);
+    const __m128i alpha_rows[4] = {
+            _mm_unpacklo_epi16(zero, alpha_lo), _mm_unpackhi_epi16(zero, alpha_lo),
+            _mm_unpacklo_epi16(zero, alpha_hi), _mm_unpackhi_epi16(zero, alpha_hi)
+    };
+    const __m128i rgb = _mm_set1_epi32(0x00ffffff);
+
+    unsigned int palette[4];
+    color_block_palette(src, format, palette);
+    const __m128i p0 = _mm_set1_epi32(static_cast<int>(palette[0]));
+    const __m128i p1 = _mm_set1_epi32(static_cast<int>(palette[1]));
+    const __m128i p2 = _mm_set1_epi32(static_cast<int>(palette[2]));
+    const __m128i p3 = _mm_set1_epi32(static_cast<int>(palette[3]));
+    //row y holds its indexes in byte y, pixel x in bits 2x and 2x+1
+    const __m128i indexes = _mm_set1_epi32(static_cast<int>(GETL32(src + 4)));
+    const __m128i bit0 = _mm_set_epi32(1 << 6, 1 << 4, 1 << 2, 1);
+    const __m128i bit1 = _mm_add_epi32(bit0, bit0);
+    for (int y = 0; y < 4; ++y) {
+        const __m128i row = _mm_srl_epi32(indexes, _mm_cvtsi32_si128(8 * y));
+        const __m128i low = _mm_cmpeq_epi32(_mm_and_si128(row, bit0), bit0);
+        const __m128i high = _mm_cmpeq_epi32(_mm_and_si128(row, bit1), bit1);
+        const __m128i p01 = _mm_or_si128(_mm_and_si128(low, p1), _mm_andnot_si128(low, p0));
+        const __m128i p23 = _mm_or_si128(_mm_and_si128(low, p3), _mm_andnot_si128(low, p2));
+        __m128i color = _mm_or_si128(_mm_and_si128(high, p23), _mm_andnot_si128(high, p01));
+        if (separate_alpha) {
+            color = _mm_or_si128(_mm_and_si128(color, rgb), alpha_rows[y]);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + y * rowbytes), color);
+    }
+}
+#endif
+
+void ddsDecodeBlock(const unsigned char *src, unsigned char *dst, int rowbytes, TEXTUREFORMAT format) {
+#ifdef VS_SDDS_SSE2
+    decode_block_sse2(src, dst, rowbytes, format);
+#else
+    ddsDecodeBlockScalar(src, dst, rowbytes, format);
+#endif
+}
+
 void ddsDecompress(unsigned char *&RESTRICT buffer,
         unsigned char *&RESTRICT data,
         TEXTUREFORMAT internformat,
         int height,
         int width) {
-    unsigned char *pos_out = NULL, *pos_in = NULL;
-    int bpp = 4;
-    unsigned int sx, sy;
-
-    sx = (width < 4) ? width : 4;
-    sy = (height < 4) ? width : 4;
+    const int bpp = 4;
+    const int rowbytes = width * bpp;
+    const int blocksize = block_bytes(internformat);
+    const unsigned char *pos_in = buffer;
+    unsigned char block[4 * 4 * 4];
     data = static_cast<unsigned char *>(malloc(static_cast<size_t>(height)
             * static_cast<size_t>(width) * static_cast<size_t>(bpp)));
-    pos_out = data;
-    pos_in = buffer;
     for (int y = 0; y < height; y += 4) {
+        const int h = std::min(4, height - y);
         for (int x = 0; x < width; x += 4) {
-            pos_out = data + (y * width + x) * bpp;
-            if (internformat == DXT3) {
-                decode_dxt3_alpha(pos_out + 3, pos_in, sx, sy, width * bpp);
-                pos_in += 8;
-            } else if (internformat == DXT5) {
-                decode_dxt5_alpha(pos_out + 3, pos_in, sx, sy, bpp, width * bpp);
-                pos_in += 8;
+            const int w = std::min(4, width - x);
+            unsigned char *pos_out = data + (static_cast<size_t>(y) * width + x) * bpp;
+            if (w == 4 && h == 4) {
+                ddsDecodeBlock(pos_in, pos_out, rowbytes, internformat);
+            } else {
+                //blocks on the right and bottom edges of odd sized images are cropped
+                ddsDecodeBlock(pos_in, block, 4 * bpp, internformat);
+                for (int row = 0; row < h; ++row) {
+                    memcpy(pos_out + row * rowbytes, block + row * 4 * bpp, w * bpp);
+                }
             }
-            decode_color_block(pos_out, pos_in, sx, sy, width * bpp, internformat);
-            pos_in += 8;
+            pos_in += blocksize;
         }
     }
 }
 
 /*  END of software decompression for DDS helper functions */
 
+/*	Software compression to DDS, helper functions */
+
+static unsigned short pack_565(const int color[3]) {
+    //rounded to the value that the decoder expands back to (no bit replication)
+    const int r = std::min(31, (color[0] + 4) >> 3);
+    const int g = std::min(63, (color[1] + 2) >> 2);
+    const int b = std::min(31, (color[2] + 4) >> 3);
+    return static_cast<unsigned short>((r << 11) | (g << 5) | b);
+}
+
+static void put16(unsigned char *dst, unsigned int value) {
+    dst[0] = value & 0xff;
+    dst[1] = (value >> 8) & 0xff;
+}
+
+/*
+ *       Fast end point selection: the bounding box of the block's colours, inset by a sixteenth
+ *       of its size, then every pixel takes the nearest of the colours the decoder will produce.
+ *       With punchthrough (DXT1RGBA) pixels with alpha below 128 use the transparent entry.
+ */
+static void encode_color_block(const unsigned char *RESTRICT block,
+        unsigned char *RESTRICT dst,
+        TEXTUREFORMAT format,
+        bool punchthrough) {
+    int lo[3] = {255, 255, 255}, hi[3] = {0, 0, 0};
+    bool transparent = false, opaque = false;
+    for (int i = 0; i < 16; ++i) {
+        const unsigned char *p = block + 4 * i;
+        if (punchthrough && p[3] < 128) {
+            transparent = true;
+            continue;
+        }
+        opaque = true;
+        for (int c = 0; c < 3; ++c) {
+            lo[c] = std::min(lo[c], int(p[c]));
+            hi[c] = std::max(hi[c], int(p[c]));
+        }
+    }
+    if (!opaque) {
+        //three colour mode with every pixel on the transparent entry
+        put16(dst, 0);
+        put16(dst + 2, 0);
+        dst[4] = dst[5] = dst[6] = dst[7] = 0xff;
+        return;
+    }
+    for (int c = 0; c < 3; ++c) {
+        const int inset = (hi[c] - lo[c]) >> 4;
+        lo[c] += inset;
+        hi[c] -= inset;
+    }
+    unsigned short c0 = pack_565(hi), c1 = pack_565(lo);
+    //DXT1 picks the three colour mode with c0 <= c1, the other formats ignore the order
+    if (transparent ? (c0 > c1) : (c0 < c1)) {
+        std::swap(c0, c1);
+    }
+    put16(dst, c0);
+    put16(dst + 2, c1);
+    unsigned int palette[4];
+    color_block_palette(dst, format, palette);
+    //a transparent fourth entry (three colour mode) is only for transparent pixels
+    const int colors = (palette[3] >> 24) == 0 ? 3 : 4;
+    unsigned int indexes = 0;
+    for (int i = 15; i >= 0; --i) {
+        const unsigned char *p = block + 4 * i;
+        unsigned int best = 3;
+        if (!transparent || p[3] >= 128) {
+            int best_error = 1 << 30;
+            for (int e = 0; e < colors; ++e) {
+                const int dr = int(palette[e] & 0xff) - p[0];
+                const int dg = int((palette[e] >> 8) & 0xff) - p[1];
+                const int db = int((palette[e] >> 16) & 0xff) - p[2];
+                const int error = dr * dr + dg * dg + db * db;
+                if (error < best_error) {
+                    best_error = error;
+                    best = e;
+                }
+            }
+        }
+        indexes = (indexes << 2) | best;
+    }
+    put16(dst + 4, indexes & 0xffff);
+    put16(dst + 6, indexes >> 16);
+}
+
+static void encode_dxt3_alpha(const unsigned char *RESTRICT block, unsigned char *RESTRICT dst) {
+    for (int i = 0; i < 8; ++i) {
+        const int a0 = (block[8 * i + 3] + 8) / 17;
+        const int a1 = (block[8 * i + 7] + 8) / 17;
+        dst[i] = static_cast<unsigned char>(a0 | (a1 << 4));
+    }
+}
+
+static void encode_dxt5_alpha(const unsigned char *RESTRICT block, unsigned char *RESTRICT dst) {
+    int lo = 255, hi = 0;
+    for (int i = 0; i < 16; ++i) {
+        lo = std::min(lo, int(block[4 * i + 3]));
+        hi = std::max(hi, int(block[4 * i + 3]));
+    }
+    //hi > lo selects the eight value mode; codes 0 and 1 are the end points, 2 to 7 step from hi to lo
+    dst[0] = static_cast<unsigned char>(hi);
+    dst[1] = static_cast<unsigned char>(lo);
+    unsigned long long bits = 0;
+    const int range = hi - lo;
+    for (int i = 15; i >= 0; --i) {
+        unsigned int code = 0;
+        if (range > 0) {
+            const int step = ((block[4 * i + 3] - lo) * 14 + range) / (2 * range);
+            code = (step == 7) ? 0 : (step == 0) ? 1 : 8 - step;
+        }
+        bits = (bits << 3) | code;
+    }
+    for (int i = 0; i < 6; ++i) {
+        dst[2 + i] = static_cast<unsigned char>(bits >> (8 * i));
+    }
+}
+
+size_t ddsCompressedSize(TEXTUREFORMAT format, int height, int width) {
+    return static_cast<size_t>((width + 3) / 4) * static_cast<size_t>((height + 3) / 4) * block_bytes(format);
+}
+
+void ddsCompress(const unsigned char *input, unsigned char *output, TEXTUREFORMAT format, int height, int width) {
+    unsigned char block[4 * 4 * 4];
+    for (int y = 0; y < height; y += 4) {
+        for (int x = 0; x < width; x += 4) {
+            //edge blocks repeat the last row and column of the image
+            for (int row = 0; row < 4; ++row) {
+                const int sy = std::min(y + row, height - 1);
+                for (int column = 0; column < 4; ++column) {
+                    const int sx = std::min(x + column, width - 1);
+                    memcpy(block + 4 * (4 * row + column), input + 4 * (static_cast<size_t>(sy) * width + sx), 4);
+                }
+            }
+            if (format == DXT3) {
+                encode_dxt3_alpha(block, output);
+                output += 8;
+            } else if (format == DXT5) {
+                encode_dxt5_alpha(block, output);
+                output += 8;
+            }
+            encode_color_block(block, output, format, format == DXT1RGBA);
+            output += 8;
+        }
+    }
+}
+
+/*  END of software compression to DDS helper functions */
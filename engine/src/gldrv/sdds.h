@@ -23,6 +23,8 @@
 #define VEGA_STRIKE_ENGINE_GLDRV_SDDS_H
 #include "src/gfxlib_struct.h"
 
+#include <stddef.h>
+
 /*
  *       input is the compressed dxt file, already read in by vsimage.
  *       output is an empty pointer created in the calling function.
@@ -36,4 +38,20 @@
 
 void ddsDecompress(unsigned char *&input, unsigned char *&output, TEXTUREFORMAT format, int height, int width);
 
+/*
+ *       Decodes one 4x4 block of format (DXT1, DXT1RGBA, DXT3 or DXT5) to RGBA at dst, rowbytes apart.
+ *       ddsDecodeBlock uses SSE2 where the compiler targets it and is otherwise ddsDecodeBlockScalar;
+ *       both produce the same pixels.
+ */
+void ddsDecodeBlock(const unsigned char *src, unsigned char *dst, int rowbytes, TEXTUREFORMAT format);
+void ddsDecodeBlockScalar(const unsigned char *src, unsigned char *dst, int rowbytes, TEXTUREFORMAT format);
+
+/*
+ *       input is an RGBA image of width x height, output must hold ddsCompressedSize bytes.
+ *       This is a fast encoder meant for tools and for textures generated at run time,
+ *       not a replacement for an offline high quality compressor.
+ */
+size_t ddsCompressedSize(TEXTUREFORMAT format, int height, int width);
+void ddsCompress(const unsigned char *input, unsigned char *output, TEXTUREFORMAT format, int height, int width);
+
 #endif //VEGA_STRIKE_ENGINE_GLDRV_SDDS_H
@@ -0,0 +1,196 @@
+/*
+ * light_index_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "gldrv/light_index.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+const double kCell = 40000.0;
+
+struct Box {
+    QVector min, max;
+};
+
+std::vector<int> sorted(std::vector<int> lights) {
+    std::sort(lights.begin(), lights.end());
+    return lights;
+}
+
+std::vector<int> bruteForce(const std::vector<Box> &boxes, const std::vector<bool> &present, const QVector &point) {
+    // the cells of the point and of a box overlap exactly when the point's cell lies in the box's cell range
+    std::vector<int> lights;
+    auto cell = [](double coordinate) {
+        return std::floor(coordinate / kCell);
+    };
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        if (present[i]
+                && cell(boxes[i].min.i) <= cell(point.i) && cell(point.i) <= cell(boxes[i].max.i)
+                && cell(boxes[i].min.j) <= cell(point.j) && cell(point.j) <= cell(boxes[i].max.j)
+                && cell(boxes[i].min.k) <= cell(point.k) && cell(point.k) <= cell(boxes[i].max.k)) {
+            lights.push_back(static_cast<int>(i));
+        }
+    }
+    return lights;
+}
+
+// What dopickenables did with nested loops before
+std::vector<int> nestedReconcile(std::vector<int> picked, std::vector<int> previous, const std::vector<int> &targets) {
+    std::sort(picked.begin(), picked.end());
+    for (auto traverse = picked.begin(); traverse != picked.end() && !previous.empty(); ++traverse) {
+        auto oldtrav = previous.begin();
+        while (oldtrav != previous.end() && *oldtrav < *traverse) {
+            ++oldtrav;
+        }
+        if (oldtrav != previous.end() && *traverse == *oldtrav && targets[*oldtrav] >= 0) {
+            previous.erase(oldtrav);
+        }
+    }
+    return previous;
+}
+
+} // namespace
+
+TEST(LightIndex, FarLightsDoNotAlias) {
+    LightIndex index(kCell, 8000);
+    // 20 cells apart, which the old 20 wide table folded onto the same bucket
+    index.Insert(0, QVector(1000, 1000, 1000), QVector(2000, 2000, 2000));
+    index.Insert(1, QVector(20 * kCell + 1000, 1000, 1000), QVector(20 * kCell + 2000, 2000, 2000));
+
+    std::vector<int> lights;
+    index.Candidates(QVector(1500, 1500, 1500), lights);
+    EXPECT_EQ(std::vector<int>{0}, lights);
+    lights.clear();
+    index.Candidates(QVector(20 * kCell + 1500, 1500, 1500), lights);
+    EXPECT_EQ(std::vector<int>{1}, lights);
+    lights.clear();
+    index.Candidates(QVector(-1500, -1500, -1500), lights);
+    EXPECT_TRUE(lights.empty());
+}
+
+TEST(LightIndex, MatchesBruteForce) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> position(-20 * kCell, 20 * kCell);
+    std::uniform_real_distribution<double> extent(0.0, 3 * kCell);
+    std::vector<Box> boxes(300);
+    std::vector<bool> present(boxes.size(), true);
+    LightIndex index(kCell, 8000);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const QVector centre(position(rng), position(rng), position(rng));
+        const double half = extent(rng);
+        boxes[i] = Box{centre - QVector(half, half, half), centre + QVector(half, half, half)};
+        index.Insert(static_cast<int>(i), boxes[i].min, boxes[i].max);
+    }
+    for (size_t i = 0; i < boxes.size(); i += 3) {
+        EXPECT_TRUE(index.Remove(static_cast<int>(i)));
+        present[i] = false;
+    }
+    EXPECT_FALSE(index.Remove(0));
+    EXPECT_EQ(200u, index.size());
+
+    for (int query = 0; query < 2000; ++query) {
+        // aim at the boxes so that most queries find something
+        const Box &box = boxes[query % boxes.size()];
+        const QVector point = (box.min + box.max) * 0.5 + QVector(extent(rng), -extent(rng), extent(rng));
+        std::vector<int> lights;
+        index.Candidates(point, lights);
+        EXPECT_EQ(bruteForce(boxes, present, point), sorted(lights));
+    }
+}
+
+TEST(LightIndex, HugeLightsReachEverywhere) {
+    LightIndex index(kCell, 8);
+    index.Insert(5, QVector(0, 0, 0), QVector(3 * kCell, 3 * kCell, 3 * kCell));
+    std::vector<int> lights;
+    index.Candidates(QVector(1e12, -1e12, 0), lights);
+    EXPECT_EQ(std::vector<int>{5}, lights);
+    index.Clear();
+    lights.clear();
+    index.Candidates(QVector(0, 0, 0), lights);
+    EXPECT_TRUE(lights.empty());
+    EXPECT_FALSE(index.Contains(5));
+}
+
+TEST(LightIndex, SameCells) {
+    LightIndex index(kCell, 8000);
+    index.Insert(3, QVector(100, 100, 100), QVector(kCell + 100, 100, 100));
+    EXPECT_TRUE(index.SameCells(3, QVector(200, 200, 200), QVector(kCell + 200, 200, 200)));
+    EXPECT_FALSE(index.SameCells(3, QVector(200, 200, 200), QVector(200, 200, 200)));
+    EXPECT_FALSE(index.SameCells(4, QVector(200, 200, 200), QVector(kCell + 200, 200, 200)));
+}
+
+TEST(LightIndex, CandidatesCache) {
+    LightIndex index(kCell, 8000);
+    index.Insert(1, QVector(0, 0, 0), QVector(10, 10, 10));
+    LightCandidates cache;
+    EXPECT_EQ(std::vector<int>{1}, index.Candidates(QVector(5, 5, 5), cache));
+
+    // same cell and no change: the cached list is returned as is
+    cache.lights.push_back(42);
+    EXPECT_EQ((std::vector<int>{1, 42}), index.Candidates(QVector(kCell - 1, 5, 5), cache));
+
+    // another cell refills it
+    EXPECT_TRUE(index.Candidates(QVector(kCell + 1, 5, 5), cache).empty());
+
+    // and so does a change to the index
+    index.Insert(2, QVector(kCell, 0, 0), QVector(kCell + 10, 10, 10));
+    EXPECT_EQ(std::vector<int>{2}, index.Candidates(QVector(kCell + 1, 5, 5), cache));
+}
+
+TEST(LightIndex, ReconcilePickedLightsMatchesNestedLoops) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> light(0, 30);
+    std::uniform_int_distribution<int> target(-1, 7);
+    for (int round = 0; round < 500; ++round) {
+        std::vector<int> targets(31);
+        for (int &t : targets) {
+            t = target(rng);
+        }
+        std::vector<int> picked(light(rng) % 10);
+        for (int &l : picked) {
+            l = light(rng);
+        }
+        std::vector<int> previous(light(rng) % 10);
+        for (int &l : previous) {
+            l = light(rng);
+        }
+        std::sort(previous.begin(), previous.end());
+
+        const std::vector<int> expected = nestedReconcile(picked, previous, targets);
+        ReconcilePickedLights(picked, previous, [&targets](int l) {
+            return targets[l] >= 0;
+        });
+        EXPECT_EQ(expected, previous);
+        EXPECT_TRUE(std::is_sorted(picked.begin(), picked.end()));
+    }
+}
@@ -0,0 +1,174 @@
+/*
+ * sdds_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "gldrv/sdds.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+const TEXTUREFORMAT formats[] = {DXT1, DXT1RGBA, DXT3, DXT5};
+
+std::vector<unsigned char> randomBlocks(TEXTUREFORMAT format, int height, int width, unsigned seed) {
+    std::mt19937 random(seed);
+    std::vector<unsigned char> blocks(ddsCompressedSize(format, height, width));
+    for (unsigned char &byte : blocks) {
+        byte = static_cast<unsigned char>(random());
+    }
+    return blocks;
+}
+
+// Soft gradients with a few hard edges, alpha running across the image
+std::vector<unsigned char> testImage(int height, int width) {
+    std::vector<unsigned char> image(static_cast<size_t>(height) * width * 4);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            unsigned char *p = &image[(static_cast<size_t>(y) * width + x) * 4];
+            p[0] = static_cast<unsigned char>(x * 255 / std::max(1, width - 1));
+            p[1] = static_cast<unsigned char>(y * 255 / std::max(1, height - 1));
+            p[2] = ((x / 16 + y / 16) % 2) ? 200 : 40;
+            p[3] = static_cast<unsigned char>((x + y) * 255 / std::max(1, width + height - 2));
+        }
+    }
+    return image;
+}
+
+std::vector<unsigned char> decompress(std::vector<unsigned char> &blocks, TEXTUREFORMAT format, int height, int width) {
+    unsigned char *input = blocks.data();
+    unsigned char *output = nullptr;
+    ddsDecompress(input, output, format, height, width);
+    std::vector<unsigned char> image(output, output + static_cast<size_t>(height) * width * 4);
+    free(output);
+    return image;
+}
+
+double megabytesPerSecond(size_t bytes, std::chrono::steady_clock::duration time) {
+    return bytes / std::chrono::duration<double>(time).count() / (1024.0 * 1024.0);
+}
+}
+
+TEST(SDDS, DecodeDXT1Block) {
+    // c0 pure red, c1 pure blue, row y uses index y for every pixel
+    const unsigned char block[8] = {0x00, 0xf8, 0x1f, 0x00, 0x00, 0x55, 0xaa, 0xff};
+    unsigned char pixels[64];
+    ddsDecodeBlock(block, pixels, 16, DXT1);
+    const unsigned char expected[4][4] = {{248, 0, 0, 255}, {0, 0, 248, 255}, {165, 0, 83, 255}, {83, 0, 165, 255}};
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            EXPECT_EQ(pixels[4 * i + c], expected[i / 4][c]) << "pixel " << i << " channel " << c;
+        }
+    }
+}
+
+TEST(SDDS, VectorMatchesScalar) {
+    for (TEXTUREFORMAT format : formats) {
+        const std::vector<unsigned char> blocks = randomBlocks(format, 64, 64, format);
+        const int size = (format == DXT3 || format == DXT5) ? 16 : 8;
+        for (size_t offset = 0; offset < blocks.size(); offset += size) {
+            unsigned char vector_pixels[64], scalar_pixels[64];
+            // the colour decoders leave alpha alone for DXT3 and DXT5, so start from the same bytes
+            std::fill(vector_pixels, vector_pixels + 64, 0x5a);
+            std::fill(scalar_pixels, scalar_pixels + 64, 0x5a);
+            ddsDecodeBlock(&blocks[offset], vector_pixels, 16, format);
+            ddsDecodeBlockScalar(&blocks[offset], scalar_pixels, 16, format);
+            ASSERT_EQ(std::vector<unsigned char>(vector_pixels, vector_pixels + 64),
+                    std::vector<unsigned char>(scalar_pixels, scalar_pixels + 64)) << "format " << format;
+        }
+    }
+}
+
+TEST(SDDS, RoundTrip) {
+    // odd sizes exercise the cropped edge blocks
+    const int height = 37, width = 53;
+    const std::vector<unsigned char> image = testImage(height, width);
+    for (TEXTUREFORMAT format : formats) {
+        std::vector<unsigned char> blocks(ddsCompressedSize(format, height, width));
+        ddsCompress(image.data(), blocks.data(), format, height, width);
+        const std::vector<unsigned char> decoded = decompress(blocks, format, height, width);
+        int worst_color = 0, worst_alpha = 0;
+        for (size_t i = 0; i < image.size(); i += 4) {
+            for (int c = 0; c < 3; ++c) {
+                worst_color = std::max(worst_color, std::abs(image[i + c] - decoded[i + c]));
+            }
+            if (format == DXT1RGBA) {
+                EXPECT_EQ(decoded[i + 3] >= 128, image[i + 3] >= 128);
+            } else if (format != DXT1) {
+                worst_alpha = std::max(worst_alpha, std::abs(image[i + 3] - decoded[i + 3]));
+            }
+        }
+        // transparent DXT1RGBA pixels decode to white with alpha 0, so their colour is not compared
+        if (format != DXT1RGBA) {
+            EXPECT_LE(worst_color, 48) << "format " << format;
+        }
+        EXPECT_LE(worst_alpha, 20) << "format " << format;
+    }
+}
+
+TEST(SDDS, Throughput) {
+    const int height = 1024, width = 1024;
+    const size_t decoded_bytes = static_cast<size_t>(height) * width * 4;
+    const std::vector<unsigned char> image = testImage(height, width);
+    std::vector<unsigned char> pixels(decoded_bytes);
+    for (TEXTUREFORMAT format : formats) {
+        std::vector<unsigned char> blocks(ddsCompressedSize(format, height, width));
+        const int size = (format == DXT3 || format == DXT5) ? 16 : 8;
+
+        auto start = std::chrono::steady_clock::now();
+        ddsCompress(image.data(), blocks.data(), format, height, width);
+        const auto encode_time = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        const unsigned char *block = blocks.data();
+        for (int y = 0; y < height; y += 4) {
+            for (int x = 0; x < width; x += 4, block += size) {
+                ddsDecodeBlockScalar(block, &pixels[(static_cast<size_t>(y) * width + x) * 4], width * 4, format);
+            }
+        }
+        const auto scalar_time = std::chrono::steady_clock::now() - start;
+        const std::vector<unsigned char> scalar = pixels;
+
+        start = std::chrono::steady_clock::now();
+        block = blocks.data();
+        for (int y = 0; y < height; y += 4) {
+            for (int x = 0; x < width; x += 4, block += size) {
+                ddsDecodeBlock(block, &pixels[(static_cast<size_t>(y) * width + x) * 4], width * 4, format);
+            }
+        }
+        const auto vector_time = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(pixels, scalar);
+        std::cout << "format " << format << ", 1024x1024 RGBA: encode " << megabytesPerSecond(decoded_bytes, encode_time)
+                  << " MB/s, decode " << megabytesPerSecond(decoded_bytes, scalar_time) << " MB/s scalar, "
+                  << megabytesPerSecond(decoded_bytes, vector_time) << " MB/s ddsDecodeBlock" << std::endl;
+    }
+}
@@ -0,0 +1,227 @@
+/*
+ * python_bytecode_cache.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "src/python/python_bytecode_cache.h"
+
+#include <marshal.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "vs_thread_pool.h"
+
+namespace {
+
+// FNV-1a, to name cache files the same on every platform
+uint64_t HashBytes(const std::string &bytes, uint64_t hash = 14695981039346656037ULL) {
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+const char kCacheMagic[8] = {'V', 'S', 'P', 'Y', 'C', 'O', 'D', '1'};
+
+bool ReadWhole(const std::string &path, std::string &contents) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+void AppendString(std::string &out, const std::string &value) {
+    const uint32_t size = static_cast<uint32_t>(value.size());
+    out.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    out += value;
+}
+
+bool TakeString(const std::string &in, size_t &offset, std::string &value) {
+    uint32_t size = 0;
+    if (in.size() - offset < sizeof(size)) {
+        return false;
+    }
+    memcpy(&size, in.data() + offset, sizeof(size));
+    offset += sizeof(size);
+    if (in.size() - offset < size) {
+        return false;
+    }
+    value.assign(in, offset, size);
+    offset += size;
+    return true;
+}
+
+// Everything the bytecode depends on, stored ahead of it and compared on load:
+// the file name alone is a hash, which may collide
+std::string CacheHeader(const std::string &tag, const PythonBytecodeCache::Script &script) {
+    std::string header(kCacheMagic, sizeof(kCacheMagic));
+    AppendString(header, tag);
+    AppendString(header, script.compiled_name);
+    AppendString(header, script.source);
+    return header;
+}
+
+} // namespace
+
+PythonBytecodeCache::PythonBytecodeCache(const std::string &directory, const std::string &tag)
+        : directory(directory), tag(tag) {
+}
+
+PythonBytecodeCache::Script PythonBytecodeCache::ReadScript(const std::string &directory,
+        const std::string &tag,
+        const std::vector<std::string> &paths,
+        const std::string &compiled_name) {
+    Script script;
+    script.compiled_name = compiled_name;
+    for (const std::string &path : paths) {
+        if (ReadWhole(path, script.source)) {
+            script.found = true;
+            break;
+        }
+    }
+    if (!script.found || directory.empty()) {
+        return script;
+    }
+    std::ostringstream key;
+    key << std::hex << HashBytes(script.source, HashBytes(compiled_name, HashBytes(tag)));
+    script.key = directory + "/" + key.str() + ".pyc";
+
+    std::string stored;
+    if (!ReadWhole(script.key, stored)) {
+        return script;
+    }
+    const std::string header = CacheHeader(tag, script);
+    if (stored.size() < header.size() || stored.compare(0, header.size(), header) != 0) {
+        return script;
+    }
+    size_t offset = header.size();
+    script.cached = TakeString(stored, offset, script.bytecode) && offset == stored.size();
+    if (!script.cached) {
+        script.bytecode.clear();
+    }
+    return script;
+}
+
+PythonBytecodeCache::Script PythonBytecodeCache::Read(const std::vector<std::string> &paths,
+        const std::string &compiled_name) const {
+    return ReadScript(directory, tag, paths, compiled_name);
+}
+
+void PythonBytecodeCache::Warm(const std::string &name,
+        const std::vector<std::string> &paths,
+        const std::string &compiled_name) {
+    if (warming.count(name)) {
+        return;
+    }
+    const std::string directory = this->directory;
+    const std::string tag = this->tag;
+    warming[name] = VegaStrike::SubmitWork([directory, tag, paths, compiled_name]() {
+        return ReadScript(directory, tag, paths, compiled_name);
+    }).share();
+}
+
+bool PythonBytecodeCache::TakeWarmed(const std::string &name, Script &script) {
+    auto found = warming.find(name);
+    if (found == warming.end()) {
+        return false;
+    }
+    script = found->second.get();
+    warming.erase(found);
+    return true;
+}
+
+PyObject *PythonBytecodeCache::Compile(const Script &script) const {
+    if (script.cached) {
+        PyObject *code = PyMarshal_ReadObjectFromString(script.bytecode.data(),
+                static_cast<Py_ssize_t>(script.bytecode.size()));
+        if (code && PyCode_Check(code)) {
+            return code;
+        }
+        // unreadable after all; compiling rewrites it
+        Py_XDECREF(code);
+        PyErr_Clear();
+    }
+    PyObject *code = Py_CompileString(script.source.c_str(), script.compiled_name.c_str(), Py_file_input);
+    if (!code || script.key.empty()) {
+        return code;
+    }
+    PyObject *bytes = PyMarshal_WriteObjectToString(code, Py_MARSHAL_VERSION);
+    if (!bytes) {
+        PyErr_Clear();
+        return code;
+    }
+    std::string stored = CacheHeader(tag, script);
+    AppendString(stored, std::string(PyBytes_AS_STRING(bytes), static_cast<size_t>(PyBytes_GET_SIZE(bytes))));
+    Py_DECREF(bytes);
+    // written aside and renamed, so that a crash never leaves half a file behind
+    const std::string partial = script.key + ".part";
+    {
+        std::ofstream out(partial.c_str(), std::ios::binary | std::ios::trunc);
+        out.write(stored.data(), static_cast<std::streamsize>(stored.size()));
+        if (!out) {
+            return code;
+        }
+    }
+    std::rename(partial.c_str(), script.key.c_str());
+    return code;
+}
+
+PyObject *PythonBytecodeCache::RunAsMain(PyObject *code, const std::string &filename) {
+    PyObject *main_module = PyImport_AddModule("__main__");
+    if (!main_module) {
+        return nullptr;
+    }
+    PyObject *globals = PyModule_GetDict(main_module);
+    const bool set_file = !PyDict_GetItemString(globals, "__file__");
+    if (set_file) {
+        PyObject *file = PyUnicode_DecodeFSDefault(filename.c_str());
+        if (!file || PyDict_SetItemString(globals, "__file__", file) < 0
+                || PyDict_SetItemString(globals, "__cached__", Py_None) < 0) {
+            Py_XDECREF(file);
+            return nullptr;
+        }
+        Py_DECREF(file);
+    }
+    PyObject *result = PyEval_EvalCode(code, globals, globals);
+    if (set_file) {
+        // keep the script's own error, if any, over a failed cleanup
+        PyObject *type, *value, *traceback;
+        PyErr_Fetch(&type, &value, &traceback);
+        if (PyDict_DelItemString(globals, "__file__") < 0 || PyDict_DelItemString(globals, "__cached__") < 0) {
+            PyErr_Clear();
+        }
+        PyErr_Restore(type, value, traceback);
+    }
+    return result;
+}
@@ -0,0 +1,89 @@
+/*
+ * python_bytecode_cache.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_PYTHON_PYTHON_BYTECODE_CACHE_H
+#define VEGA_STRIKE_ENGINE_PYTHON_PYTHON_BYTECODE_CACHE_H
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+// Keeps the marshalled code of compiled scripts on disk, named by a hash of
+// their source, so that a script compiles once until it is edited or the
+// interpreter changes. Reading scripts and their bytecode needs no Python and
+// can be done ahead on the worker pool; only Compile needs the GIL.
+class PythonBytecodeCache {
+public:
+    // A script as read from disk, with its cached bytecode if there was any
+    struct Script {
+        bool found = false;
+        // the name code objects get, which shows in tracebacks
+        std::string compiled_name;
+        std::string source;
+        std::string key;
+        bool cached = false;
+        std::string bytecode;
+    };
+
+    // directory may be empty to never touch the disk; tag names the
+    // interpreter, as bytecode does not carry across versions
+    PythonBytecodeCache(const std::string &directory, const std::string &tag);
+
+    // Reads the first of paths that exists, and its bytecode if cached
+    Script Read(const std::vector<std::string> &paths, const std::string &compiled_name) const;
+
+    // Starts reading the script name on the worker pool, for TakeWarmed
+    void Warm(const std::string &name, const std::vector<std::string> &paths, const std::string &compiled_name);
+    // Hands over the script name if Warm read it, waiting if still reading
+    bool TakeWarmed(const std::string &name, Script &script);
+
+    // Returns a new reference to the code of script, unmarshalled if cached,
+    // else compiled and then cached. NULL with a Python error set if the
+    // source does not compile.
+    PyObject *Compile(const Script &script) const;
+
+    // Runs code in __main__ as PyRun_SimpleFile runs a file: __file__ is
+    // filename while it runs, unless __main__ already had one. Returns the
+    // result as a new reference, or NULL with a Python error set.
+    static PyObject *RunAsMain(PyObject *code, const std::string &filename);
+
+private:
+    static Script ReadScript(const std::string &directory,
+            const std::string &tag,
+            const std::vector<std::string> &paths,
+            const std::string &compiled_name);
+
+    std::string directory;
+    std::string tag;
+    std::map<std::string, std::shared_future<Script> > warming;
+};
+
+#endif //VEGA_STRIKE_ENGINE_PYTHON_PYTHON_BYTECODE_CACHE_H
@@ -27,6 +27,7 @@
 #include <boost/python.hpp>
 #include "cmd/unit_generic.h"
 #include "src/python/python_compile.h"
+#include "src/python/python_bytecode_cache.h"
 #include <compile.h>
 #if ((PY_VERSION_HEX) < 0x030B0000)
 #include <eval.h>
@@ -38,26 +39,11 @@
 #include "src/universe_util.h"
 #include "src/in_kb_data.h"
 #include "src/vs_logging.h"
+#include "src/configuration/configuration.h"
 
-Hashtable<string, PyObject, 1023> compiled_python;
+#include <boost/filesystem.hpp>
 
-char *LoadString(const char *filename) {
-    FILE *fp = VSFileSystem::vs_open(filename, "r");
-    if (!fp) {
-        return NULL;
-    }
-    VSFileSystem::vs_fseek(fp, 0, SEEK_END);
-    long len = VSFileSystem::vs_ftell(fp);
-    char *retval = NULL;
-    VSFileSystem::vs_fseek(fp, 0, SEEK_SET);
-    if (len) {
-        retval = (char *) malloc((len + 2) * sizeof(char));
-        len = VSFileSystem::vs_read(retval, 1, len, fp);
-        retval[len] = '\0';
-    }
-    VSFileSystem::vs_close(fp);
-    return retval;
-}
+Hashtable<string, PyObject, 1023> compiled_python;
 
 std::string getCompilingName(const std::string &name) {
     std::string compiling_name = VSFileSystem::homedir + DELIMSTR + name;
@@ -75,6 +61,43 @@ void InterpretPython(const std::string &name) {
     free(temp);
 }
 
+static PythonBytecodeCache &BytecodeCache() {
+    static PythonBytecodeCache cache([]() {
+        if (!configuration()->general.python_bytecode_cache) {
+            return std::string();
+        }
+        const std::string directory = VSFileSystem::homedir + "/cache/python";
+        boost::system::error_code error;
+        boost::filesystem::create_directories(directory, error);
+        if (error) {
+            VS_LOG(warning, (boost::format("Not caching compiled python in %1%: %2%") % directory % error.message()));
+            return std::string();
+        }
+        return directory;
+    }(), PY_VERSION);
+    return cache;
+}
+
+//Where vs_open looks for a script opened for reading
+static std::vector<std::string> ScriptPaths(const std::string &name) {
+    std::vector<std::string> paths(1, VSFileSystem::homedir + "/" + name);
+    if (!VSFileSystem::use_volumes) {
+        paths.push_back(name);
+        paths.push_back(VSFileSystem::datadir + "/" + name);
+    }
+    return paths;
+}
+
+void WarmPython(const std::vector<std::string> &filenames) {
+    for (const std::string &name : filenames) {
+        //inline code rather than a file, or already compiled
+        if (name.empty() || name[0] == '#' || compiled_python.Get(name)) {
+            continue;
+        }
+        BytecodeCache().Warm(name, ScriptPaths(name), getCompilingName(name));
+    }
+}
+
 PyObject *CompilePython(const std::string &name) {
     Python::reseterrors();
     PyObject * retval = compiled_python.Get(name);
@@ -82,19 +105,20 @@ PyObject *CompilePython(const std::string &name) {
     if (retval) {
         return retval;
     }
-    char *str = LoadString(name.c_str());
-    if (str) {
-        VS_LOG(info, (boost::format("Compiling python module %1$s\n") % name));
-
-        std::string compiling_name = getCompilingName(name).c_str();
-        char *temp = strdup(compiling_name.c_str());
-
-        retval = Py_CompileString(str, temp, Py_file_input);
+    PythonBytecodeCache::Script script;
+    if (!BytecodeCache().TakeWarmed(name, script)) {
+        script = BytecodeCache().Read(ScriptPaths(name), getCompilingName(name));
+    }
+    if (script.found && !script.source.empty()) {
+        if (script.cached) {
+            VS_LOG(info, (boost::format("Loading compiled python module %1$s\n") % name));
+        } else {
+            VS_LOG(info, (boost::format("Compiling python module %1$s\n") % name));
+        }
+        retval = BytecodeCache().Compile(script);
         if (retval) {
             compiled_python.Put(name, retval);
         }
-        free(temp);
-        free(str);
     }
     return retval;
 }
@@ -103,16 +127,25 @@ extern PyObject *PyInit_VS;
 
 void CompileRunPython(const std::string &filename) {
 #if (PY_VERSION_HEX >= 0x030B0000)
-    Python::reseterrors();
-    InterpretPython(filename);
-    Python::reseterrors();
-#else
+    //without the cache there is nothing to gain over running the file
+    if (!configuration()->general.python_bytecode_cache) {
+        Python::reseterrors();
+        InterpretPython(filename);
+        Python::reseterrors();
+        return;
+    }
+#endif
     static bool ndebug_libs = XMLSupport::parse_bool(vs_config->getVariable("AI", "compile_python", "true"));
     if (ndebug_libs) {
         Python::reseterrors();
         PyObject * CompiledProgram = CompilePython(filename);
         Python::reseterrors();
         if (CompiledProgram) {
+#if (PY_VERSION_HEX >= 0x030B0000)
+            PyObject * exe = PythonBytecodeCache::RunAsMain(CompiledProgram, getCompilingName(filename));
+            Py_XDECREF(exe);
+            Python::reseterrors();
+#else
             PyObject * m, *d;
             static char main_str[16] = "__main__"; //by chuck_starchaser, to squash a warning
             if ((m = PyImport_AddModule(main_str)) != NULL) {
@@ -130,13 +163,13 @@ void CompileRunPython(const std::string &filename) {
                 }
                 Py_XDECREF(localdict);
             }
+#endif
         }
     } else {
         Python::reseterrors();
         InterpretPython(filename);
         Python::reseterrors();
     }
-#endif
 }
 
 PyObject *CreateTuple(const std::vector<PythonBasicType> &values) {
@@ -73,6 +73,9 @@ public:
 
 void InterpretPython(const std::string &filename);
 PyObject *CompilePython(const std::string &filename);
+///Reads scripts and their cached bytecode on the worker pool, so that
+///compiling them later does not wait on the disk
+void WarmPython(const std::vector<std::string> &filenames);
 void CompileRunPython(const std::string &filename);
 PyObject *CreateTuple(const std::vector<PythonBasicType> &values);
 
@@ -26,6 +26,11 @@
 
 voidEXPORT_UTIL(StopAllSounds)
 EXPORT_UTIL(getNumUnits, 0)
+EXPORT_UTIL(getNumLiveUnits, 0)
+EXPORT_UTIL(getUnitPositions, 0)
+EXPORT_UTIL(getUnitFactions, 0)
+EXPORT_UTIL(getUnitFlightgroups, 0)
+EXPORT_UTIL(getUnitHulls, 0)
 EXPORT_UTIL(GetRelation, 0.)
 voidEXPORT_UTIL(AdjustRelation)
 EXPORT_FACTION(GetFactionName, "")
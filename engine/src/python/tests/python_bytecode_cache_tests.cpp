@@ -0,0 +1,237 @@
+/*
+ * python_bytecode_cache_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "src/python/python_bytecode_cache.h"
+
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Holds the interpreter for a test, unless another test already started it
+class PythonSession {
+public:
+    PythonSession() : owner(!Py_IsInitialized()) {
+        if (owner) {
+            Py_Initialize();
+        }
+    }
+
+    ~PythonSession() {
+        if (owner) {
+            Py_Finalize();
+        }
+    }
+
+private:
+    bool owner;
+};
+
+class ScratchDirectory {
+public:
+    ScratchDirectory() : path(boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("pycache-%%%%-%%%%")) {
+        boost::filesystem::create_directories(path / "cache");
+    }
+
+    ~ScratchDirectory() {
+        boost::system::error_code ignored;
+        boost::filesystem::remove_all(path, ignored);
+    }
+
+    std::string Cache() const {
+        return (path / "cache").string();
+    }
+
+    std::string Write(const std::string &name, const std::string &source) const {
+        const std::string file = (path / name).string();
+        std::ofstream out(file.c_str(), std::ios::binary);
+        out << source;
+        return file;
+    }
+
+private:
+    boost::filesystem::path path;
+};
+
+// A script about the size of the bigger base and AI modules
+std::string makeScript(int variant) {
+    std::ostringstream source;
+    source << "import math\n";
+    for (int i = 0; i < 200; ++i) {
+        source << "def function_" << variant << "_" << i << "(a, b=" << i << "):\n"
+                << "    values = [a * k + b for k in range(" << i % 17 + 1 << ")]\n"
+                << "    if len(values) > 3:\n"
+                << "        return sum(values) / math.sqrt(len(values))\n"
+                << "    return {'a': a, 'b': b, 'name': \"function_" << i << "\"}\n";
+    }
+    source << "result = function_" << variant << "_7(3)\n";
+    return source.str();
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+TEST(PythonBytecodeCache, SecondReadUsesTheCache) {
+    PythonSession python;
+    ScratchDirectory scratch;
+    const std::string path = scratch.Write("script.py", makeScript(0));
+    PythonBytecodeCache cache(scratch.Cache(), PY_VERSION);
+
+    PythonBytecodeCache::Script cold = cache.Read(std::vector<std::string>(1, path), "script.py");
+    ASSERT_TRUE(cold.found);
+    EXPECT_FALSE(cold.cached);
+    PyObject *compiled = cache.Compile(cold);
+    ASSERT_NE(compiled, nullptr);
+
+    PythonBytecodeCache::Script warm = cache.Read(std::vector<std::string>(1, path), "script.py");
+    ASSERT_TRUE(warm.cached);
+    PyObject *loaded = cache.Compile(warm);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(PyObject_RichCompareBool(compiled, loaded, Py_EQ), 1);
+    Py_DECREF(compiled);
+    Py_DECREF(loaded);
+}
+
+TEST(PythonBytecodeCache, EditedSourceOrOtherInterpreterMisses) {
+    PythonSession python;
+    ScratchDirectory scratch;
+    std::string path = scratch.Write("script.py", "x = 1\n");
+    PythonBytecodeCache cache(scratch.Cache(), PY_VERSION);
+    PyObject *code = cache.Compile(cache.Read(std::vector<std::string>(1, path), "script.py"));
+    ASSERT_NE(code, nullptr);
+    Py_DECREF(code);
+
+    PythonBytecodeCache other_interpreter(scratch.Cache(), "another version");
+    EXPECT_FALSE(other_interpreter.Read(std::vector<std::string>(1, path), "script.py").cached);
+    EXPECT_FALSE(cache.Read(std::vector<std::string>(1, path), "elsewhere/script.py").cached);
+    path = scratch.Write("script.py", "x = 2\n");
+    EXPECT_FALSE(cache.Read(std::vector<std::string>(1, path), "script.py").cached);
+}
+
+TEST(PythonBytecodeCache, RunAsMainSetsFile) {
+    PythonSession python;
+    ScratchDirectory scratch;
+    const std::string path = scratch.Write("reads_file.py", "seen_file = __file__\n");
+    PythonBytecodeCache cache(scratch.Cache(), PY_VERSION);
+    PyObject *code = cache.Compile(cache.Read(std::vector<std::string>(1, path), "reads_file.py"));
+    ASSERT_NE(code, nullptr);
+
+    PyObject *result = PythonBytecodeCache::RunAsMain(code, "/home/pilot/reads_file.py");
+    ASSERT_NE(result, nullptr);
+    Py_DECREF(result);
+    Py_DECREF(code);
+
+    PyObject *globals = PyModule_GetDict(PyImport_AddModule("__main__"));
+    PyObject *seen = PyDict_GetItemString(globals, "seen_file");
+    ASSERT_NE(seen, nullptr);
+    EXPECT_STREQ(PyUnicode_AsUTF8(seen), "/home/pilot/reads_file.py");
+    // and is gone again afterwards, as with PyRun_SimpleFile
+    EXPECT_EQ(PyDict_GetItemString(globals, "__file__"), nullptr);
+    EXPECT_EQ(PyDict_GetItemString(globals, "__cached__"), nullptr);
+    PyDict_DelItemString(globals, "seen_file");
+}
+
+TEST(PythonBytecodeCache, FirstExistingPathIsRead) {
+    ScratchDirectory scratch;
+    const std::string path = scratch.Write("script.py", "y = 2\n");
+    PythonBytecodeCache cache("", PY_VERSION);
+    std::vector<std::string> paths;
+    paths.push_back(path + ".missing");
+    paths.push_back(path);
+    PythonBytecodeCache::Script script = cache.Read(paths, "script.py");
+    EXPECT_TRUE(script.found);
+    EXPECT_EQ(script.source, "y = 2\n");
+    // nothing is cached without a directory
+    EXPECT_TRUE(script.key.empty());
+    EXPECT_FALSE(cache.Read(std::vector<std::string>(1, path + ".missing"), "script.py").found);
+}
+
+TEST(PythonBytecodeCache, ColdVersusWarmStartup) {
+    PythonSession python;
+    ScratchDirectory scratch;
+    const int kScripts = 40;
+    std::vector<std::string> paths;
+    for (int i = 0; i < kScripts; ++i) {
+        paths.push_back(scratch.Write("module" + std::to_string(i) + ".py", makeScript(i)));
+    }
+
+    // a first launch reads and compiles every script
+    std::vector<PyObject *> cold_code;
+    auto start = std::chrono::steady_clock::now();
+    {
+        PythonBytecodeCache cache(scratch.Cache(), PY_VERSION);
+        for (int i = 0; i < kScripts; ++i) {
+            PythonBytecodeCache::Script script =
+                    cache.Read(std::vector<std::string>(1, paths[i]), "module" + std::to_string(i));
+            EXPECT_FALSE(script.cached);
+            cold_code.push_back(cache.Compile(script));
+        }
+    }
+    const double cold = secondsSince(start);
+
+    // a later one warms them all ahead, then only unmarshals
+    std::vector<PyObject *> warm_code;
+    start = std::chrono::steady_clock::now();
+    {
+        PythonBytecodeCache cache(scratch.Cache(), PY_VERSION);
+        for (int i = 0; i < kScripts; ++i) {
+            cache.Warm(paths[i], std::vector<std::string>(1, paths[i]), "module" + std::to_string(i));
+        }
+        for (int i = 0; i < kScripts; ++i) {
+            PythonBytecodeCache::Script script;
+            ASSERT_TRUE(cache.TakeWarmed(paths[i], script));
+            EXPECT_TRUE(script.cached);
+            warm_code.push_back(cache.Compile(script));
+        }
+        PythonBytecodeCache::Script again;
+        EXPECT_FALSE(cache.TakeWarmed(paths[0], again));
+    }
+    const double warm = secondsSince(start);
+
+    for (int i = 0; i < kScripts; ++i) {
+        ASSERT_NE(cold_code[i], nullptr);
+        ASSERT_NE(warm_code[i], nullptr);
+        EXPECT_EQ(PyObject_RichCompareBool(cold_code[i], warm_code[i], Py_EQ), 1);
+        Py_DECREF(cold_code[i]);
+        Py_DECREF(warm_code[i]);
+    }
+    std::cout << kScripts << " scripts: cold " << cold * 1000.0 << " ms, warm " << warm * 1000.0 << " ms"
+            << std::endl;
+    EXPECT_LT(warm, cold);
+}
@@ -27,13 +27,27 @@
 Store::Store(std::vector<Product> stock, double cash):
     stock(stock),
     cash(Resource<double>(cash, 0.0)),
-    unlimited_funds(cash == -1.0) {}
+    unlimited_funds(cash == -1.0) {
+    IndexStock();
+}
+
+
+void Store::IndexStock() {
+    product_indices.clear();
+    product_indices.reserve(stock.size());
+
+    // emplace keeps the first of duplicate names, as the old linear search did
+    for(int index = 0; index < static_cast<int>(stock.size()); index++) {
+        product_indices.emplace(stock[index].name, index);
+    }
+}
 
 
 void Store::Add(Product product, const int quantity) {
     Product new_product = product;
     new_product.quantity.Set(quantity);
     stock.push_back(new_product);
+    product_indices.emplace(stock.back().name, static_cast<int>(stock.size()) - 1);
 }
 
 void Store::Add(int index, int quantity) {
@@ -44,8 +58,14 @@ void Store::Subtract(int index, int quantity) {
     stock[index].quantity -= quantity;
 }
 
+void Store::Rename(int index, const std::string &name) {
+    stock[index].SetName(name);
+    // Rare, and the old name may now belong to a later duplicate
+    IndexStock();
+}
+
 
-bool Store::Buy(Customer& seller, std::string product_name, double quantity)
+bool Store::Buy(Customer& seller, const std::string &product_name, double quantity)
 {
     // Find product at customer/seller
     int index = seller.ProductIndex(product_name);
@@ -53,9 +73,14 @@ bool Store::Buy(Customer& seller, std::string product_name, double quantity)
         return false;
     }
 
+    return Buy(seller, index, quantity);
+}
+
+bool Store::Buy(Customer& seller, int index, double quantity)
+{
     // Check if seller has enough to sell
-    Product product = seller.stock[index];
-    if(product.quantity < quantity) {
+    const Product &product = seller.stock[index];
+    if(product.quantity.Value() < quantity) {
         return false;
     }
 
@@ -68,11 +93,11 @@ bool Store::Buy(Customer& seller, std::string product_name, double quantity)
     }
 
     // Complete the transaction
-    int buyer_index = ProductIndex(product_name);
+    int buyer_index = ProductIndex(product.name);
     if(buyer_index == -1) {
         Add(product, quantity);
     } else {
-        Add(index, quantity);
+        Add(buyer_index, quantity);
     }
 
     seller.Subtract(index, quantity);
@@ -88,26 +113,24 @@ bool Store::Buy(Customer& seller, std::string product_name, double quantity)
 }
 
 
-bool Store::InStock(std::string product_name) {
-    for(Product &in_store_product : stock) {
-        if(in_store_product == product_name) {
-            return (in_store_product.quantity > 0.0);
-        }
+bool Store::InStock(const std::string &product_name) {
+    int index = ProductIndex(product_name);
+    if(index == -1) {
+        return false;
     }
 
-    return false;
+    return InStock(index);
 }
 
-double Store::GetStock(std::string product_name) {
-    for(Product &in_store_product : stock) {
-        if(in_store_product == product_name ) {
-            return in_store_product.GetQuantity();
-        }
+double Store::GetStock(const std::string &product_name) {
+    int index = ProductIndex(product_name);
+    if(index == -1) {
+        // An easy way to return an error, as product quantity is a resource
+        // and therefore, cannot be less than 0.
+        return -1;
     }
 
-    // An easy way to return an error, as product quantity is a resource
-    // and therefore, cannot be less than 0.
-    return -1;
+    return stock[index].GetQuantity();
 }
 
 bool Store::InStock(const int index) {
@@ -118,23 +141,39 @@ double Store::GetStock(const int index) {
     return stock[index].quantity;
 }
 
-int Store::ProductIndex(std::string product_name) {
-    int index = 0;
+int Store::ProductIndex(const std::string &product_name) {
+    auto found = product_indices.find(product_name);
+    if(found == product_indices.end()) {
+        return -1;
+    }
+    return found->second;
+}
+
 
-    for(Product &in_store_product : stock) {
-        if(in_store_product == product_name) {
-            return index;
-        }
+void Store::ProductIndices(const std::vector<std::string> &product_names, std::vector<int> &indices) {
+    indices.resize(product_names.size());
+    for(size_t i = 0; i < product_names.size(); i++) {
+        indices[i] = ProductIndex(product_names[i]);
+    }
+}
 
-        index++;
+void Store::GetStock(const std::vector<int> &indices, std::vector<double> &quantities) const {
+    quantities.resize(indices.size());
+    for(size_t i = 0; i < indices.size(); i++) {
+        quantities[i] = (indices[i] == -1) ? -1 : stock[indices[i]].quantity.Value();
     }
+}
 
-    return -1;
+void Store::GetPrices(const std::vector<int> &indices, std::vector<double> &prices) const {
+    prices.resize(indices.size());
+    for(size_t i = 0; i < indices.size(); i++) {
+        prices[i] = (indices[i] == -1) ? -1 : stock[indices[i]].price;
+    }
 }
 
 
 
-bool Store::Sell(Customer& buyer, std::string product_name, double quantity)
+bool Store::Sell(Customer& buyer, const std::string &product_name, double quantity)
 {
     return buyer.Buy(*this, product_name, quantity);
 }
@@ -147,5 +186,8 @@ void Store::SetFunds(double cash)
 
 void Store::Stock(std::vector<Product> stock)
 {
-    stock.insert(stock.end(), stock.begin(), stock.end());
+    for(const Product &product : stock) {
+        this->stock.push_back(product);
+        product_indices.emplace(product.name, static_cast<int>(this->stock.size()) - 1);
+    }
 }
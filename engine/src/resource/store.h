@@ -22,6 +22,8 @@
 #ifndef VEGA_STRIKE_ENGINE_RESOURCE_STORE_H
 #define VEGA_STRIKE_ENGINE_RESOURCE_STORE_H
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "resource/product.h"
@@ -36,27 +38,44 @@ typedef Store Customer;
 
 class Store
 {
-public: // TODO: remove
+private:
+    // Private so that every change to names goes through the store and
+    // product_indices (product name to index in stock) stays in step.
     std::vector<Product> stock;
+    std::unordered_map<std::string, int> product_indices;
+
+    void IndexStock();
+public: // TODO: remove
     Resource<double> cash;
     bool unlimited_funds;
-public:
+
     Store(std::vector<Product> stock = std::vector<Product>(), double cash = -1.0);
 
     void Add(Product product, const int quantity);
     void Add(int index, int quantity);
     void Subtract(int index, int quantity);
+    void Rename(int index, const std::string &name);
+
+    const std::vector<Product> &Products() const { return stock; }
 
-    bool InStock(std::string product_name);
-    double GetStock(std::string product_name);
+    bool InStock(const std::string &product_name);
+    double GetStock(const std::string &product_name);
     bool InStock(const int index);
     double GetStock(const int index);
 
-    int ProductIndex(std::string product_name);
+    int ProductIndex(const std::string &product_name);
+
+    // Bulk versions of the above for screens and AI that go over many
+    // products. Missing products get -1, like ProductIndex and GetStock.
+    void ProductIndices(const std::vector<std::string> &product_names, std::vector<int> &indices);
+    void GetStock(const std::vector<int> &indices, std::vector<double> &quantities) const;
+    void GetPrices(const std::vector<int> &indices, std::vector<double> &prices) const;
 
     // These are from the point of view of the store/called class and also affect the other party
-    bool Buy(Customer& seller, std::string product_name, double quantity);
-    bool Sell(Customer& buyer, std::string product_name, double quantity);
+    bool Buy(Customer& seller, const std::string &product_name, double quantity);
+    bool Sell(Customer& buyer, const std::string &product_name, double quantity);
+    // Same, with the index of the product at the seller
+    bool Buy(Customer& seller, int seller_index, double quantity);
     void SetFunds(double cash);
     void Stock(std::vector<Product> stock);
 };
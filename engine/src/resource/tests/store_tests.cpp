@@ -0,0 +1,186 @@
+/*
+ * store_tests.cpp
+ *
+ * Copyright (C) 2001-2025 Daniel Horn, Benjamen Meyer, Roy Falk, Stephen G. Tuggy,
+ * and other Vega Strike contributors.
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "resource/store.h"
+#include "resource/product.h"
+
+namespace {
+
+// The search ProductIndex used to do
+int linearProductIndex(const Store &store, const std::string &product_name) {
+    const std::vector<Product> &stock = store.Products();
+    for(size_t index = 0; index < stock.size(); index++) {
+        if(stock[index] == product_name) {
+            return static_cast<int>(index);
+        }
+    }
+    return -1;
+}
+
+std::vector<Product> makeStock(int count) {
+    std::vector<Product> stock;
+    for(int i = 0; i < count; i++) {
+        stock.emplace_back("Commodity " + std::to_string(i), 1000, 1.0 + i % 97);
+    }
+    return stock;
+}
+
+} // namespace
+
+TEST(Store, ProductIndex) {
+    Product bread("Bread", 1, 1.5);
+    Product milk("Milk", 1, 2);
+    Product gold_bar("Gold", 30, 250);
+    std::vector<Product> stock = { bread, milk, gold_bar, milk };
+    Store store(stock, 1000);
+
+    const std::vector<std::string> names = { "Bread", "Milk", "Gold", "Cheese", "" };
+    for(const std::string &name : names) {
+        EXPECT_EQ(store.ProductIndex(name), linearProductIndex(store, name)) << name;
+    }
+
+    // Products added through the store
+    store.Add(Product("Cheese", 1, 3), 4);
+    EXPECT_EQ(store.ProductIndex("Cheese"), 4);
+    store.Stock({ Product("Wine", 2, 10) });
+    EXPECT_EQ(store.ProductIndex("Wine"), 5);
+
+    // Renames on their own, with the stock size unchanged
+    store.Rename(0, "Rye");
+    EXPECT_EQ(store.ProductIndex("Rye"), 0);
+    EXPECT_EQ(store.ProductIndex("Bread"), -1);
+    // Renaming the first Milk hands the name to the duplicate
+    store.Rename(1, "Oat Milk");
+    for(const char *name : { "Bread", "Rye", "Oat Milk", "Milk", "Wine" }) {
+        EXPECT_EQ(store.ProductIndex(name), linearProductIndex(store, name)) << name;
+    }
+    EXPECT_EQ(store.ProductIndex("Milk"), 3);
+
+    EXPECT_TRUE(store.InStock("Gold"));
+    EXPECT_FALSE(store.InStock("Bread"));
+    EXPECT_EQ(store.GetStock("Gold"), 30);
+    EXPECT_EQ(store.GetStock("Bread"), -1);
+}
+
+TEST(Store, BulkQueries) {
+    Store store(makeStock(100), 1000);
+
+    std::vector<std::string> names = { "Commodity 7", "Nothing", "Commodity 99" };
+    std::vector<int> indices;
+    store.ProductIndices(names, indices);
+    EXPECT_EQ(indices, std::vector<int>({ 7, -1, 99 }));
+
+    std::vector<double> prices;
+    store.GetPrices(indices, prices);
+    EXPECT_EQ(prices, std::vector<double>({ 8, -1, 3 }));
+
+    store.Subtract(7, 400);
+    std::vector<double> quantities;
+    store.GetStock(indices, quantities);
+    EXPECT_EQ(quantities, std::vector<double>({ 600, -1, 1000 }));
+}
+
+TEST(Store, BuyIntoExistingProduct) {
+    Store store({ Product("Bread", 10, 1.5), Product("Milk", 10, 2) }, 1000);
+    Customer customer;
+    customer.Stock({ Product("Milk", 1, 2) });
+    customer.SetFunds(100);
+
+    // Milk is at index 1 in the store but at index 0 at the customer
+    EXPECT_TRUE(customer.Buy(store, "Milk", 3));
+    EXPECT_EQ(customer.GetStock("Milk"), 4);
+    EXPECT_EQ(store.GetStock("Milk"), 7);
+    EXPECT_EQ(customer.cash.Value(), 94);
+    EXPECT_EQ(customer.Products().size(), 1);
+
+    EXPECT_TRUE(customer.Buy(store, store.ProductIndex("Bread"), 2));
+    EXPECT_EQ(customer.GetStock("Bread"), 2);
+    EXPECT_EQ(customer.ProductIndex("Bread"), 1);
+    EXPECT_EQ(customer.cash.Value(), 91);
+}
+
+TEST(Store, TradingLoopBenchmark) {
+    const int number_of_products = 10000;
+    const int number_of_trades = 100000;
+    Store store(makeStock(number_of_products), 1e9);
+    Customer trader(makeStock(number_of_products), 1e9);
+
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<int> product(0, number_of_products - 1);
+    std::vector<std::string> wanted;
+    for(int i = 0; i < number_of_trades; i++) {
+        wanted.push_back("Commodity " + std::to_string(product(generator)));
+    }
+
+    // What every trade cost before: two linear searches. Only a sample,
+    // the whole loop takes seconds.
+    const int linear_sample = number_of_trades / 100;
+    const auto linear_start = std::chrono::steady_clock::now();
+    long found = 0;
+    for(int i = 0; i < linear_sample; i++) {
+        found += linearProductIndex(store, wanted[i]) + linearProductIndex(trader, wanted[i]);
+    }
+    const auto trades_start = std::chrono::steady_clock::now();
+
+    // Buy one, sell one back, so the stock stays put
+    int completed = 0;
+    for(const std::string &name : wanted) {
+        completed += trader.Buy(store, name, 1);
+        completed += trader.Sell(store, name, 1);
+    }
+    const auto bulk_start = std::chrono::steady_clock::now();
+
+    std::vector<int> indices;
+    std::vector<double> prices;
+    std::vector<double> quantities;
+    store.ProductIndices(wanted, indices);
+    store.GetPrices(indices, prices);
+    store.GetStock(indices, quantities);
+    const auto bulk_end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(completed, 2 * number_of_trades);
+    EXPECT_GT(found, 0);
+    EXPECT_EQ(store.Products().size(), number_of_products);
+    EXPECT_EQ(trader.Products().size(), number_of_products);
+    for(size_t i = 0; i < quantities.size(); i++) {
+        EXPECT_EQ(quantities[i], 1000);
+    }
+
+    const std::chrono::duration<double, std::milli> linear_time = trades_start - linear_start;
+    const std::chrono::duration<double, std::milli> trades_time = bulk_start - trades_start;
+    const std::chrono::duration<double, std::milli> bulk_time = bulk_end - bulk_start;
+    std::cout << number_of_trades << " round trips over " << number_of_products << " products: "
+              << 1000.0 * trades_time.count() / number_of_trades << " us each (linear lookups alone "
+              << 1000.0 * linear_time.count() / linear_sample << " us), bulk price and stock query "
+              << bulk_time.count() << " ms" << std::endl;
+}
@@ -26,6 +26,7 @@
 #define PY_SSIZE_T_CLEAN
 #include <boost/python.hpp>
 #include <assert.h>
+#include <algorithm>
 #include "src/star_system.h"
 
 #include "root_generic/lin_time.h"
@@ -37,15 +38,18 @@
 #include "src/hashtable.h"
 #include "root_generic/load_mission.h"
 #include "root_generic/vsfilesystem.h"
+#include "root_generic/system_preloader.h"
 #include "src/vs_logging.h"
 #include "cmd/drawable.h"
 #include "root_generic/options.h"
 #include "root_generic/configxml.h"
 #include "src/vs_random.h"
+#include "src/python/python_compile.h"
 #include "root_generic/savegame.h"
 #include "src/universe_util.h" //get galaxy faction, dude
 
 #include "cmd/planet.h"
+#include "cmd/planetary_orbit.h"
 #include "cmd/unit_collide.h"
 #include "cmd/collection.h"
 #include "cmd/click_list.h"
@@ -61,6 +65,7 @@
 #include "cmd/unit_generic.h"
 #include "cmd/unit_util.h"
 #include "cmd/missile.h"
+#include "cmd/sphere_grid.h"
 
 #include "gfx_generic/boltdrawmanager.h"
 #include "gfx/particle.h"
@@ -99,6 +104,13 @@ StarSystem::StarSystem(const string filename, const Vector &centr, const float t
     GFXCreateLightContext(light_context);
     collide_table = new CollideTable(this);
 
+    //read the scripts the units of a system run while it loads
+    std::vector<std::string> scripts;
+    scripts.push_back(vs_config->getVariable("AI", "ChooseDestinationScript", ""));
+    scripts.push_back(vs_config->getVariable("AI", "DockedToScript", ""));
+    scripts.push_back(vs_config->getVariable("sound", "dj_script", "modules/dj.py"));
+    WarmPython(scripts);
+
     LoadXML(filename, centr, timeofyear);
     if (name.empty()) {
         name = filename;
@@ -482,6 +494,9 @@ void NebulaUpdate(StarSystem *ss) {
 }
 
 void StarSystem::createBackground(Star_XML *xml) {
+    //generate the star fields while the light maps and the background load
+    const StarfieldFuture far_stars = Background::RequestStars(xml->numstars, filename);
+    const StarfieldFuture near_stars = Stars::Request(xml->numnearstars, xml->starsp, filename);
 #ifdef NV_CUBE_MAP
     VS_LOG(info, "using NV_CUBE_MAP");
     light_map[0] = new Texture((xml->backgroundname + "_light.cube").c_str(), 1, TRILINEAR, CUBEMAP, CUBEMAP_POSITIVE_X,
@@ -528,12 +543,11 @@ void StarSystem::createBackground(Star_XML *xml) {
 
     background = new Background(
             xml->backgroundname.c_str(),
-            xml->numstars,
+            far_stars,
             configuration()->graphics.zfar * .9,
-            filename,
             xml->backgroundColor,
             xml->backgroundDegamma);
-    stars = new Stars(xml->numnearstars, xml->starsp);
+    stars = new Stars(near_stars, xml->starsp);
     stars->SetBlend(game_options()->starblend, game_options()->starblend);
 }
 
@@ -887,6 +901,17 @@ void StarSystem::RequestPhysics(Unit *un, unsigned int queue) {
     }
 }
 
+static PlanetaryOrbit *GetPlanetaryOrbit(Unit *unit) {
+    if (!unit || !unit->aistate) {
+        return nullptr;
+    }
+    PlanetaryOrbit *orbit = dynamic_cast<PlanetaryOrbit *>(unit->aistate);
+    if (orbit) {
+        return orbit;
+    }
+    return dynamic_cast<PlanetaryOrbit *>(unit->aistate->queryType(Order::MOVEMENT));
+}
+
 //BELOW COMMENTS ARE NO LONGER IN SYNCH
 //NOTE: Randomization is necessary to preserve scattering - otherwise, whenever a
 //unit goes from low-priority to high-priority and back to low-priority, they
@@ -908,6 +933,13 @@ void StarSystem::UpdateUnitsPhysics(bool firstframe) {
     for (++batchcount; batchcount > 0; --batchcount) {
         try {
             UnitCollection col = physics_buffer[current_sim_location];
+            {
+                un_iter staging = physics_buffer[current_sim_location].createIterator();
+                for (Unit *unit = nullptr; (unit = *staging); ++staging) {
+                    unit->StageEnergy(energy_stage);
+                }
+                energy_stage.Run();
+            }
             un_iter iter = physics_buffer[current_sim_location].createIterator();
             for (Unit *unit = nullptr; (unit = *iter); ++iter) {
                 UpdateUnitPhysics(firstframe, unit);
@@ -938,7 +970,9 @@ void StarSystem::UpdateUnitsPhysics(bool firstframe) {
             simulation_atom_var *= priority;
             //VS_LOG(trace, (boost::format("void StarSystem::UpdateUnitPhysics( bool firstframe ): Msg F: simulation_atom_var as multiplied: %1%") % simulation_atom_var));
             const unsigned int newloc = (current_sim_location + priority) % SIM_QUEUE_SIZE;
-            unit->CollideAll();
+            if (!skip_orbiting_units || !GetPlanetaryOrbit(unit)) {
+                unit->CollideAll();
+            }
             simulation_atom_var = backup;
             //VS_LOG(trace, (boost::format("void StarSystem::UpdateUnitPhysics( bool firstframe ): Msg G: simulation_atom_var as restored:   %1%") % simulation_atom_var));
             if (newloc == current_sim_location) {
@@ -960,6 +994,9 @@ void StarSystem::UpdateUnitsPhysics(bool firstframe) {
 }
 
 void StarSystem::UpdateUnitPhysics(bool firstframe, Unit *unit) {
+    if (skip_orbiting_units && GetPlanetaryOrbit(unit)) {
+        return;
+    }
     int priority = UnitUtil::getPhysicsPriority(unit);
     //Doing spreading here and only on priority changes, so as to make AI easier
     int predprior = unit->predicted_priority;
@@ -1092,6 +1129,39 @@ void StarSystem::Update(float priority) {
     _Universe->popActiveStarSystem();
 }
 
+void StarSystem::FastForwardOrbits(double elapsed) {
+    //moons are placed after the planets they circle, since they start from their new position
+    std::vector<std::pair<unsigned int, PlanetaryOrbit *>> orbits;
+    Unit *unit;
+    for (un_iter iter = draw_list.createIterator(); (unit = *iter); ++iter) {
+        PlanetaryOrbit *orbit = GetPlanetaryOrbit(unit);
+        if (!orbit) {
+            continue;
+        }
+        unsigned int depth = 0;
+        for (Unit *centre = orbit->OrbitedUnit(); centre && depth < SIM_QUEUE_SIZE; ++depth) {
+            PlanetaryOrbit *outer = GetPlanetaryOrbit(centre);
+            centre = outer ? outer->OrbitedUnit() : nullptr;
+        }
+        orbits.emplace_back(depth, orbit);
+    }
+    std::stable_sort(orbits.begin(), orbits.end(),
+            [](const std::pair<unsigned int, PlanetaryOrbit *> &a, const std::pair<unsigned int, PlanetaryOrbit *> &b) {
+                return a.first < b.first;
+            });
+    for (auto &orbit : orbits) {
+        orbit.second->FastForward(elapsed);
+    }
+}
+
+void StarSystem::UpdateUnitsOffOrbit(unsigned int frames) {
+    skip_orbiting_units = true;
+    for (unsigned int frame = 0; frame < frames; ++frame) {
+        UpdateUnitsPhysics(true);
+    }
+    skip_orbiting_units = false;
+}
+
 //client
 void StarSystem::Update(float priority, bool executeDirector) {
     bool firstframe = true;
@@ -1279,6 +1349,15 @@ bool PendingJumpsEmpty() {
     return pendingjump.empty();
 }
 
+//Removes a jump however it ended, along with its preload if that was never used
+static void DropPendingJump(unsigned int kk) {
+    if (!pendingjump[kk]->dest_path.empty()) {
+        SystemPreloader::Cancel(pendingjump[kk]->dest_path);
+    }
+    delete pendingjump[kk];
+    pendingjump.erase(pendingjump.begin() + kk);
+}
+
 void StarSystem::ProcessPendingJumps() {
     for (unsigned int kk = 0; kk < pendingjump.size(); ++kk) {
         Unit *un = pendingjump[kk]->un.GetUnit();
@@ -1303,6 +1382,14 @@ void StarSystem::ProcessPendingJumps() {
                     }
                 }
             }
+            if (pendingjump[kk]->dest == nullptr && SystemPreloader::Failed(pendingjump[kk]->dest_path)) {
+                VS_LOG(error, (boost::format("Jump to %1% cancelled: %2% could not be loaded")
+                        % pendingjump[kk]->dest_file % pendingjump[kk]->dest_path));
+                _Universe->activeStarSystem()->VolitalizeJumpAnimation(pendingjump[kk]->animation);
+                DropPendingJump(kk);
+                --kk;
+                continue;
+            }
             double time = GetElapsedTime();
             if (time > 1) {
                 time = 1;
@@ -1317,14 +1404,22 @@ void StarSystem::ProcessPendingJumps() {
         }
         // int playernum = _Universe->whichPlayerStarship( un );
         //In non-networking mode or in networking mode or a netplayer wants to jump and is ready or a non-player jump
+        if (pendingjump[kk]->dest == nullptr && un != nullptr && _Universe->StillExists(pendingjump[kk]->orig)) {
+            // Destination was preloaded during the countdown; only building it is left
+            pendingjump[kk]->dest = _Universe->GenerateStarSystem(pendingjump[kk]->dest_file.c_str(),
+                    pendingjump[kk]->orig->getFileName().c_str(), Vector(0, 0, 0));
+        }
         StarSystem *savedStarSystem = _Universe->activeStarSystem();
         if (un == nullptr || !_Universe->StillExists(pendingjump[kk]->dest)
                 || !_Universe->StillExists(pendingjump[kk]->orig)) {
+            if (un != nullptr && _Universe->StillExists(pendingjump[kk]->orig)) {
+                VS_LOG(error, (boost::format("Jump to %1% cancelled: the system could not be built")
+                        % pendingjump[kk]->dest_file));
+            }
 #ifdef JUMP_DEBUG
             VS_LOG(debug, "Adez Mon! Unit destroyed during jump!");
 #endif
-            delete pendingjump[kk];
-            pendingjump.erase(pendingjump.begin() + kk);
+            DropPendingJump(kk);
             --kk;
             continue;
         }
@@ -1337,8 +1432,7 @@ void StarSystem::ProcessPendingJumps() {
             _Universe->activeStarSystem()->DoJumpingComeSightAndSound(un);
         }
         _Universe->AccessCockpit()->OnJumpEnd(un);
-        delete pendingjump[kk];
-        pendingjump.erase(pendingjump.begin() + kk);
+        DropPendingJump(kk);
         --kk;
         _Universe->setActiveStarSystem(savedStarSystem);
 
@@ -1422,30 +1516,38 @@ bool StarSystem::JumpTo(Unit *un, Unit *jumppoint, const std::string &system, bo
     if (!ss) {
         ss = star_system_table.Get(ssys);
     }
+    if (isJumping(pendingjump, un)) {
+#ifdef JUMP_DEBUG
+        VS_LOG(debug, "Failed to retrieve!");
+#endif
+        return false;
+    }
     bool justloaded = false;
+    std::string dest_path;
     if (!ss) {
+        // Load it in the background during the countdown, it's built when the jump completes
         justloaded = true;
-        ss = _Universe->GenerateStarSystem(ssys.c_str(), filename.c_str(), Vector(0, 0, 0));
-    }
-    if (ss && !isJumping(pendingjump, un)) {
-#ifdef JUMP_DEBUG
-        VS_LOG(debug, "Pushing back to pending queue!");
-#endif
-        bool dosightandsound = ((this == _Universe->getActiveStarSystem(0)) || _Universe->isPlayerStarship(un));
-        int ani = -1;
-        if (dosightandsound) {
-            ani = _Universe->activeStarSystem()->DoJumpingLeaveSightAndSound(un);
+        dest_path = _Universe->PreloadStarSystem(ssys.c_str(), filename.c_str());
+        if (dest_path.empty()) {
+            return false;
         }
-        _Universe->AccessCockpit()->OnJumpBegin(un);
-        pendingjump.push_back(new unorigdest(un, jumppoint, this, ss, un->jump_drive.Delay(), ani, justloaded,
-                save_coordinates ? ComputeJumpPointArrival(un->Position(),
-                        this->getFileName(),
-                        system) : QVector(0, 0, 0)));
-    } else {
+    }
 #ifdef JUMP_DEBUG
-        VS_LOG(debug, "Failed to retrieve!");
+    VS_LOG(debug, "Pushing back to pending queue!");
 #endif
-        return false;
+    bool dosightandsound = ((this == _Universe->getActiveStarSystem(0)) || _Universe->isPlayerStarship(un));
+    int ani = -1;
+    if (dosightandsound) {
+        ani = _Universe->activeStarSystem()->DoJumpingLeaveSightAndSound(un);
+    }
+    _Universe->AccessCockpit()->OnJumpBegin(un);
+    pendingjump.push_back(new unorigdest(un, jumppoint, this, ss, un->jump_drive.Delay(), ani, justloaded,
+            save_coordinates ? ComputeJumpPointArrival(un->Position(),
+                    this->getFileName(),
+                    system) : QVector(0, 0, 0)));
+    if (!ss) {
+        pendingjump.back()->dest_file = ssys;
+        pendingjump.back()->dest_path = dest_path;
     }
     if (jumppoint) {
         ActivateAnimation(jumppoint);
@@ -1480,27 +1582,43 @@ void StarSystem::UpdateMissiles() {
     static bool collideroids =
             XMLSupport::parse_bool(vs_config->getVariable("physics", "AsteroidWeaponCollision", "false"));
 
-    //WARNING: This is a big performance problem...
-    //...responsible for many hiccups.
-    //TODO: Make it use the collide_map to only iterate through potential hits...
-    //PROBLEM: The current collide_map does not allow this efficiently (no way of
-    //taking the other unit's rSize() into account).
-    if (!discharged_missiles.empty()) {
-        if (discharged_missiles.back()->GetRadius()
-                > 0) {           //we can avoid this iterated check for kinetic projectiles even if they "discharge" on hit
-            Unit *un;
-            for (un_iter ui = getUnitList().createIterator();
-                    NULL != (un = (*ui));
-                    ++ui) {
-                enum Vega_UnitType type = un->isUnit();
-                if (collideroids || type
-                        != Vega_UnitType::asteroid) {           // could check for more, unless someone wants planet-killer missiles, but what it would change?
-                    discharged_missiles.back()->ApplyDamage(un);
-                }
+    //Every explosion queued since the last call goes off now. The units are
+    //bucketed once by their bounding spheres, so each explosion only looks at
+    //units it can actually reach instead of the whole system.
+    if (discharged_missiles.empty()) {
+        return;
+    }
+    //anything blown up by these explodes on the next call
+    vector<MissileEffect *> explosions;
+    explosions.swap(discharged_missiles);
+    double largest_radius = 0;
+    for (const MissileEffect *missile : explosions) {
+        largest_radius = std::max(largest_radius, static_cast<double>(missile->GetRadius()));
+    }
+    //kinetic projectiles "discharge" on hit too, but have no radius
+    if (largest_radius > 0) {
+        SphereGrid<Unit *> units(largest_radius);
+        Unit *un;
+        for (un_iter ui = getUnitList().createIterator(); NULL != (un = (*ui)); ++ui) {
+            // could check for more, unless someone wants planet-killer missiles, but what it would change?
+            if (collideroids || un->isUnit() != Vega_UnitType::asteroid) {
+                units.insert(un->Position(), un->rSize(), un);
             }
         }
-        delete discharged_missiles.back();
-        discharged_missiles.pop_back();
+        //same order as when they went off one per frame: most recent first
+        for (auto missile = explosions.rbegin(); missile != explosions.rend(); ++missile) {
+            if ((*missile)->GetRadius() <= 0) {
+                continue;
+            }
+            units.query((*missile)->GetCenter(), (*missile)->GetRadius(), [missile](Unit *hit) {
+                if (!hit->Killed()) {
+                    (*missile)->ApplyDamage(hit);
+                }
+            });
+        }
+    }
+    for (MissileEffect *missile : explosions) {
+        delete missile;
     }
 }
 
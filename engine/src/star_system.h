@@ -24,6 +24,7 @@
 
 #include "cmd/collection.h"
 #include "cmd/container.h"
+#include "components/energy_stage.h"
 
 #include "gfx_generic/vec.h"
 #include "src/gfxlib.h"
@@ -57,6 +58,7 @@ class StarSystem;
 
 const unsigned int SIM_QUEUE_SIZE = 128;
 bool PendingJumpsEmpty();
+std::string GetStarSystemFullPath(const std::string &filename);
 
 struct Statistics {
     //neutral, friendly, enemy
@@ -114,6 +116,10 @@ protected:
     UnitCollection gravitational_units;
     UnitCollection physics_buffer[SIM_QUEUE_SIZE + 1];
     unsigned int current_sim_location = 0;
+    ///Energy flow of the units in the current sim atom, run as one batch
+    EnergyStage energy_stage;
+    ///Set while units on a PlanetaryOrbit sit out physics frames their orbit was fast-forwarded over
+    bool skip_orbiting_units = false;
 
     ///The moving, fading stars
     Stars *stars = nullptr;
@@ -157,6 +163,10 @@ public:
     virtual void AddMissileToQueue(class MissileEffect *);
     virtual void UpdateMissiles();
     void UpdateUnitsPhysics(bool firstframe);
+    ///Moves every orbiting unit to where elapsed seconds of simulation would put it
+    void FastForwardOrbits(double elapsed);
+    ///Runs physics frames for every unit that is not on an orbit
+    void UpdateUnitsOffOrbit(unsigned int frames);
     void UpdateUnitPhysics(bool firstframe, Unit *unit);
 
     ///Requeues the unit so that it is simulated ASAP.
@@ -63,6 +63,7 @@
 
 #include "resource/random_utils.h"
 #include "root_generic/options.h"
+#include "root_generic/system_preloader.h"
 
 // Using
 using namespace VSFileSystem;
@@ -385,6 +386,7 @@ void Universe::StartDraw() {
     const double gfx_begin_scene_end_time = realTime();
     VS_LOG(trace, (boost::format("%1%: Time taken by GFXBeginScene(): %2%") % __FUNCTION__ % (gfx_begin_scene_end_time - gfx_begin_scene_start_time)));
 #endif
+    Texture::FinishPendingLoads(configuration()->graphics.texture_uploads_per_frame);
     size_t i;
     StarSystem *lastStarSystem = nullptr;
     for (i = 0; i < _cockpits.size(); ++i) {
@@ -717,6 +719,29 @@ StarSystem *Universe::GenerateStarSystem(const char *file, const char *jumpback,
     return ss;
 }
 
+// Gets a system that will be needed soon (e.g. a jump destination) ready
+// ahead of time: it is generated if missing and its file is read and parsed
+// on a worker thread, so GenerateStarSystem only has to build it. Returns the
+// path the preload is filed under, or an empty string if there is no file to
+// load.
+std::string Universe::PreloadStarSystem(const char *file, const char *jumpback) {
+    int count = 0;
+    VSFile f;
+    VSError err = f.OpenReadOnly(file, SystemFile);
+    if (err > Ok) {
+        MakeStarSystem(file, galaxy.get(), RemoveDotSystem(jumpback), count);
+        err = f.OpenReadOnly(file, SystemFile);
+    }
+    if (err > Ok) {
+        VS_LOG(error, (boost::format("Star system %1% could not be found or generated") % file));
+        return std::string();
+    }
+    f.Close();
+    const std::string full_path = GetStarSystemFullPath(file);
+    SystemPreloader::Request(full_path);
+    return full_path;
+}
+
 void Universe::LoadStarSystem(StarSystem *s) {
     VS_LOG(info, "Loading a starsystem");
     star_system.push_back(s);
@@ -748,8 +773,17 @@ void Universe::Generate2(StarSystem *ss) {
     static bool firsttime = true;
     LoadStarSystem(ss);
     pushActiveStarSystem(ss);
-    for (unsigned int tume = 0; tume <= game_options()->num_times_to_simulate_new_star_system * SIM_QUEUE_SIZE + 1;
-            ++tume) {
+    unsigned int settle_frames = game_options()->num_times_to_simulate_new_star_system * SIM_QUEUE_SIZE + 2;
+    if (configuration()->physics.analytic_new_star_system_warmup && settle_frames > SIM_QUEUE_SIZE + 1) {
+        //orbits are deterministic, so jump them ahead; everything else is
+        //stepped through those frames as before, and then all units go
+        //through the physics queue once more together
+        const unsigned int skipped_frames = settle_frames - (SIM_QUEUE_SIZE + 1);
+        ss->FastForwardOrbits(skipped_frames * simulation_atom_var);
+        ss->UpdateUnitsOffOrbit(skipped_frames);
+        settle_frames = SIM_QUEUE_SIZE + 1;
+    }
+    for (unsigned int tume = 0; tume < settle_frames; ++tume) {
         ss->UpdateUnitsPhysics(true);
     }
     //notify the director that a new system is loaded (gotta have at least one active star system)
@@ -122,6 +122,7 @@ public:
     void pushActiveStarSystem(StarSystem *ss);
     void popActiveStarSystem();
     StarSystem *GenerateStarSystem(const char *file, const char *jumpback, Vector origin);
+    std::string PreloadStarSystem(const char *file, const char *jumpback);
     void LoadStarSystem(StarSystem *ss);
     void UnloadStarSystem(StarSystem *ss);
     void Generate1(const char *file, const char *jumpback);
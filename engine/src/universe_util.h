@@ -38,6 +38,12 @@ class Unit;
 class StarSystem;
 class Cargo;
 
+namespace boost {
+namespace python {
+class tuple;
+}
+}
+
 namespace UniverseUtil {
 class PythonUnitIter : public un_iter {
 public:
@@ -112,6 +118,19 @@ PythonUnitIter getUnitList();
 ///This function gets a unit given a number (how many iterations to go down in the iterator)
 Unit *getUnit(int index);
 
+///the number of units getUnit can index this frame (destroyed units are skipped)
+int getNumLiveUnits();
+
+///Bulk queries over the units getUnit indexes, in the same order, in a single call
+///positions are flattened as (x0, y0, z0, x1, y1, z1, ...)
+boost::python::tuple getUnitPositions();
+///faction indices
+boost::python::tuple getUnitFactions();
+///flightgroup names
+boost::python::tuple getUnitFlightgroups();
+///current hull values
+boost::python::tuple getUnitHulls();
+
 ///This function gets a unit given a name
 Unit *getUnitByName(std::string name);
 
@@ -0,0 +1,64 @@
+/*
+ * vs_thread_pool.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_VS_THREAD_POOL_H
+#define VEGA_STRIKE_ENGINE_VS_THREAD_POOL_H
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace VegaStrike {
+
+// Background workers shared by the engine for work that does not touch the
+// scene graph, GL or Python: file I/O, parsing, decoding and the like.
+// Anything submitted here must only hand its results back to the main
+// thread through the returned future.
+inline boost::asio::thread_pool &WorkerThreadPool() {
+    static boost::asio::thread_pool pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+template<typename Work>
+std::future<typename std::result_of<Work()>::type> SubmitWork(Work work) {
+    typedef typename std::result_of<Work()>::type Result;
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::move(work));
+    std::future<Result> future = task->get_future();
+    boost::asio::post(WorkerThreadPool(), [task]() {
+        (*task)();
+    });
+    return future;
+}
+
+} // namespace VegaStrike
+
+#endif //VEGA_STRIKE_ENGINE_VS_THREAD_POOL_H
@@ -230,6 +230,7 @@ void UnitCollection::insert_unique(Unit *unit) {
         }
         unit->Ref();
         u.push_front(unit);
+        ++modifications;
     }
 }
 
@@ -237,6 +238,7 @@ void UnitCollection::prepend(Unit *unit) {
     if (unit) {
         unit->Ref();
         u.push_front(unit);
+        ++modifications;
     }
 }
 
@@ -252,12 +254,14 @@ void UnitCollection::prepend(UnitIterator *it) {
         ++tmpI;
         it->advance();
     }
+    ++modifications;
 }
 
 void UnitCollection::append(Unit *un) {
     if (un) {
         un->Ref();
         u.push_back(un);
+        ++modifications;
     }
 }
 
@@ -271,12 +275,14 @@ void UnitCollection::append(UnitIterator *it) {
         u.push_back(tmp);
         it->advance();
     }
+    ++modifications;
 }
 
 void UnitCollection::insert(list<Unit *>::iterator &temp, Unit *unit) {
     if (unit) {
         unit->Ref();
         temp = u.insert(temp, unit);
+        ++modifications;
     }
     temp = u.end();
 }
@@ -292,6 +298,7 @@ void UnitCollection::clear() {
         (*it) = NULL;
     }
     u.clear();
+    ++modifications;
 }
 
 void UnitCollection::destr() {
@@ -323,6 +330,7 @@ inline void UnitCollection::erase(list<Unit *>::iterator &it2) {
         ++it2;
         return;
     }
+    ++modifications;
     //If we have more than 4 iterators, just push node onto vector.
     if (activeIters.size() > 3) {
         removedIters.push_back(it2);
@@ -368,6 +376,7 @@ bool UnitCollection::remove(const Unit *unit) {
 
 const UnitCollection &UnitCollection::operator=(const UnitCollection &uc) {
     destr();
+    ++modifications;
     list<Unit *>::const_iterator in = uc.u.begin();
     while (in != uc.u.end()) {
         append(*in);
@@ -260,6 +260,13 @@ public:
         return NULL;
     }
 
+    /* Bumped whenever a unit is added to or removed from the list.
+     * Lets callers cache derived data (e.g. an indexed snapshot) and
+     * cheaply tell whether it went stale. */
+    inline unsigned int version() const {
+        return modifications;
+    }
+
     /* Returns first non-null unit in list. May be Killed() */
     inline Unit *front() {
         for (std::list<Unit *>::iterator it = u.begin(); it != u.end(); ++it) {
@@ -303,6 +310,9 @@ private:
 
     /* Main collection */
     std::list<class Unit *> u;
+
+    /* See version() */
+    unsigned int modifications = 0;
 };
 
 /* Typedefs.   We really should not use them but we're lazy */
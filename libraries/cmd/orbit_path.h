@@ -0,0 +1,73 @@
+/*
+ * orbit_path.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_ORBIT_PATH_H
+#define VEGA_STRIKE_ENGINE_CMD_ORBIT_PATH_H
+
+#include "gfx_generic/vec.h"
+#include "src/vs_math.h"
+
+#include <cmath>
+
+// The ellipse a PlanetaryOrbit keeps its unit on, without the unit: where
+// the unit sits at a given angle relative to the orbit's centre, and how fast
+// it moves there. Execute() steps along it, FastForward() jumps ahead on it.
+struct OrbitPath {
+    double velocity;        // theta advances velocity / 2pi per second
+    QVector x_size;
+    QVector y_size;
+    QVector focus;
+
+    OrbitPath(double velocity, const QVector &x_size, const QVector &y_size)
+            : velocity(velocity), x_size(x_size), y_size(y_size), focus(Focus(x_size, y_size)) {
+    }
+
+    static QVector Focus(const QVector &x_size, const QVector &y_size) {
+        const double delta = x_size.Magnitude() - y_size.Magnitude();
+        if (delta == 0) {
+            return QVector(0, 0, 0);
+        } else if (delta > 0) {
+            return x_size * (delta / x_size.Magnitude());
+        } else {
+            return y_size * (-delta / y_size.Magnitude());
+        }
+    }
+
+    double AngularVelocity() const {
+        return velocity * (1.0 / (2.0 * PI));
+    }
+
+    QVector Offset(double theta) const {
+        return cos(theta) * x_size + sin(theta) * y_size - focus;
+    }
+
+    QVector Tangent(double theta) const {
+        return (cos(theta) * y_size - sin(theta) * x_size) * AngularVelocity();
+    }
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_ORBIT_PATH_H
@@ -36,11 +36,9 @@ PlanetaryOrbit::PlanetaryOrbit(Unit *p,
         const QVector &y_axis,
         const QVector &centre,
         Unit *targetunit) : Order(MOVEMENT, 0),
-        velocity(velocity),
+        path(velocity, x_axis, y_axis),
         theta(initpos),
         inittheta(initpos),
-        x_size(x_axis),
-        y_size(y_axis),
         current_orbit_frame(0) {
     for (unsigned int t = 0; t < NUM_ORBIT_AVERAGE; ++t) {
         orbiting_average[t] = QVector(0, 0, 0);
@@ -48,14 +46,6 @@ PlanetaryOrbit::PlanetaryOrbit(Unit *p,
     orbiting_last_simatom = simulation_atom_var;
     orbit_list_filled = false;
     p->SetResolveForces(false);
-    double delta = x_size.Magnitude() - y_size.Magnitude();
-    if (delta == 0) {
-        focus = QVector(0, 0, 0);
-    } else if (delta > 0) {
-        focus = x_size * (delta / x_size.Magnitude());
-    } else {
-        focus = y_size * (-delta / y_size.Magnitude());
-    }
     if (targetunit) {
         type = (MOVEMENT);
         subtype = (SSELF);
@@ -73,6 +63,45 @@ PlanetaryOrbit::~PlanetaryOrbit() {
     parent->SetResolveForces(true);
 }
 
+Unit *PlanetaryOrbit::OrbitedUnit() {
+    if (subtype & SSELF) {
+        return group.GetUnit();
+    }
+    return NULL;
+}
+
+//Closed form of what Execute() does step by step: theta advances at velocity/2pi
+//per second and the parent sits on the ellipse around the orbited unit. The
+//averaging window is restarted at the orbited unit's (already advanced) position.
+void PlanetaryOrbit::FastForward(double elapsed) {
+    if (done) {
+        return;
+    }
+    QVector origin(targetlocation);
+    QVector origin_velocity(0, 0, 0);
+    if (subtype & SSELF) {
+        Unit *unit = group.GetUnit();
+        if (!unit) {
+            return;
+        }
+        const QVector centre = unit->LocalPosition();
+        for (unsigned int o = 0; o < NUM_ORBIT_AVERAGE; ++o) {
+            orbiting_average[o] = centre;
+        }
+        orbit_list_filled = true;
+        current_orbit_frame = 0;
+        orbiting_last_simatom = simulation_atom_var;
+        origin += centre;
+        origin_velocity = unit->Velocity.Cast();
+    }
+    theta += path.AngularVelocity() * elapsed;
+
+    const QVector destination = origin + path.Offset(theta);
+    parent->SetCurPosition(destination);
+    parent->prev_physical_state.position = destination;
+    parent->Velocity = parent->cumulative_velocity = (origin_velocity + path.Tangent(theta)).Cast();
+}
+
 void PlanetaryOrbit::Execute() {
     bool mining = parent->rSize() > 1444 && parent->rSize() < 1445;
     bool done = this->done;
@@ -176,13 +205,9 @@ void PlanetaryOrbit::Execute() {
         }
         sum_orbiting_average *= 1. / (limit == 0 ? 1 : limit);
     }
-    const double div2pi = (1.0 / (2.0 * PI));
-    theta += velocity * simulation_atom_var * div2pi;
-
-    QVector x_offset = cos(theta) * x_size;
-    QVector y_offset = sin(theta) * y_size;
+    theta += path.AngularVelocity() * simulation_atom_var;
 
-    QVector destination = origin - focus + sum_orbiting_average + x_offset + y_offset;
+    QVector destination = origin + sum_orbiting_average + path.Offset(theta);
     double mag = (destination - parent->LocalPosition()).Magnitude();
     parent->Velocity = parent->cumulative_velocity =
             (((destination - parent->LocalPosition()) * (1. / simulation_atom_var)).Cast());
@@ -196,6 +221,6 @@ void PlanetaryOrbit::Execute() {
                         % this->parent->name));
         parent->Velocity.Set(0, 0, 0);
         parent->cumulative_velocity.Set(0, 0, 0);
-        parent->SetCurPosition(origin - focus + sum_orbiting_average + x_offset + y_offset);
+        parent->SetCurPosition(destination);
     }
 }
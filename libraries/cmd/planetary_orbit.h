@@ -27,18 +27,15 @@
 #define VEGA_STRIKE_ENGINE_CMD_PLANETARY_ORBIT_H
 
 #include "gfx_generic/vec.h"
+#include "cmd/orbit_path.h"
 #include "src/star_system.h"
 #include "cmd/ai/order.h"
 
 class PlanetaryOrbit : public Order {
 private:
-    double velocity;
+    OrbitPath path;
     double theta;
     double inittheta;
-
-    QVector x_size;
-    QVector y_size;
-    QVector focus;
 #define ORBIT_PRIORITY 8
 #define NUM_ORBIT_AVERAGE (SIM_QUEUE_SIZE/ORBIT_PRIORITY)
     QVector orbiting_average[NUM_ORBIT_AVERAGE];
@@ -59,6 +56,10 @@ public:
             Unit *target = NULL);
     ~PlanetaryOrbit();
     void Execute();
+///the unit this orbits around, or NULL if it orbits a fixed point
+    Unit *OrbitedUnit();
+///Moves the parent straight to where elapsed seconds of Execute() would leave it
+    void FastForward(double elapsed);
 };
 
 #endif //VEGA_STRIKE_ENGINE_CMD_PLANETARY_ORBIT_H
@@ -85,6 +85,7 @@
 
 #include <math.h>
 #include <list>
+#include <unordered_set>
 #include <cstdint>
 #include <boost/format.hpp>
 #include <random>
@@ -235,7 +236,7 @@ unsigned int apply_float_to_unsigned_int(float tmp) {
     return ans;
 }
 
-static list<Unit *> Unitdeletequeue;
+static vector<Unit *> Unitdeletequeue;
 static Hashtable<uintmax_t, Unit, 2095> deletedUn;
 int deathofvs = 1;
 
@@ -1401,22 +1402,28 @@ float Unit::ExplosionRadius() {
 }
 
 void Unit::ProcessDeleteQueue() {
+    //Reclaimed as one batch at the frame boundary. Kill() and UnRef() can
+    //both queue the same unit, so each one is only deleted once per batch.
+    //Deleting may queue more units (subunits), which go in the next batch.
+    std::unordered_set<Unit *> reclaimed;
     while (!Unitdeletequeue.empty()) {
+        vector<Unit *> batch;
+        batch.swap(Unitdeletequeue);
+        reclaimed.clear();
+        for (auto un = batch.rbegin(); un != batch.rend(); ++un) {
+            if (!reclaimed.insert(*un).second) {
+                continue;
+            }
 #ifdef DESTRUCTDEBUG
-                                                                                                                                VS_LOG_AND_FLUSH(trace, (boost::format("Eliminatin' %1$x - %2$d") % Unitdeletequeue.back() % Unitdeletequeue.size()));
-        VS_LOG_AND_FLUSH(trace, (boost::format("Eliminatin' %1$s") % Unitdeletequeue.back()->name.get().c_str()));
+            VS_LOG_AND_FLUSH(trace, (boost::format("Eliminatin' %1$s") % (*un)->name.get().c_str()));
+            if ((*un)->isSubUnit()) {
+                VS_LOG(debug, "Subunit Deleting (related to double dipping)");
+            }
 #endif
-#ifdef DESTRUCTDEBUG
-                                                                                                                                if ( Unitdeletequeue.back()->isSubUnit() ) {
-            VS_LOG(debug, "Subunit Deleting (related to double dipping)");
+            delete *un;
         }
-#endif
-        Unit *mydeleter = Unitdeletequeue.back();
-        Unitdeletequeue.pop_back();
-        delete mydeleter;                        ///might modify unitdeletequeue
-
 #ifdef DESTRUCTDEBUG
-        VS_LOG_AND_FLUSH(trace, (boost::format("Completed %1$d") % Unitdeletequeue.size()));
+        VS_LOG_AND_FLUSH(trace, (boost::format("Completed %1$d") % batch.size()));
 #endif
     }
 }
@@ -3760,6 +3767,11 @@ Vector Unit::ResolveForces(const Transformation &trans, const Matrix &transmat)
     return Movable::ResolveForces(trans, transmat);
 }
 
+void Unit::StageEnergy(EnergyStage &stage) {
+    stage.Add(reactor, drive, &shield, _Universe->isPlayerStarship(this), ecm);
+    energy_staged = true;
+}
+
 void Unit::UpdatePhysics3(const Transformation &trans,
         const Matrix &transmat,
         bool lastframe,
@@ -3781,13 +3793,18 @@ void Unit::UpdatePhysics3(const Transformation &trans,
 
 
 
-    bool is_player_ship = _Universe->isPlayerStarship(this);
+    if (energy_staged) {
+        // StarSystem already ran this unit through its EnergyStage
+        energy_staged = false;
+    } else {
+        bool is_player_ship = _Universe->isPlayerStarship(this);
 
-    reactor.Generate();
-    drive.Consume();
+        reactor.Generate();
+        drive.Consume();
 
-    shield.Regenerate(is_player_ship);
-    ecm.Consume();
+        shield.Regenerate(is_player_ship);
+        ecm.Consume();
+    }
     DecreaseWarpEnergyInWarp();
 
     if (lastframe) {
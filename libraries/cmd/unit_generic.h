@@ -89,6 +89,7 @@ void UncheckUnit( class Unit*un );
 #include "components/afterburner_upgrade.h"
 #include "components/cloak.h"
 #include "components/energy_container.h"
+#include "components/energy_stage.h"
 #include "components/reactor.h"
 #include "components/drive.h"
 #include "components/drive_upgrade.h"
@@ -613,6 +614,11 @@ public:
             Unit *superunit) override;
     bool isPlayerShip() override;
 
+    // Queue reactor, drive, shield and ECM for a batched EnergyStage::Run.
+    // UpdatePhysics3 then skips the per unit energy flow once.
+    void StageEnergy(EnergyStage &stage);
+    bool energy_staged = false;
+
 //The owner of this unit. This may not collide with owner or units owned by owner. Do not dereference (may be dead pointer)
     void *owner = nullptr;   //void ensures that it won't be referenced by accident
 
@@ -407,13 +407,17 @@ float getcolor(float c, float var) {
     return clamp01(c - var + 2 * var * grand());
 }
 
-GradColor whichGradColor(float r, unsigned int &j) {
-    unsigned int i;
+void loadStarColors() {
     if (colorGradiant.empty()) {
         vector<string> entity;
         string fullpath = "stars.txt";
         readColorGrads(entity, fullpath.c_str());
     }
+}
+
+GradColor whichGradColor(float r, unsigned int &j) {
+    unsigned int i;
+    loadStarColors();
     for (i = 1; i < colorGradiant.size(); i++) {
         if (colorGradiant[i].minrad > r) {
             break;
@@ -437,6 +441,24 @@ GFXColor getStarColorFromRadius(float radius) {
     return GFXColor(tmp.r, tmp.g, tmp.b, 1);
 }
 
+GFXColor getStarColorFromRadius(float radius, const float variation[3]) {
+    if (colorGradiant.empty()) {
+        return GFXColor(1, 1, 1, 1);
+    }
+    unsigned int i;
+    const float r = radius * game_options()->StarRadiusScale;
+    for (i = 1; i < colorGradiant.size(); i++) {
+        if (colorGradiant[i].minrad > r) {
+            break;
+        }
+    }
+    const GradColor &gc = colorGradiant[i - 1];
+    return GFXColor(clamp01(gc.r - gc.variance + 2 * gc.variance * variation[0]),
+            clamp01(gc.g - gc.variance + 2 * gc.variance * variation[1]),
+            clamp01(gc.b - gc.variance + 2 * gc.variance * variation[2]),
+            1);
+}
+
 float LengthOfYear(Vector r, Vector s) {
     float a = 2 * M_PI * mmax(r.Mag(), s.Mag());
     float speed = minspeed + (maxspeed - minspeed) * grand();
@@ -39,6 +39,8 @@
 #include <string>
 #include "root_generic/vs_globals.h"
 #include "root_generic/savegame.h"
+#include "root_generic/savegame_binary.h"
+#include "root_generic/savegame_text.h"
 #include "root_generic/load_mission.h"
 #include <algorithm>
 #include "cmd/script/mission.h"
@@ -291,6 +293,14 @@ bool isUtf8SaveGame(std::string filename) {
     boost::filesystem::path complete_path{boost::filesystem::absolute(filename_path, save_dir_path)};
     std::string path{complete_path.string()};
     std::vector<BYTE> savegame = readFile(path);
+    //only the text in front of a binary container has to be UTF-8
+    std::vector<BYTE>::iterator header_end = std::find(savegame.begin(), savegame.end(), '\n');
+    if (header_end != savegame.end()) {
+        ++header_end;
+        if (IsBinarySave(reinterpret_cast<const char *>(&*header_end), savegame.end() - header_end)) {
+            savegame.erase(header_end, savegame.end());
+        }
+    }
     Utf8Checker check;
     if (check.validUtf8(savegame)) {
         return true;
@@ -591,106 +601,18 @@ string SaveGame::WriteMissionData() {
     return ret;
 }
 
-std::string scanInString(char *&buf) {
-    std::string str;
-    while (*buf && isspace(*buf)) {
-        buf++;
-    }
-    char *start = buf;
-    while (*buf && (!isspace(*buf))) {
-        buf++;
-    }
-    str.resize(buf - start);
-    for (size_t i = 0; start < buf; ++i) {
-        str[i] = *(start++);
-    }
-    return str;
-}
-
 void SaveGame::ReadMissionData(char *&buf, bool select_data, const std::set<std::string> &select_data_filter) {
     missiondata->m.clear();
-    int mdsize;
-    char *buf2 = buf;
-    sscanf(buf2, " %d ", &mdsize);
-    //Put ptr to point after the number we just read
-    buf2 += hopto(buf2, ' ', '\n', 0);
-    for (int i = 0; i < mdsize; i++) {
-        int md_i_size;
-        string mag_num(scanInString(buf2));
-
-        // Unescape spaces within the key by replacing the special char ¬
-        {
-            for (size_t i = 0, len = mag_num.length(); i < len; ++i) {
-                if (mag_num[i] == '`') {
-                    mag_num[i] = ' ';
-                }
-            }
-        }
-
-        sscanf(buf2, "%d ", &md_i_size);
-        //Put ptr to point after the number we just read
-        buf2 += hopto(buf2, ' ', '\n', 0);
-        vector<float> *vecfloat = 0;
-        bool skip = true;
-        if (!select_data || select_data_filter.count(mag_num)) {
-            vecfloat = &missiondata->m[mag_num];
-            vecfloat->clear();
-            vecfloat->reserve(md_i_size);
-            skip = false;
-        }
-        for (int j = 0; j < md_i_size; j++) {
-            if (!skip) {
-                double float_val = atof(buf2);
-                vecfloat->push_back(float_val);
-            }
-            //Put ptr to point after the number we just read
-            buf2 += hopto(buf2, ' ', '\n', 0);
-        }
-    }
-    buf = buf2;
+    ScanMissionData(buf, select_data, select_data_filter, missiondata->m);
 }
 
 string AnyStringScanInString(char *&buf) {
-    unsigned int size = 0;
-    bool found = false;
-    while ((*buf) && ((*buf) != ' ' || (!found))) {
-        if ((*buf) >= '0' && (*buf) <= '9') {
-            size *= 10;
-            size += (*buf) - '0';
-            found = true;
-        }
-        buf++;
-    }
-    if (*buf) {
-        buf++;
-    }
-    string ret;
-    ret.resize(size);
-    unsigned int i = 0;
-    while (i < size && *buf) {
-        ret[i++] = *(buf++);
-    }
-    return ret;
-}
-
-void AnyStringSkipInString(char *&buf) {
-    unsigned int size = 0;
-    bool found = false;
-    while ((*buf) && ((*buf) != ' ' || (!found))) {
-        if ((*buf) >= '0' && (*buf) <= '9') {
-            size *= 10;
-            size += (*buf) - '0';
-            found = true;
-        }
-        buf++;
-    }
-    if (*buf) {
-        buf++;
-    }
-    unsigned int i = 0;
-    while (i < size && *buf) {
-        ++i, ++buf;
-    }
+    SaveTextScanner scanner(buf);
+    const char *start;
+    size_t length;
+    scanner.ReadCounted(start, length);
+    buf = scanner.Position();
+    return string(start, length);
 }
 
 string AnyStringWriteString(string input) {
@@ -699,45 +621,7 @@ string AnyStringWriteString(string input) {
 
 void SaveGame::ReadMissionStringData(char *&buf, bool select_data, const std::set<std::string> &select_data_filter) {
     missionstringdata->m.clear();
-    int mdsize;
-    char *buf2 = buf;
-    sscanf(buf2, " %d ", &mdsize);
-    //Put ptr to point after the number we just read
-    buf2 += hopto(buf2, ' ', '\n', 0);
-    for (int i = 0; i < mdsize; i++) {
-        int md_i_size;
-        string mag_num(AnyStringScanInString(buf2));
-        md_i_size = strtol(buf2, (char **) NULL, 10);
-
-        //Put ptr to point after the number we just read
-        buf2 += hopto(buf2, ' ', '\n', 0);
-        vector<string> *vecstring = 0;
-        bool skip = true;
-        // In rare instances (seen with wonky save game file),
-        // md_i_size can be < 0, which will cause the reserve call to fail hard
-        // Add a debug message to explain the issue and point out that the save
-        // game file is broken.
-        if (md_i_size >= 0 && (!select_data || select_data_filter.count(mag_num))) {
-            vecstring = &missionstringdata->m[mag_num];
-            vecstring->clear();
-            vecstring->reserve(md_i_size);
-            skip = false;
-        } else {
-            // debugging attempt -- show why the allocation would fail
-            VS_LOG(info,
-                   (boost::format(
-                           " SaveGame::ReadMissionStringData: vecstring->reserve(md_i_size = %1%) will fail, bailing out (i = %2%)")
-                    % md_i_size % i));
-        }
-        for (int j = 0; j < md_i_size; j++) {
-            if (skip) {
-                AnyStringSkipInString(buf2);
-            } else {
-                vecstring->push_back(AnyStringScanInString(buf2));
-            }
-        }
-    }
-    buf = buf2;
+    ScanMissionStringData(buf, select_data, select_data_filter, missionstringdata->m);
     this->PurgeZeroStarships();
 }
 
@@ -783,16 +667,20 @@ static inline void PushBackString(const string &input, vector<char> &ret) {
     PushBackChars(input.c_str(), ret);
 }
 
+static bool IsUnsavedMissionString(const string &key) {
+    //*** BLACKLIST ***
+    //Don't bother to write these out since they waste a lot of space and aren't used.
+    return key == "mission_descriptions" || key == "mission_scripts" || key == "mission_vars"
+            || key == "mission_names";
+}
+
 void SaveGame::WriteMissionStringData(std::vector<char> &ret) {
     RemoveEmpty<MissionStringDat::MSD>(missionstringdata->m);
     PushBackUInt(missionstringdata->m.size(), ret);
     for (MissionStringDat::MSD::iterator i = missionstringdata->m.begin(); i != missionstringdata->m.end(); i++) {
         const string &key = (*i).first;
         unsigned int siz = (*i).second.size();
-        if (key == "mission_descriptions" || key == "mission_scripts" || key == "mission_vars"
-            || key == "mission_names") {
-            //*** BLACKLIST ***
-            //Don't bother to write these out since they waste a lot of space and aren't used.
+        if (IsUnsavedMissionString(key)) {
             siz = 0; //Not writing them out altogether will cause saved games to break.
         }
         PushBackChars("\n", ret);
@@ -857,6 +745,200 @@ void SaveGame::ReadSavedPackets(char *&buf,
     }
 }
 
+extern bool STATIC_VARS_DESTROYED;
+
+void SaveGame::WriteBinaryMissionData(std::string &out) {
+    RemoveEmpty<MissionFloatDat::MFD>(missiondata->m);
+    SaveEncoder encoder(out);
+    encoder.PutU32(missiondata->m.size());
+    for (MissionFloatDat::MFD::iterator i = missiondata->m.begin(); i != missiondata->m.end(); ++i) {
+        encoder.PutString(i->first);
+        encoder.PutFloats(i->second);
+    }
+}
+
+void SaveGame::WriteBinaryMissionStringData(std::string &out) {
+    RemoveEmpty<MissionStringDat::MSD>(missionstringdata->m);
+    SaveEncoder encoder(out);
+    encoder.PutU32(missionstringdata->m.size());
+    for (MissionStringDat::MSD::iterator i = missionstringdata->m.begin(); i != missionstringdata->m.end(); ++i) {
+        encoder.PutString(i->first);
+        if (IsUnsavedMissionString(i->first)) {
+            encoder.PutU32(0);
+        } else {
+            encoder.PutU32(i->second.size());
+            for (const string &value : i->second) {
+                encoder.PutString(value);
+            }
+        }
+    }
+}
+
+void SaveGame::WriteBinaryNewsData(std::string &out) {
+    gameMessage last;
+    vector<gameMessage> news;
+    vector<string> newsvec;
+    newsvec.push_back("news");
+    for (int i = 0; mission->msgcenter->last(i, last, newsvec); ++i) {
+        news.push_back(last);
+    }
+    SaveEncoder encoder(out);
+    encoder.PutU32(news.size());
+    //oldest first, the order they are added back in
+    for (vector<gameMessage>::reverse_iterator i = news.rbegin(); i != news.rend(); ++i) {
+        encoder.PutString(i->message.get());
+    }
+}
+
+void SaveGame::WriteDynamicUniverseBinary(std::string &out) {
+    const string stardate = _Universe->current_stardate.GetFullTrekDate();
+    string mission_data;
+    WriteBinaryMissionData(mission_data);
+    string mission_strings;
+    WriteBinaryMissionStringData(mission_strings);
+    if (!STATIC_VARS_DESTROYED) {
+        last_written_pickled_data = PickleAllMissions();
+    }
+    //the text sections keep their terminator so they can be parsed where they lie when loading
+    string python(last_written_pickled_data.c_str(), last_written_pickled_data.length() + 1);
+    string news;
+    WriteBinaryNewsData(news);
+    const string faction_text = FactionUtil::SerializeFaction();
+    string factions(faction_text.c_str(), faction_text.length() + 1);
+
+    vector<std::pair<SaveSection, const string *> > sections;
+    sections.push_back(std::make_pair(SaveSection::stardate, &stardate));
+    sections.push_back(std::make_pair(SaveSection::mission_data, &mission_data));
+    sections.push_back(std::make_pair(SaveSection::mission_strings, &mission_strings));
+    sections.push_back(std::make_pair(SaveSection::python, &python));
+    sections.push_back(std::make_pair(SaveSection::news, &news));
+    sections.push_back(std::make_pair(SaveSection::factions, &factions));
+    WriteBinarySave(sections, out);
+}
+
+void SaveGame::ReadBinaryMissionData(const char *data,
+                                     size_t length,
+                                     bool select_data,
+                                     const std::set<std::string> &select_data_filter) {
+    missiondata->m.clear();
+    SaveDecoder decoder(data, length);
+    const uint32_t count = decoder.GetU32();
+    for (uint32_t i = 0; i < count && decoder.Ok(); ++i) {
+        string key = decoder.GetString();
+        if (!select_data || select_data_filter.count(key)) {
+            decoder.GetFloats(missiondata->m[key]);
+        } else {
+            decoder.SkipFloats();
+        }
+    }
+    if (!decoder.Ok()) {
+        VS_LOG(warning, "SaveGame::ReadBinaryMissionData: mission data is truncated");
+    }
+}
+
+void SaveGame::ReadBinaryMissionStringData(const char *data,
+                                           size_t length,
+                                           bool select_data,
+                                           const std::set<std::string> &select_data_filter) {
+    missionstringdata->m.clear();
+    SaveDecoder decoder(data, length);
+    const uint32_t count = decoder.GetU32();
+    for (uint32_t i = 0; i < count && decoder.Ok(); ++i) {
+        string key = decoder.GetString();
+        const uint32_t size = decoder.GetU32();
+        if (!select_data || select_data_filter.count(key)) {
+            vector<string> &values = missionstringdata->m[key];
+            values.clear();
+            for (uint32_t j = 0; j < size && decoder.Ok(); ++j) {
+                values.push_back(decoder.GetString());
+            }
+        } else {
+            for (uint32_t j = 0; j < size && decoder.Ok(); ++j) {
+                decoder.SkipString();
+            }
+        }
+    }
+    if (!decoder.Ok()) {
+        VS_LOG(warning, "SaveGame::ReadBinaryMissionStringData: mission string data is truncated");
+    }
+    this->PurgeZeroStarships();
+}
+
+void SaveGame::ReadBinaryNewsData(const char *data, size_t length, bool just_skip) {
+    vector<string> n00s;
+    n00s.push_back("news");
+    vector<string> nada;
+    mission->msgcenter->clear(n00s, nada);
+    SaveDecoder decoder(data, length);
+    const uint32_t count = decoder.GetU32();
+    for (uint32_t i = 0; i < count && decoder.Ok(); ++i) {
+        const string news = decoder.GetString();
+        if (!just_skip && decoder.Ok() && !news.empty()) {
+            mission->msgcenter->add("game", "news", news);
+        }
+    }
+}
+
+void SaveGame::ReadBinarySavedPackets(char *buf,
+                                      size_t length,
+                                      bool commitfactions,
+                                      bool skip_news,
+                                      bool select_data,
+                                      const std::set<std::string> &select_data_filter) {
+    vector<BinarySaveSection> sections;
+    if (!ReadBinarySave(buf, length, sections)) {
+        VS_LOG(error, "SaveGame::ReadBinarySavedPackets: unreadable savegame container version");
+        return;
+    }
+    //sections are applied in this order whatever order they were written in;
+    //the factions go last, as with the text format
+    static const SaveSection order[] = {
+            SaveSection::stardate, SaveSection::mission_data, SaveSection::mission_strings,
+            SaveSection::python, SaveSection::news, SaveSection::factions
+    };
+    for (SaveSection tag : order) {
+        for (const BinarySaveSection &section : sections) {
+            if (section.tag != tag) {
+                continue;
+            }
+            //the text sections end in a terminator and are parsed in place
+            char *text = buf + (section.data - buf);
+            const bool terminated = section.length > 0 && text[section.length - 1] == '\0';
+            switch (tag) {
+                case SaveSection::stardate:
+                    //On server side we expect the latest saved stardate in dynaverse.dat too
+                    if (commitfactions) {
+                        const string stardate(section.data, section.length);
+                        VS_LOG(info, (boost::format("Read stardate: %1%") % stardate));
+                        _Universe->current_stardate.InitTrek(stardate);
+                    }
+                    break;
+                case SaveSection::mission_data:
+                    ReadBinaryMissionData(section.data, section.length, select_data, select_data_filter);
+                    break;
+                case SaveSection::mission_strings:
+                    ReadBinaryMissionStringData(section.data, section.length, select_data, select_data_filter);
+                    break;
+                case SaveSection::python:
+                    if (terminated) {
+                        last_written_pickled_data = last_pickled_data = UnpickleAllMissions(text);
+                    }
+                    break;
+                case SaveSection::news:
+                    if (commitfactions) {
+                        ReadBinaryNewsData(section.data, section.length, skip_news);
+                    }
+                    break;
+                case SaveSection::factions:
+                    if (commitfactions && terminated) {
+                        FactionUtil::LoadSerializedFaction(text);
+                    }
+                    break;
+            }
+        }
+    }
+}
+
 void SaveGame::LoadSavedMissions() {
     unsigned int i;
     vector<string> scripts = getMissionStringData("active_scripts");
@@ -896,8 +978,6 @@ string SaveGame::WriteSavedUnit(SavedUnits *su) {
     return string("\n") + XMLSupport::tostring(su->type) + string(" ") + su->filename + " " + su->faction;
 }
 
-extern bool STATIC_VARS_DESTROYED;
-
 static char *tmprealloc(char *var, int &oldlength, int newlength) {
     if (oldlength < newlength) {
         oldlength = newlength;
@@ -1004,7 +1084,12 @@ string SaveGame::WriteSaveGame(const char *systemname,
     savestring = string("");
     VS_LOG(info, (boost::format("Writing Save Game %1%") % outputsavegame));
     savestring += WritePlayerData(FP, unitname, systemname, credits, fact);
-    savestring += WriteDynamicUniverse();
+    if (configuration()->general.binary_savegames) {
+        savestring += "\n";
+        WriteDynamicUniverseBinary(savestring);
+    } else {
+        savestring += WriteDynamicUniverse();
+    }
     if (outputsavegame.length() != 0) {
         if (write) {
             VSFile f;
@@ -1149,7 +1234,12 @@ void SaveGame::ParseSaveGame(const string &filename_p,
                     PlayerLocation = tmppos; //LaunchUnitNear(tmppos);
                 }
                 buf += headlen;
-                ReadSavedPackets(buf, commitfaction, skip_news, select_data, select_data_filter);
+                const size_t remaining = savestring.length() - headlen;
+                if (IsBinarySave(buf, remaining)) {
+                    ReadBinarySavedPackets(buf, remaining, commitfaction, skip_news, select_data, select_data_filter);
+                } else {
+                    ReadSavedPackets(buf, commitfaction, skip_news, select_data, select_data_filter);
+                }
             }
             free(freetmp2);
             freetmp2 = NULL;
@@ -72,6 +72,14 @@ class SaveGame {
             const std::set<std::string> &select_data_filter = std::set<std::string>());
     void ReadMissionStringData(char *&buf, bool select_data = false,
             const std::set<std::string> &select_data_filter = std::set<std::string>());
+    void WriteBinaryMissionData(std::string &out);
+    void WriteBinaryMissionStringData(std::string &out);
+    void WriteBinaryNewsData(std::string &out);
+    void ReadBinaryMissionData(const char *data, size_t length, bool select_data,
+            const std::set<std::string> &select_data_filter);
+    void ReadBinaryMissionStringData(const char *data, size_t length, bool select_data,
+            const std::set<std::string> &select_data_filter);
+    void ReadBinaryNewsData(const char *data, size_t length, bool just_skip);
     MissionStringDat *missionstringdata;
     MissionFloatDat *missiondata;
     std::string playerfaction;
@@ -137,8 +145,12 @@ public:
             float credits,
             std::string fact = "");
     std::string WriteDynamicUniverse();
+    ///Appends the binary container (see savegame_binary.h) with everything but the player data
+    void WriteDynamicUniverseBinary(std::string &out);
     void ReadSavedPackets(char *&buf, bool commitfaction, bool skip_news = false, bool select_data = false,
             const std::set<std::string> &select_data_filter = std::set<std::string>());
+    void ReadBinarySavedPackets(char *buf, size_t length, bool commitfaction, bool skip_news = false,
+            bool select_data = false, const std::set<std::string> &select_data_filter = std::set<std::string>());
 ///cast address to long (for 64 bits compatibility)
     void AddUnitToSave(const char *unitname, int type, const char *faction, long address);
     void RemoveUnitFromSave(long address); //cast it to a long
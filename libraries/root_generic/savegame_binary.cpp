@@ -0,0 +1,195 @@
+/*
+ * savegame_binary.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "root_generic/savegame_binary.h"
+
+#include <cstring>
+
+namespace {
+
+const char kMagic[8] = {'V', 'S', 'S', 'A', 'V', 'E', 'B', '\n'};
+const size_t kHeaderSize = sizeof(kMagic) + 2 * sizeof(uint32_t);
+
+bool LittleEndianHost() {
+    const uint32_t one = 1;
+    char first;
+    memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+void AppendU32(uint32_t value, std::string &out) {
+    const char bytes[4] = {
+            static_cast<char>(value & 0xff),
+            static_cast<char>((value >> 8) & 0xff),
+            static_cast<char>((value >> 16) & 0xff),
+            static_cast<char>((value >> 24) & 0xff)
+    };
+    out.append(bytes, 4);
+}
+
+uint32_t LoadU32(const char *data) {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8)
+            | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+} // namespace
+
+bool IsBinarySave(const char *data, size_t length) {
+    return length >= sizeof(kMagic) && memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+void WriteBinarySave(const std::vector<std::pair<SaveSection, const std::string *> > &sections, std::string &out) {
+    size_t total = kHeaderSize;
+    for (const auto &section : sections) {
+        total += 2 * sizeof(uint32_t) + section.second->size();
+    }
+    out.reserve(out.size() + total);
+    out.append(kMagic, sizeof(kMagic));
+    AppendU32(kBinarySaveVersion, out);
+    AppendU32(static_cast<uint32_t>(sections.size()), out);
+    for (const auto &section : sections) {
+        AppendU32(static_cast<uint32_t>(section.first), out);
+        AppendU32(static_cast<uint32_t>(section.second->size()), out);
+        out.append(*section.second);
+    }
+}
+
+bool ReadBinarySave(const char *data, size_t length, std::vector<BinarySaveSection> &sections) {
+    sections.clear();
+    if (!IsBinarySave(data, length) || length < kHeaderSize) {
+        return false;
+    }
+    const uint32_t version = LoadU32(data + sizeof(kMagic));
+    if (version == 0 || version > kBinarySaveVersion) {
+        return false;
+    }
+    const uint32_t count = LoadU32(data + sizeof(kMagic) + sizeof(uint32_t));
+    size_t offset = kHeaderSize;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (length - offset < 2 * sizeof(uint32_t)) {
+            break;
+        }
+        const uint32_t tag = LoadU32(data + offset);
+        const uint32_t size = LoadU32(data + offset + sizeof(uint32_t));
+        offset += 2 * sizeof(uint32_t);
+        if (length - offset < size) {
+            break;
+        }
+        sections.push_back(BinarySaveSection{static_cast<SaveSection>(tag), data + offset, size});
+        offset += size;
+    }
+    return true;
+}
+
+void SaveEncoder::PutU32(uint32_t value) {
+    AppendU32(value, out);
+}
+
+void SaveEncoder::PutString(const std::string &value) {
+    AppendU32(static_cast<uint32_t>(value.size()), out);
+    out.append(value);
+}
+
+void SaveEncoder::PutFloats(const std::vector<float> &values) {
+    AppendU32(static_cast<uint32_t>(values.size()), out);
+    if (values.empty()) {
+        return;
+    }
+    if (LittleEndianHost()) {
+        out.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(float));
+        return;
+    }
+    for (float value : values) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        AppendU32(bits, out);
+    }
+}
+
+bool SaveDecoder::Take(size_t bytes) {
+    if (!ok || static_cast<size_t>(end - cursor) < bytes) {
+        ok = false;
+        cursor = end;
+        return false;
+    }
+    return true;
+}
+
+uint32_t SaveDecoder::GetU32() {
+    if (!Take(sizeof(uint32_t))) {
+        return 0;
+    }
+    const uint32_t value = LoadU32(cursor);
+    cursor += sizeof(uint32_t);
+    return value;
+}
+
+std::string SaveDecoder::GetString() {
+    const uint32_t size = GetU32();
+    if (!Take(size)) {
+        return std::string();
+    }
+    std::string value(cursor, size);
+    cursor += size;
+    return value;
+}
+
+void SaveDecoder::SkipString() {
+    const uint32_t size = GetU32();
+    if (Take(size)) {
+        cursor += size;
+    }
+}
+
+void SaveDecoder::GetFloats(std::vector<float> &values) {
+    const uint32_t count = GetU32();
+    values.clear();
+    if (!Take(static_cast<size_t>(count) * sizeof(float))) {
+        return;
+    }
+    values.resize(count);
+    if (LittleEndianHost()) {
+        if (count) {
+            memcpy(values.data(), cursor, count * sizeof(float));
+        }
+    } else {
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t bits = LoadU32(cursor + i * sizeof(float));
+            memcpy(&values[i], &bits, sizeof(float));
+        }
+    }
+    cursor += static_cast<size_t>(count) * sizeof(float);
+}
+
+void SaveDecoder::SkipFloats() {
+    const uint32_t count = GetU32();
+    if (Take(static_cast<size_t>(count) * sizeof(float))) {
+        cursor += static_cast<size_t>(count) * sizeof(float);
+    }
+}
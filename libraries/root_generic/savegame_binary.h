@@ -0,0 +1,121 @@
+/*
+ * savegame_binary.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_SAVEGAME_BINARY_H
+#define VEGA_STRIKE_ENGINE_SAVEGAME_BINARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Binary savegame container. A save still starts with the text line of the
+// old format (system^credits^ships x y z faction), so that the quick
+// summaries of the load menu keep working, and continues with
+//
+//   magic | u32 version | u32 section count | section...
+//   section: u32 tag | u32 length | payload
+//
+// All numbers are little-endian. Sections with unknown tags are skipped, so
+// newer saves stay loadable as long as the version is not bumped.
+
+enum class SaveSection : uint32_t {
+    stardate = 1,
+    mission_data = 2,
+    mission_strings = 3,
+    python = 4,
+    news = 5,
+    factions = 6
+};
+
+const uint32_t kBinarySaveVersion = 1;
+
+struct BinarySaveSection {
+    SaveSection tag;
+    const char *data;
+    size_t length;
+};
+
+// True if data begins with a binary container
+bool IsBinarySave(const char *data, size_t length);
+
+// Appends a container made of the given sections to out
+void WriteBinarySave(const std::vector<std::pair<SaveSection, const std::string *> > &sections, std::string &out);
+
+// Lists the sections of the container at data without copying them. A
+// truncated container yields the sections that are complete; returns false if
+// data is not a container of a version this build can read.
+bool ReadBinarySave(const char *data, size_t length, std::vector<BinarySaveSection> &sections);
+
+// Builds section payloads
+class SaveEncoder {
+public:
+    explicit SaveEncoder(std::string &out) : out(out) {
+    }
+
+    void PutU32(uint32_t value);
+    void PutString(const std::string &value);
+    void PutFloats(const std::vector<float> &values);   // count, then the values
+
+private:
+    std::string &out;
+};
+
+// Reads section payloads. Every read past the end fails and leaves Ok() false
+class SaveDecoder {
+public:
+    SaveDecoder(const char *data, size_t length) : cursor(data), end(data + length), ok(true) {
+    }
+
+    bool Ok() const {
+        return ok;
+    }
+
+    const char *Position() const {
+        return cursor;
+    }
+
+    bool AtEnd() const {
+        return cursor == end;
+    }
+
+    uint32_t GetU32();
+    std::string GetString();
+    void SkipString();
+    void GetFloats(std::vector<float> &values);
+    void SkipFloats();
+
+private:
+    bool Take(size_t bytes);
+
+    const char *cursor;
+    const char *end;
+    bool ok;
+};
+
+#endif //VEGA_STRIKE_ENGINE_SAVEGAME_BINARY_H
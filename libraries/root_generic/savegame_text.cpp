@@ -0,0 +1,278 @@
+/*
+ * savegame_text.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "root_generic/savegame_text.h"
+
+#include "src/vs_logging.h"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+
+// Powers of ten a double holds exactly
+const double kExactPowersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+const int kMaxExactPower = 22;
+const uint64_t kMaxExactMantissa = uint64_t(1) << 53;
+
+inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline bool IsBlank(char c) {
+    return isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+// Decimals with up to 18 significant digits and a small exponent come out of
+// a single exact multiply or divide, which rounds the same as strtod does.
+// Anything else (hex, inf, nan, long or tiny numbers) goes to strtod.
+double ParseNumber(const char *text) {
+    const char *p = text;
+    while (IsBlank(*p)) {
+        ++p;
+    }
+    const bool negative = *p == '-';
+    if (*p == '-' || *p == '+') {
+        ++p;
+    }
+    uint64_t mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    bool any_digits = false;
+    for (; IsDigit(*p); ++p) {
+        if ((mantissa != 0 || *p != '0') && ++significant > 18) {
+            return strtod(text, NULL);
+        }
+        mantissa = mantissa * 10 + (*p - '0');
+        any_digits = true;
+    }
+    if (*p == '.') {
+        for (++p; IsDigit(*p); ++p) {
+            if ((mantissa != 0 || *p != '0') && ++significant > 18) {
+                return strtod(text, NULL);
+            }
+            mantissa = mantissa * 10 + (*p - '0');
+            --exponent;
+            any_digits = true;
+        }
+    }
+    if (!any_digits) {
+        return strtod(text, NULL);
+    }
+    if (*p == 'e' || *p == 'E') {
+        const char *q = p + 1;
+        const bool negative_exponent = *q == '-';
+        if (*q == '-' || *q == '+') {
+            ++q;
+        }
+        if (IsDigit(*q)) {
+            int written = 0;
+            for (; IsDigit(*q); ++q) {
+                if (written > 1000) {
+                    return strtod(text, NULL);
+                }
+                written = written * 10 + (*q - '0');
+            }
+            exponent += negative_exponent ? -written : written;
+            p = q;
+        }
+    }
+    // strtod must stop where we did, or it read something we did not
+    if (*p != '\0' && !IsBlank(*p)) {
+        return strtod(text, NULL);
+    }
+    if (mantissa > kMaxExactMantissa) {
+        return strtod(text, NULL);
+    }
+    double value = static_cast<double>(mantissa);
+    if (mantissa == 0) {
+    } else if (exponent < 0) {
+        if (exponent < -kMaxExactPower) {
+            return strtod(text, NULL);
+        }
+        value /= kExactPowersOfTen[-exponent];
+    } else if (exponent > kMaxExactPower) {
+        // 12e30 is 12000000000e22 as long as the mantissa stays exact
+        for (; exponent > kMaxExactPower && mantissa <= kMaxExactMantissa / 10; --exponent) {
+            mantissa *= 10;
+        }
+        if (exponent > kMaxExactPower) {
+            return strtod(text, NULL);
+        }
+        value = static_cast<double>(mantissa) * kExactPowersOfTen[exponent];
+    } else {
+        value *= kExactPowersOfTen[exponent];
+    }
+    return negative ? -value : value;
+}
+
+// The digits before the first space that follows one, read as a length
+unsigned int ScanLength(char *&cursor) {
+    unsigned int size = 0;
+    bool found = false;
+    while (*cursor && (*cursor != ' ' || !found)) {
+        if (IsDigit(*cursor)) {
+            size = size * 10 + (*cursor - '0');
+            found = true;
+        }
+        ++cursor;
+    }
+    if (*cursor) {
+        ++cursor;
+    }
+    return size;
+}
+
+} // namespace
+
+void SaveTextScanner::SkipField() {
+    while (*cursor == ' ') {
+        ++cursor;
+    }
+    while (*cursor && *cursor != ' ' && *cursor != '\n') {
+        ++cursor;
+    }
+    if (*cursor) {
+        ++cursor;
+    }
+}
+
+int SaveTextScanner::ReadCount() {
+    const int count = static_cast<int>(strtol(cursor, NULL, 10));
+    SkipField();
+    return count;
+}
+
+double SaveTextScanner::ReadNumber() {
+    const double value = ParseNumber(cursor);
+    SkipField();
+    return value;
+}
+
+void SaveTextScanner::ReadWord(const char *&start, size_t &length) {
+    while (*cursor && IsBlank(*cursor)) {
+        ++cursor;
+    }
+    start = cursor;
+    while (*cursor && !IsBlank(*cursor)) {
+        ++cursor;
+    }
+    length = cursor - start;
+}
+
+void SaveTextScanner::ReadCounted(const char *&start, size_t &length) {
+    const unsigned int size = ScanLength(cursor);
+    start = cursor;
+    unsigned int i = 0;
+    while (i < size && *cursor) {
+        ++i, ++cursor;
+    }
+    length = i;
+}
+
+void SaveTextScanner::SkipCounted() {
+    const char *start;
+    size_t length;
+    ReadCounted(start, length);
+}
+
+void ScanMissionData(char *&buf,
+                     bool select_data,
+                     const std::set<std::string> &select_data_filter,
+                     std::unordered_map<std::string, std::vector<float> > &data) {
+    SaveTextScanner scanner(buf);
+    const int count = scanner.ReadCount();
+    // One key buffer for the whole section; the map copies it only for new keys
+    std::string key;
+    for (int i = 0; i < count; ++i) {
+        const char *start;
+        size_t length;
+        scanner.ReadWord(start, length);
+        key.assign(start, length);
+        // Spaces within keys are saved as `
+        for (size_t k = 0; k < length; ++k) {
+            if (key[k] == '`') {
+                key[k] = ' ';
+            }
+        }
+        const int size = scanner.ReadCount();
+        if (!select_data || select_data_filter.count(key)) {
+            std::vector<float> &values = data[key];
+            values.resize(size > 0 ? size : 0);
+            for (int j = 0; j < size; ++j) {
+                values[j] = static_cast<float>(scanner.ReadNumber());
+            }
+        } else {
+            for (int j = 0; j < size; ++j) {
+                scanner.SkipField();
+            }
+        }
+    }
+    buf = scanner.Position();
+}
+
+void ScanMissionStringData(char *&buf,
+                           bool select_data,
+                           const std::set<std::string> &select_data_filter,
+                           std::map<std::string, std::vector<std::string> > &data) {
+    SaveTextScanner scanner(buf);
+    const int count = scanner.ReadCount();
+    std::string key;
+    for (int i = 0; i < count; ++i) {
+        const char *start;
+        size_t length;
+        scanner.ReadCounted(start, length);
+        key.assign(start, length);
+        const int size = scanner.ReadCount();
+        // In rare instances (seen with wonky save game file), size can be < 0,
+        // which means the save game file is broken
+        if (size >= 0 && (!select_data || select_data_filter.count(key))) {
+            std::vector<std::string> &values = data[key];
+            values.clear();
+            values.reserve(size);
+            for (int j = 0; j < size; ++j) {
+                scanner.ReadCounted(start, length);
+                values.emplace_back(start, length);
+            }
+        } else {
+            if (size < 0) {
+                VS_LOG(info,
+                       (boost::format(" ScanMissionStringData: entry %1% has a negative size (%2%), skipping it")
+                        % i % size));
+            }
+            for (int j = 0; j < size; ++j) {
+                scanner.SkipCounted();
+            }
+        }
+    }
+    buf = scanner.Position();
+}
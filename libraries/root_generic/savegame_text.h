@@ -0,0 +1,82 @@
+/*
+ * savegame_text.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_SAVEGAME_TEXT_H
+#define VEGA_STRIKE_ENGINE_SAVEGAME_TEXT_H
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Reads the text savegame in place. The buffer is the whole save, terminated
+// by a NUL; tokens are handed out as pointer and length into it, so nothing is
+// allocated per token. Every read matches what the old sscanf/atof/hopto code
+// made of the same bytes, malformed saves included.
+class SaveTextScanner {
+public:
+    explicit SaveTextScanner(char *cursor) : cursor(cursor) {
+    }
+
+    char *Position() const {
+        return cursor;
+    }
+
+    // Steps past the next space or newline, skipping leading spaces
+    void SkipField();
+
+    // The integer at the cursor, as strtol reads it, or 0; then skips the field
+    int ReadCount();
+
+    // The number at the cursor, as atof reads it; then skips the field
+    double ReadNumber();
+
+    // A run of non-blanks, after skipping blanks
+    void ReadWord(const char *&start, size_t &length);
+
+    // A "<length> <bytes>" string; the digits before the first space are the length
+    void ReadCounted(const char *&start, size_t &length);
+    void SkipCounted();
+
+private:
+    char *cursor;
+};
+
+// The mission data and mission string data sections. Entries not in filter
+// are skipped when select_data is set.
+void ScanMissionData(char *&buf,
+                     bool select_data,
+                     const std::set<std::string> &select_data_filter,
+                     std::unordered_map<std::string, std::vector<float> > &data);
+void ScanMissionStringData(char *&buf,
+                           bool select_data,
+                           const std::set<std::string> &select_data_filter,
+                           std::map<std::string, std::vector<std::string> > &data);
+
+#endif //VEGA_STRIKE_ENGINE_SAVEGAME_TEXT_H
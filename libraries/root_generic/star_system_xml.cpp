@@ -263,14 +263,29 @@ float ScaleOrbitDist(bool autogenerated) {
 
 extern float ScaleJumpRadius(float radius);
 
+//Finds the .system file once; file gets the name relative to the systems
+//directory, the full path is returned
+static string ResolveStarSystemFile(const string &filename, string &file, bool &autogenerated) {
+    file = VSFileSystem::GetCorrectStarSysPath(filename, autogenerated);
+    if (file.empty()) {
+        file = filename;
+    }
+    VSFile other_file;
+    return other_file.GetSystemDirectoryPath(file);
+}
+
+string GetStarSystemFullPath(const string &filename) {
+    string file;
+    bool autogenerated = false;
+    return ResolveStarSystemFile(filename, file, autogenerated);
+}
+
 void StarSystem::LoadXML(const string filename, const Vector &centroid, const float timeofyear) {
     using namespace StarXML;
     bool autogenerated = false;
     this->filename = filename;
-    string file = VSFileSystem::GetCorrectStarSysPath(filename, autogenerated);
-    if (file.empty()) {
-        file = filename;
-    }
+    string file;
+    string full_path = ResolveStarSystemFile(filename, file, autogenerated);
 
     if (game_options()->game_speed_affects_autogen_systems) {
         autogenerated = false;
@@ -293,8 +308,6 @@ void StarSystem::LoadXML(const string filename, const Vector &centroid, const fl
     xml->reflectivity = game_options()->reflectivity;
     xml->unitlevel = 0;
 
-    VSFile other_file;
-    string full_path = other_file.GetSystemDirectoryPath(file);
     SystemFactory sys = SystemFactory(file, full_path, xml);
 
     for (auto &unit : xml->moons) {
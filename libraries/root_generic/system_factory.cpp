@@ -40,21 +40,21 @@
 #include "cmd/building.h"
 #include "cmd/planetary_orbit.h"
 #include "root_generic/atmospheric_fog_mesh.h"
+#include "root_generic/system_preloader.h"
+#include "src/vs_logging.h"
 
 
 #include "cmd/cont_terrain.h"
 
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
 #include <boost/algorithm/string.hpp>
-#include <boost/foreach.hpp>
+#include <boost/format.hpp>
 #include <string>
 #include <map>
 #include <vector>
 #include <iostream>
+#include <fstream>
 #include <sstream>
 
-namespace pt = boost::property_tree;
 namespace alg = boost::algorithm;
 
 using std::string;
@@ -109,93 +109,120 @@ string truncateFilename(string filename) {
     return filename;
 }
 
-SystemFactory::SystemFactory(string const &relative_filename, string &system_file, Star_XML *xml) {
-    root = Object();
-    root.type = ("root");
-
+SystemFactory::SystemFactory(string const &relative_filename, string &system_file, Star_XML *xml) : xml(xml) {
     this->fullname = truncateFilename(relative_filename);
 
-    pt::ptree tree;
-    pt::read_xml(system_file, tree);
-    recursiveParse(tree, root);
-    recursiveProcess(xml, root, nullptr);
+    owners.push_back(nullptr);
+
+    // Parsed ahead of time on a worker thread, e.g. during a jump countdown
+    std::unique_ptr<RecordedSystemXML> preloaded = SystemPreloader::Take(system_file);
+    if (preloaded) {
+        preloaded->replay(*this);
+        return;
+    }
+
+    std::ifstream stream(system_file, std::ios::binary);
+    string error;
+    if (!stream) {
+        VS_LOG(error, (boost::format("Failed to open system file %1%") % system_file));
+    } else if (!ParseSystemXML(stream, *this, &error)) {
+        VS_LOG(error, (boost::format("Failed to parse system file %1%: %2%") % system_file % error));
+    }
 }
 
-void SystemFactory::recursiveParse(pt::ptree tree, Object &object) {
-    for (const auto &iterator : tree) {
-        Object inner_object = Object();
-        inner_object.type = iterator.first;
-
-        // Process attributes
-        if (inner_object.type == "<xmlattr>") {
-            for (const auto &attributes_iterator : iterator.second) {
-                string key = attributes_iterator.first.data();
-                string value = attributes_iterator.second.data();
-                alg::to_lower(key); // to avoid various bugs, we turn all keys to lowercase
-                object.attributes[key] = value;
-            }
-
-            // We've already processed the children
-            continue;
-        }
+// Elements are handled in document order when they open, parents before
+// their children, which is what the old tree walk did. The planet an element
+// is attached to (its owner) is the nearest enclosing planet or jump point.
+void SystemFactory::beginElement(SystemElement element, const SystemAttributes &attributes, int level) {
+    const SystemElement parent = elements.empty() ? SystemElement::unknown : elements.back();
+    Planet *owner = owners.back();
+    const Object object{element, attributes};
 
-        // Process children
-        if (!iterator.second.empty()) {
-            recursiveParse(iterator.second, inner_object);
-        }
+    elements.push_back(element);
 
-        object.objects.push_back(inner_object);
+    // Children of light only carry its colors
+    if (parent == SystemElement::light) {
+        processLightColor(object);
+        owners.push_back(owner);
+        return;
+    }
+    // Nothing inside a light is a system object
+    for (size_t i = 0; i + 1 < elements.size(); ++i) {
+        if (elements[i] == SystemElement::light) {
+            owners.push_back(owner);
+            return;
+        }
     }
-}
 
-void SystemFactory::recursiveProcess(Star_XML *xml, Object &object, Planet *owner, int level) {
     xml->unitlevel = level;
 
-    if (boost::iequals(object.type, "light")) {
-        processLight(object);
-        return; // We don't bother processing children of light, as it's done in processLight
-    } else if (boost::iequals(object.type, "system")) {
-        processSystem(xml, object);
-    } else if (boost::iequals(object.type, "ring")) {
-        processRing(xml, object, owner);
-    } else if (boost::iequals(object.type, "SpaceElevator")) {
-        processSpaceElevator(object, owner);
-    } else if (boost::iequals(object.type, "planet") || boost::iequals(object.type, "jump")) {
-        owner = processPlanet(xml, object, owner);
-    } else if (boost::iequals(object.type, "fog")) {
-        processFog(xml, object, owner);
-    } else if (boost::iequals(object.type, "unit") || boost::iequals(object.type, "asteroid") ||
-            boost::iequals(object.type, "enhancement") || boost::iequals(object.type, "vehicle") ||
-            boost::iequals(object.type, "building")) {
-        processEnhancement(object.type, xml, object, owner);
-    }
-
-    // Now we process children
-    for (auto &child_object : object.objects) {
-        recursiveProcess(xml, child_object, owner, level + 1);
-    }
+    if (parent == SystemElement::fog) {
+        processFogElement(xml, object);
+    }
+
+    switch (element) {
+        case SystemElement::light:
+            current_light = Light();
+            break;
+        case SystemElement::system:
+            processSystem(xml, object);
+            break;
+        case SystemElement::ring:
+            processRing(xml, object, owner);
+            break;
+        case SystemElement::space_elevator:
+            processSpaceElevator(object, owner);
+            break;
+        case SystemElement::planet:
+        case SystemElement::jump:
+            owner = processPlanet(xml, object, owner);
+            break;
+        case SystemElement::fog:
+            processFog(xml, object);
+            break;
+        case SystemElement::unit:
+        case SystemElement::asteroid:
+        case SystemElement::enhancement:
+        case SystemElement::vehicle:
+        case SystemElement::building:
+            processEnhancement(element, xml, object, owner);
+            break;
+        default:
+            break;
+    }
+
+    owners.push_back(owner);
 }
 
-void SystemFactory::processLight(Object &object) {
-    Light light;
-    for (const auto &child_object : object.objects) {
-        GFXColor color = initializeColor(child_object);
+void SystemFactory::endElement(SystemElement element, int level) {
+    elements.pop_back();
+    owners.pop_back();
 
-        if (child_object.type == "diffuse") {
-            light.diffuse = color;
-        }
-        if (child_object.type == "specular") {
-            light.specular = color;
-        }
-        if (child_object.type == "ambient") {
-            light.ambient = color;
+    if (element == SystemElement::light) {
+        lights.push_back(current_light);
+    } else if (element == SystemElement::fog) {
+        Planet *owner = owners.back();
+        if (game_options()->usePlanetFog && owner != nullptr) {
+            owner->AddFog(xml->fog, xml->fogopticalillusion);
         }
     }
+}
 
-    lights.push_back(light);
+void SystemFactory::processLightColor(const Object &object) {
+    GFXColor color = initializeColor(object);
+
+    if (object.type == SystemElement::diffuse) {
+        current_light.diffuse = color;
+    }
+    if (object.type == SystemElement::specular) {
+        current_light.specular = color;
+    }
+    if (object.type == SystemElement::ambient) {
+        current_light.ambient = color;
+    }
 }
 
-void SystemFactory::processSystem(Star_XML *xml, Object &object) {
+void SystemFactory::processSystem(Star_XML *xml, const Object &object) {
     xml->name = getStringAttribute(object, "name");
     xml->backgroundname = getStringAttribute(object, "background");
     xml->scale *= getFloatAttribute(object, "ScaleSystem"); // Size multiplier of planets, rings and some other units
@@ -209,7 +236,7 @@ void SystemFactory::processSystem(Star_XML *xml, Object &object) {
 //    xml->backgroundColor.a = std::stof(backgroundColor["a"]);
 }
 
-void SystemFactory::processRing(Star_XML *xml, Object &object, Planet *owner) {
+void SystemFactory::processRing(Star_XML *xml, const Object &object, Planet *owner) {
     BLENDFUNC blend_source = SRCALPHA;
     BLENDFUNC blend_destination = INVSRCALPHA;
     initializeAlpha(object, blend_source, blend_destination);
@@ -246,7 +273,7 @@ void SystemFactory::processRing(Star_XML *xml, Object &object, Planet *owner) {
     }
 }
 
-Planet *SystemFactory::processPlanet(Star_XML *xml, Object &object, Planet *owner) {
+Planet *SystemFactory::processPlanet(Star_XML *xml, const Object &object, Planet *owner) {
     QVector S(0, 1, 0);
     QVector R(0, 0, 1);
 
@@ -312,7 +339,7 @@ Planet *SystemFactory::processPlanet(Star_XML *xml, Object &object, Planet *owne
 
     // Parse destinations (jump only?)
     if (object.attributes.count("destination")) {
-        destination = ParseDestinations(object.attributes["destination"]);
+        destination = ParseDestinations(object.attributes.at("destination"));
         isDestination = true;
     }
 
@@ -323,7 +350,7 @@ Planet *SystemFactory::processPlanet(Star_XML *xml, Object &object, Planet *owne
     if (object.attributes.count("light")) {
         unsigned long index = 0;
         char local = 0;
-        std::istringstream stream(object.attributes["light"]);
+        std::istringstream stream(object.attributes.at("light"));
         stream >> index >> local;
 
         Light light = lights[index];
@@ -342,7 +369,7 @@ Planet *SystemFactory::processPlanet(Star_XML *xml, Object &object, Planet *owne
     if (object.attributes.count("faction")) {
         int originalowner =
                 FactionUtil::GetFactionIndex(UniverseUtil::GetGalaxyProperty(this->fullname, "faction"));
-        faction = FactionUtil::GetFactionIndex(object.attributes["faction"]);
+        faction = FactionUtil::GetFactionIndex(object.attributes.at("faction"));
         if (faction == originalowner) {
             int ownerfaction = FactionUtil::GetFactionIndex(UniverseUtil::GetGalaxyFaction(this->fullname));
             faction = ownerfaction;
@@ -369,7 +396,7 @@ Planet *SystemFactory::processPlanet(Star_XML *xml, Object &object, Planet *owne
     xml->cursun.k = getFloatAttribute(object, "z", xml->cursun.k, float_scales_product);
 
     if (object.attributes.count("override")) {
-        string value = object.attributes["override"];
+        string value = object.attributes.at("override");
         string::size_type eqpos = value.find_first_of('=');
         if (eqpos != string::npos) {
             string name = value.substr(0, eqpos);
@@ -426,7 +453,7 @@ Planet *SystemFactory::processPlanet(Star_XML *xml, Object &object, Planet *owne
     return planet;
 }
 
-void SystemFactory::processSpaceElevator(Object &object, Planet *owner) {
+void SystemFactory::processSpaceElevator(const Object &object, Planet *owner) {
     string myfile = getStringAttribute(object, "file", "elevator");
     string varname = getStringAttribute(object, "varname");
     float varvalue = getFloatAttribute(object, "varvalue", 0.0f);
@@ -445,7 +472,7 @@ void SystemFactory::processSpaceElevator(Object &object, Planet *owner) {
     // Faction
     string faction(UniverseUtil::GetGalaxyFaction(fullname));
     if (object.attributes.count("faction")) {
-        faction = object.attributes["faction"];
+        faction = object.attributes.at("faction");
         if (faction == UniverseUtil::GetGalaxyProperty(fullname, "faction")) {
             string ownerfaction = UniverseUtil::GetGalaxyFaction(fullname);
             faction = ownerfaction;
@@ -457,7 +484,8 @@ void SystemFactory::processSpaceElevator(Object &object, Planet *owner) {
     }
 }
 
-void SystemFactory::processFog(Star_XML *xml, Object &object, Planet *owner) {
+// The meshes are handed to the owner once the fog element closes, see endElement
+void SystemFactory::processFog(Star_XML *xml, const Object &object) {
     if (!game_options()->usePlanetFog) {
         return;
     }
@@ -465,43 +493,46 @@ void SystemFactory::processFog(Star_XML *xml, Object &object, Planet *owner) {
     // TODO: we no longer need to use xml->fog for this
     xml->fogopticalillusion = getBoolAttribute(object, "fog", true);
     xml->fog.clear();
+    fog_attributes = object.attributes;
+}
 
-    for (const auto &child_object : object.objects) {
-        AtmosphericFogMesh fogMesh = AtmosphericFogMesh();
-        fogMesh.meshname = getStringAttribute(object, "file");
-        fogMesh.scale = 1.1 - .075 + .075 * (xml->fog.size() + 1);
+void SystemFactory::processFogElement(Star_XML *xml, const Object &child_object) {
+    if (!game_options()->usePlanetFog) {
+        return;
+    }
 
-        initializeColor(child_object);
+    const Object object{SystemElement::fog, fog_attributes};
 
-        fogMesh.er = getFloatAttribute(object, "red", fogMesh.er);
-        fogMesh.eg = getFloatAttribute(object, "green", fogMesh.eg);
-        fogMesh.eb = getFloatAttribute(object, "blue", fogMesh.eb);
-        fogMesh.ea = getFloatAttribute(object, "alfa", fogMesh.ea);
-        fogMesh.ea = getFloatAttribute(object, "alpha", fogMesh.ea);
+    AtmosphericFogMesh fogMesh = AtmosphericFogMesh();
+    fogMesh.meshname = getStringAttribute(object, "file");
+    fogMesh.scale = 1.1 - .075 + .075 * (xml->fog.size() + 1);
 
-        fogMesh.dr = getFloatAttribute(object, "dred", fogMesh.dr);
-        fogMesh.dg = getFloatAttribute(object, "dgreen", fogMesh.dg);
-        fogMesh.db = getFloatAttribute(object, "dblue", fogMesh.db);
-        fogMesh.da = getFloatAttribute(object, "dalfa", fogMesh.da);
-        fogMesh.da = getFloatAttribute(object, "dalpha", fogMesh.da);
+    initializeColor(child_object);
 
-        fogMesh.min_alpha = static_cast<int>(getFloatAttribute(object, "minalpha", fogMesh.min_alpha)) * 255;
-        fogMesh.max_alpha = static_cast<int>(getFloatAttribute(object, "maxalpha", fogMesh.max_alpha)) * 255;
-        fogMesh.concavity = getDoubleAttribute(object, "concavity");
-        fogMesh.focus = getDoubleAttribute(object, "focus", fogMesh.focus);
-        fogMesh.tail_mode_start = getIntAttribute(object, "TailModeStart", fogMesh.tail_mode_start);
-        fogMesh.tail_mode_end = getIntAttribute(object, "TailModeEnd", fogMesh.tail_mode_end);
-        fogMesh.scale = getDoubleAttribute(object, "ScaleAtmosphereHeight", fogMesh.scale);
+    fogMesh.er = getFloatAttribute(object, "red", fogMesh.er);
+    fogMesh.eg = getFloatAttribute(object, "green", fogMesh.eg);
+    fogMesh.eb = getFloatAttribute(object, "blue", fogMesh.eb);
+    fogMesh.ea = getFloatAttribute(object, "alfa", fogMesh.ea);
+    fogMesh.ea = getFloatAttribute(object, "alpha", fogMesh.ea);
 
-        xml->fog.push_back(AtmosphericFogMesh());
-    }
+    fogMesh.dr = getFloatAttribute(object, "dred", fogMesh.dr);
+    fogMesh.dg = getFloatAttribute(object, "dgreen", fogMesh.dg);
+    fogMesh.db = getFloatAttribute(object, "dblue", fogMesh.db);
+    fogMesh.da = getFloatAttribute(object, "dalfa", fogMesh.da);
+    fogMesh.da = getFloatAttribute(object, "dalpha", fogMesh.da);
 
-    if (owner != nullptr) {
-        owner->AddFog(xml->fog, xml->fogopticalillusion);
-    }
+    fogMesh.min_alpha = static_cast<int>(getFloatAttribute(object, "minalpha", fogMesh.min_alpha)) * 255;
+    fogMesh.max_alpha = static_cast<int>(getFloatAttribute(object, "maxalpha", fogMesh.max_alpha)) * 255;
+    fogMesh.concavity = getDoubleAttribute(object, "concavity");
+    fogMesh.focus = getDoubleAttribute(object, "focus", fogMesh.focus);
+    fogMesh.tail_mode_start = getIntAttribute(object, "TailModeStart", fogMesh.tail_mode_start);
+    fogMesh.tail_mode_end = getIntAttribute(object, "TailModeEnd", fogMesh.tail_mode_end);
+    fogMesh.scale = getDoubleAttribute(object, "ScaleAtmosphereHeight", fogMesh.scale);
+
+    xml->fog.push_back(AtmosphericFogMesh());
 }
 
-void SystemFactory::processEnhancement(string element, Star_XML *xml, Object &object, Planet *owner) {
+void SystemFactory::processEnhancement(SystemElement element, Star_XML *xml, const Object &object, Planet *owner) {
     QVector S(0, 1, 0);
     QVector R(0, 0, 1);
 
@@ -531,7 +562,7 @@ void SystemFactory::processEnhancement(string element, Star_XML *xml, Object &ob
 
     // Parse destinations (jump only?)
     if (object.attributes.count("destination")) {
-        destinations = ParseDestinations(object.attributes["destination"]);
+        destinations = ParseDestinations(object.attributes.at("destination"));
     }
 
     // Parse faction
@@ -540,7 +571,7 @@ void SystemFactory::processEnhancement(string element, Star_XML *xml, Object &ob
     if (object.attributes.count("faction")) {
         int originalowner = FactionUtil::GetFactionIndex(
                 UniverseUtil::GetGalaxyProperty(this->fullname, "faction"));
-        faction = FactionUtil::GetFactionIndex(object.attributes["faction"]);
+        faction = FactionUtil::GetFactionIndex(object.attributes.at("faction"));
         if (faction == originalowner) {
             int ownerfaction = FactionUtil::GetFactionIndex(UniverseUtil::GetGalaxyFaction(this->fullname));
             faction = ownerfaction;
@@ -568,9 +599,7 @@ void SystemFactory::processEnhancement(string element, Star_XML *xml, Object &ob
         velocity = 2.0 * M_PI / (game_options()->YearScale * velocity);
     }
 
-    if (boost::iequals(element, "nebula")) {
-        return;
-    } // Nebula not supported at present
+    // Nebula not supported at present
 
 
     // This condition is probably never met
@@ -582,7 +611,7 @@ void SystemFactory::processEnhancement(string element, Star_XML *xml, Object &ob
     // I've refactored it to reduce complexity and improve readability
     Unit *unit = nullptr;
 
-    if (boost::iequals(element, "unit")) {
+    if (element == SystemElement::unit) {
         Flightgroup *fg = getStaticBaseFlightgroup(faction);
         unit = new Unit(filename.c_str(), false, faction, "", fg, fg->nr_ships - 1);
         unit->setFullname(fullname);
@@ -592,7 +621,7 @@ void SystemFactory::processEnhancement(string element, Star_XML *xml, Object &ob
             unit->SetTurretAI(); //FIXME un de-referenced before allocation
             unit->EnqueueAI(new Orders::FireAt(configuration()->ai.firing.aggressivity)); //FIXME un de-referenced before allocation
         }
-    } else if (boost::iequals(element, "asteroid")) {
+    } else if (element == SystemElement::asteroid) {
         Flightgroup *fg = getStaticAsteroidFlightgroup(faction);
         unit = static_cast<Unit *>(
                 new Asteroid(filename.c_str(),
@@ -602,18 +631,18 @@ void SystemFactory::processEnhancement(string element, Star_XML *xml, Object &ob
             SetSubunitRotation(unit, absolute_scalex);
         } //FIXME un de-referenced before allocation
 
-    } else if (boost::iequals(element, "enhancement")) {
+    } else if (element == SystemElement::enhancement) {
         unit = static_cast<Unit *>(
                 new Enhancement(filename.c_str(), faction, string("")));
 
-    } else if (boost::iequals(element, "building") ||
-            boost::iequals(element, "vehicle")) {
+    } else if (element == SystemElement::building ||
+            element == SystemElement::vehicle) {
 
         if (xml->ct == nullptr && xml->parentterrain != nullptr) { // Terrain
-            unit = new Building(xml->parentterrain, boost::iequals(element, "vehicle"),
+            unit = new Building(xml->parentterrain, element == SystemElement::vehicle,
                     filename.c_str(), false, faction, string(""));
         } else if (xml->ct != nullptr) { // Continuous terrain
-            unit = new Building(xml->ct, boost::iequals(element, "vehicle"),
+            unit = new Building(xml->ct, element == SystemElement::vehicle,
                     filename.c_str(), false, faction, string(""));
         }
 
@@ -655,36 +684,36 @@ void SystemFactory::processEnhancement(string element, Star_XML *xml, Object &ob
 // However, we would still need to specialize the string conversion (e.g. std:stof)
 // More important, this is dangerous. Changing T would change the function called and
 // this would not be obvious to somewhat not familiar with the code.
-string SystemFactory::getStringAttribute(Object object, string key, string default_value) {
+string SystemFactory::getStringAttribute(const Object &object, string key, string default_value) {
     alg::to_lower(key);
     if (object.attributes.count(key)) {
-        return object.attributes[key];
+        return object.attributes.at(key);
     }
     return default_value;
 }
 
-bool SystemFactory::getBoolAttribute(Object object, string key, bool default_value) {
+bool SystemFactory::getBoolAttribute(const Object &object, string key, bool default_value) {
     alg::to_lower(key);
     if (object.attributes.count(key)) {
-        return object.attributes[key] == "true";
+        return object.attributes.at(key) == "true";
     }
     return default_value;
 }
 
-char SystemFactory::getCharAttribute(Object object, string key, char default_value) {
+char SystemFactory::getCharAttribute(const Object &object, string key, char default_value) {
     alg::to_lower(key);
-    if (object.attributes.count(key) && object.attributes[key].size() > 0) {
-        return object.attributes[key][0];
+    if (object.attributes.count(key) && object.attributes.at(key).size() > 0) {
+        return object.attributes.at(key)[0];
     }
     return default_value;
 }
 
-int SystemFactory::getIntAttribute(Object object, string key, int default_value,
+int SystemFactory::getIntAttribute(const Object &object, string key, int default_value,
         int multiplier, int default_multiplier) {
     alg::to_lower(key);
     if (object.attributes.count(key)) {
         try {
-            return std::stoi(object.attributes[key]) * multiplier;
+            return std::stoi(object.attributes.at(key)) * multiplier;
         } catch (std::invalid_argument&) {
             return default_value * default_multiplier;
         }
@@ -692,12 +721,12 @@ int SystemFactory::getIntAttribute(Object object, string key, int default_value,
     return default_value * default_multiplier;
 }
 
-float SystemFactory::getFloatAttribute(Object object, string key, float default_value,
+float SystemFactory::getFloatAttribute(const Object &object, string key, float default_value,
         float multiplier, float default_multiplier) {
     alg::to_lower(key);
     if (object.attributes.count(key)) {
         try {
-            return std::stof(object.attributes[key]) * multiplier;
+            return std::stof(object.attributes.at(key)) * multiplier;
         } catch (std::invalid_argument&) {
             return default_value * default_multiplier;
         }
@@ -705,12 +734,12 @@ float SystemFactory::getFloatAttribute(Object object, string key, float default_
     return default_value * default_multiplier;
 }
 
-double SystemFactory::getDoubleAttribute(Object object, string key, double default_value,
+double SystemFactory::getDoubleAttribute(const Object &object, string key, double default_value,
         double multiplier, double default_multiplier) {
     alg::to_lower(key);
     if (object.attributes.count(key)) {
         try {
-            return std::stod(object.attributes[key]) * multiplier;
+            return std::stod(object.attributes.at(key)) * multiplier;
         } catch (std::invalid_argument&) {
             return default_value * default_multiplier;
         }
@@ -718,13 +747,13 @@ double SystemFactory::getDoubleAttribute(Object object, string key, double defau
     return default_value * default_multiplier;
 }
 
-void SystemFactory::initializeQVector(Object object, string key_prefix, QVector &vector, double multiplier) {
+void SystemFactory::initializeQVector(const Object &object, string key_prefix, QVector &vector, double multiplier) {
     vector.i = getDoubleAttribute(object, key_prefix + "i", vector.i, multiplier);
     vector.j = getDoubleAttribute(object, key_prefix + "j", vector.j, multiplier);
     vector.k = getDoubleAttribute(object, key_prefix + "k", vector.k, multiplier);
 }
 
-void SystemFactory::initializeMaterial(Object object, GFXMaterial &material) {
+void SystemFactory::initializeMaterial(const Object &object, GFXMaterial &material) {
     material.er = getFloatAttribute(object, "Red", material.er);
     material.eg = getFloatAttribute(object, "Green", material.eg);
     material.eb = getFloatAttribute(object, "Blue", material.eb);
@@ -746,7 +775,7 @@ void SystemFactory::initializeMaterial(Object object, GFXMaterial &material) {
 // If we do but it's invalid, we use ONE/ZERO
 // Otherwise we actually parse it
 // This doesn't seem right
-void SystemFactory::initializeAlpha(Object object, BLENDFUNC blend_source, BLENDFUNC blend_destination) {
+void SystemFactory::initializeAlpha(const Object &object, BLENDFUNC blend_source, BLENDFUNC blend_destination) {
     if (!object.attributes.count("alpha")) {
         return;
     }
@@ -754,7 +783,7 @@ void SystemFactory::initializeAlpha(Object object, BLENDFUNC blend_source, BLEND
     blend_source = ONE;
     blend_destination = ZERO;
 
-    const char *alpha = object.attributes["alpha"].c_str();
+    const char *alpha = object.attributes.at("alpha").c_str();
     if (alpha == nullptr || alpha[0] == 0) {
         return;
     } // This is really only a check for an empty string. Refactor?
@@ -776,7 +805,7 @@ void SystemFactory::initializeAlpha(Object object, BLENDFUNC blend_source, BLEND
     free(d);
 }
 
-GFXColor SystemFactory::initializeColor(Object object) {
+GFXColor SystemFactory::initializeColor(const Object &object) {
     return GFXColor(getFloatAttribute(object, "red", 0),
             getFloatAttribute(object, "green", 0),
             getFloatAttribute(object, "blue", 0),
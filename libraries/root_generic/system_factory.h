@@ -30,11 +30,11 @@
 
 #include "gfx_generic/vec.h"
 #include "src/gfxlib_struct.h"
+#include "root_generic/system_xml_stream.h"
 
 #include <string>
 #include <vector>
 #include <map>
-#include <boost/property_tree/ptree.hpp>
 
 using std::string;
 using std::map;
@@ -44,15 +44,15 @@ using std::vector;
 struct Star_XML;
 class Planet;
 
-class SystemFactory {
+// Builds a star system while the .system file is being streamed in.
+// Each element is handled as soon as it is opened, so there is no
+// intermediate tree of the whole file.
+class SystemFactory : public SystemXMLHandler {
     struct Object {
-        string type;
-        map<string, string> attributes;
-        vector<Object> objects;
+        SystemElement type;
+        const SystemAttributes &attributes;
     };
 
-    Object root;
-
     struct Color {
         double red;
         double green;
@@ -68,6 +68,13 @@ class SystemFactory {
 
     vector<Light> lights;
 
+    // Parse state
+    Star_XML *xml;
+    vector<SystemElement> elements;
+    vector<Planet *> owners;
+    Light current_light;
+    SystemAttributes fog_attributes;
+
 public:
     // Fields
     string name;
@@ -81,34 +88,34 @@ public:
     // Constructor
     SystemFactory(string const &relative_filename, string &system_file, Star_XML *xml);
 
-    void recursiveParse(boost::property_tree::ptree tree, Object &object);
-    void recursiveProcess(Star_XML *xml, Object &object, Planet *owner, int level = 0);
-
-    void processLight(Object &object);
-    void processSystem(Star_XML *xml, Object &object);
-    void processRing(Star_XML *xml, Object &object, Planet *owner);
-    Planet *processPlanet(Star_XML *xml, Object &object, Planet *owner);
-    void processSpaceElevator(Object &object, Planet *owner);
-    void processFog(Star_XML *xml, Object &object, Planet *owner);
-    void processEnhancement(string element, Star_XML *xml, Object &object, Planet *owner);
-    void processAsteroid(Star_XML *xml, Object &object, Planet *owner);
-
-    string getStringAttribute(Object object, string key, string default_value = "");
-    bool getBoolAttribute(Object object, string key, bool default_value = true);
-    char getCharAttribute(Object object, string key, char default_value);
-    int getIntAttribute(Object object, string key, int default_value = 1,
+    void beginElement(SystemElement element, const SystemAttributes &attributes, int level) override;
+    void endElement(SystemElement element, int level) override;
+
+    void processLightColor(const Object &object);
+    void processSystem(Star_XML *xml, const Object &object);
+    void processRing(Star_XML *xml, const Object &object, Planet *owner);
+    Planet *processPlanet(Star_XML *xml, const Object &object, Planet *owner);
+    void processSpaceElevator(const Object &object, Planet *owner);
+    void processFog(Star_XML *xml, const Object &object);
+    void processFogElement(Star_XML *xml, const Object &object);
+    void processEnhancement(SystemElement element, Star_XML *xml, const Object &object, Planet *owner);
+
+    string getStringAttribute(const Object &object, string key, string default_value = "");
+    bool getBoolAttribute(const Object &object, string key, bool default_value = true);
+    char getCharAttribute(const Object &object, string key, char default_value);
+    int getIntAttribute(const Object &object, string key, int default_value = 1,
             int multiplier = 1, int default_multiplier = 1);
-    float getFloatAttribute(Object object, string key, float default_value = 1.0f,
+    float getFloatAttribute(const Object &object, string key, float default_value = 1.0f,
             float multiplier = 1.0f, float default_multiplier = 1.0f);
-    double getDoubleAttribute(Object object, string key, double default_value = 1.0,
+    double getDoubleAttribute(const Object &object, string key, double default_value = 1.0,
             double multiplier = 1.0, double default_multiplier = 1.0);
 
-    void initializeQVector(Object object, string key_prefix, QVector &vector,
+    void initializeQVector(const Object &object, string key_prefix, QVector &vector,
             double multiplier = 1.0);
-    void initializeMaterial(Object object, GFXMaterial &material);
-    void initializeAlpha(Object object, BLENDFUNC blend_source,
+    void initializeMaterial(const Object &object, GFXMaterial &material);
+    void initializeAlpha(const Object &object, BLENDFUNC blend_source,
             BLENDFUNC blend_destination);
-    GFXColor initializeColor(Object object);
+    GFXColor initializeColor(const Object &object);
 };
 
 #endif //VEGA_STRIKE_ENGINE_SYSTEM_FACTORY_H
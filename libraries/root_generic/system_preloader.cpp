@@ -0,0 +1,113 @@
+/*
+ * system_preloader.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "root_generic/system_preloader.h"
+#include "src/vs_logging.h"
+#include "src/vs_thread_pool.h"
+
+#include <boost/format.hpp>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <map>
+#include <mutex>
+
+namespace SystemPreloader {
+
+namespace {
+
+struct Pending {
+    std::future<std::unique_ptr<RecordedSystemXML>> loading;
+    std::unique_ptr<RecordedSystemXML> recording;
+    bool loaded = false;
+    int requests = 0;
+};
+
+std::mutex pending_mutex;
+std::map<std::string, Pending> pending;
+
+std::unique_ptr<RecordedSystemXML> load(const std::string &full_path) {
+    std::unique_ptr<RecordedSystemXML> recording(new RecordedSystemXML());
+    std::ifstream stream(full_path, std::ios::binary);
+    if (!stream || !ParseSystemXML(stream, *recording)) {
+        return nullptr;
+    }
+    return recording;
+}
+
+} // namespace
+
+void Request(const std::string &full_path) {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    Pending &entry = pending[full_path];
+    if (entry.requests++ > 0) {
+        return;
+    }
+    VS_LOG(info, (boost::format("Preloading star system %1%") % full_path));
+    entry.loading = VegaStrike::SubmitWork([full_path]() {
+        return load(full_path);
+    });
+}
+
+bool Failed(const std::string &full_path) {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    auto iterator = pending.find(full_path);
+    if (iterator == pending.end()) {
+        return false;
+    }
+    Pending &entry = iterator->second;
+    if (!entry.loaded && entry.loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        entry.recording = entry.loading.get();
+        entry.loaded = true;
+    }
+    return entry.loaded && !entry.recording;
+}
+
+void Cancel(const std::string &full_path) {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    auto iterator = pending.find(full_path);
+    if (iterator != pending.end() && --iterator->second.requests <= 0) {
+        pending.erase(iterator);
+    }
+}
+
+std::unique_ptr<RecordedSystemXML> Take(const std::string &full_path) {
+    Pending entry;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        auto iterator = pending.find(full_path);
+        if (iterator == pending.end()) {
+            return nullptr;
+        }
+        entry = std::move(iterator->second);
+        pending.erase(iterator);
+    }
+    return entry.loaded ? std::move(entry.recording) : entry.loading.get();
+}
+
+} // namespace SystemPreloader
@@ -0,0 +1,58 @@
+/*
+ * system_preloader.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_SYSTEM_PRELOADER_H
+#define VEGA_STRIKE_ENGINE_SYSTEM_PRELOADER_H
+
+#include "root_generic/system_xml_stream.h"
+
+#include <memory>
+#include <string>
+
+// Reads and parses star system files on a worker thread ahead of time,
+// e.g. while a jump drive counts down, so that SystemFactory only has to
+// build the units on the main thread once the system is needed.
+namespace SystemPreloader {
+
+// Starts loading the system file at full_path unless it is already queued.
+// Every Request is matched by a Take or a Cancel.
+void Request(const std::string &full_path);
+
+// True once the file has been loaded and could not be parsed
+bool Failed(const std::string &full_path);
+
+// Drops one Request, e.g. for a jump that never completes; the load is
+// forgotten when no Request is left
+void Cancel(const std::string &full_path);
+
+// Hands over the parsed system, waiting for it if it is still being loaded.
+// Returns nullptr if it was never requested or could not be parsed.
+std::unique_ptr<RecordedSystemXML> Take(const std::string &full_path);
+
+} // namespace SystemPreloader
+
+#endif //VEGA_STRIKE_ENGINE_SYSTEM_PRELOADER_H
@@ -0,0 +1,155 @@
+/*
+ * system_xml_stream.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "root_generic/system_xml_stream.h"
+
+#include <expat.h>
+#include <cctype>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const size_t kReadChunkSize = 64 * 1024;
+
+struct ParserState {
+    SystemXMLHandler *handler;
+    SystemAttributes attributes;
+    std::vector<SystemElement> elements;
+};
+
+void lowercase(const char *source, std::string &destination) {
+    destination.clear();
+    for (; *source; ++source) {
+        destination.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(*source))));
+    }
+}
+
+void XMLCALL startElement(void *user_data, const XML_Char *name, const XML_Char **atts) {
+    ParserState *state = static_cast<ParserState *>(user_data);
+    SystemElement element = InternSystemElement(name);
+
+    std::string key;
+    state->attributes.clear();
+    for (; *atts; atts += 2) {
+        lowercase(atts[0], key); // to avoid various bugs, we turn all keys to lowercase
+        state->attributes[key] = atts[1];
+    }
+
+    state->elements.push_back(element);
+    state->handler->beginElement(element, state->attributes, static_cast<int>(state->elements.size()));
+}
+
+void XMLCALL endElement(void *user_data, const XML_Char *name) {
+    ParserState *state = static_cast<ParserState *>(user_data);
+    int level = static_cast<int>(state->elements.size());
+    SystemElement element = state->elements.back();
+    state->elements.pop_back();
+    state->handler->endElement(element, level);
+}
+
+} // namespace
+
+SystemElement InternSystemElement(const char *name) {
+    static const std::unordered_map<std::string, SystemElement> elements = {
+            {"system", SystemElement::system},
+            {"light", SystemElement::light},
+            {"ambient", SystemElement::ambient},
+            {"diffuse", SystemElement::diffuse},
+            {"specular", SystemElement::specular},
+            {"ring", SystemElement::ring},
+            {"spaceelevator", SystemElement::space_elevator},
+            {"planet", SystemElement::planet},
+            {"jump", SystemElement::jump},
+            {"fog", SystemElement::fog},
+            {"unit", SystemElement::unit},
+            {"asteroid", SystemElement::asteroid},
+            {"enhancement", SystemElement::enhancement},
+            {"vehicle", SystemElement::vehicle},
+            {"building", SystemElement::building}
+    };
+
+    std::string key;
+    lowercase(name, key);
+    const auto iterator = elements.find(key);
+    if (iterator == elements.end()) {
+        return SystemElement::unknown;
+    }
+    return iterator->second;
+}
+
+void RecordedSystemXML::beginElement(SystemElement element, const SystemAttributes &attributes, int level) {
+    events.push_back(Event{true, element, level, attributes});
+}
+
+void RecordedSystemXML::endElement(SystemElement element, int level) {
+    events.push_back(Event{false, element, level, SystemAttributes()});
+}
+
+void RecordedSystemXML::replay(SystemXMLHandler &handler) const {
+    for (const Event &event : events) {
+        if (event.begin) {
+            handler.beginElement(event.element, event.attributes, event.level);
+        } else {
+            handler.endElement(event.element, event.level);
+        }
+    }
+}
+
+bool ParseSystemXML(std::istream &stream, SystemXMLHandler &handler, std::string *error) {
+    ParserState state;
+    state.handler = &handler;
+
+    XML_Parser parser = XML_ParserCreate(nullptr);
+    XML_SetUserData(parser, &state);
+    XML_SetElementHandler(parser, &startElement, &endElement);
+
+    bool success = true;
+    bool done = false;
+    while (!done) {
+        void *buffer = XML_GetBuffer(parser, kReadChunkSize);
+        if (buffer == nullptr) {
+            success = false;
+            break;
+        }
+        stream.read(static_cast<char *>(buffer), kReadChunkSize);
+        std::streamsize length = stream.gcount();
+        done = !stream;
+        if (XML_ParseBuffer(parser, static_cast<int>(length), done) == XML_STATUS_ERROR) {
+            success = false;
+            break;
+        }
+    }
+
+    if (!success && error != nullptr) {
+        *error = std::string(XML_ErrorString(XML_GetErrorCode(parser))) + " at line "
+                + std::to_string(XML_GetCurrentLineNumber(parser));
+    }
+    XML_ParserFree(parser);
+    return success;
+}
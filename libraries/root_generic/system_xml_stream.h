@@ -0,0 +1,97 @@
+/*
+ * system_xml_stream.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_SYSTEM_XML_STREAM_H
+#define VEGA_STRIKE_ENGINE_SYSTEM_XML_STREAM_H
+
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Element types found in a .system file. Names are matched case-insensitively,
+// like the original parser did.
+enum class SystemElement {
+    unknown,
+    system,
+    light,
+    ambient,
+    diffuse,
+    specular,
+    ring,
+    space_elevator,
+    planet,
+    jump,
+    fog,
+    unit,
+    asteroid,
+    enhancement,
+    vehicle,
+    building
+};
+
+SystemElement InternSystemElement(const char *name);
+
+// Attribute keys are lowercased, values are left as is
+typedef std::map<std::string, std::string> SystemAttributes;
+
+// Receives the elements of a .system file in document order as they are
+// parsed. level is the depth of the element, with the outermost element at 1.
+class SystemXMLHandler {
+public:
+    virtual ~SystemXMLHandler() = default;
+
+    virtual void beginElement(SystemElement element, const SystemAttributes &attributes, int level) = 0;
+    virtual void endElement(SystemElement element, int level) = 0;
+};
+
+// Keeps the elements it is handed so they can be replayed later, possibly on
+// another thread. Used to parse a system ahead of time (see system_preloader.h)
+// and build it once it is needed.
+class RecordedSystemXML : public SystemXMLHandler {
+    struct Event {
+        bool begin;
+        SystemElement element;
+        int level;
+        SystemAttributes attributes;
+    };
+
+    std::vector<Event> events;
+
+public:
+    void beginElement(SystemElement element, const SystemAttributes &attributes, int level) override;
+    void endElement(SystemElement element, int level) override;
+
+    void replay(SystemXMLHandler &handler) const;
+};
+
+// Single pass (SAX-style) parse of a .system file. Nothing is kept around
+// once the handler returns, so large systems are never held in memory as a
+// tree. Returns false and fills in error on malformed input.
+bool ParseSystemXML(std::istream &stream, SystemXMLHandler &handler, std::string *error = nullptr);
+
+#endif //VEGA_STRIKE_ENGINE_SYSTEM_XML_STREAM_H
@@ -0,0 +1,124 @@
+/*
+ * savegame_binary_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "root_generic/savegame_binary.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string BuildSave(const std::string &stardate, const std::string &mission_data) {
+    std::vector<std::pair<SaveSection, const std::string *> > sections;
+    sections.push_back(std::make_pair(SaveSection::stardate, &stardate));
+    sections.push_back(std::make_pair(SaveSection::mission_data, &mission_data));
+    std::string out;
+    WriteBinarySave(sections, out);
+    return out;
+}
+
+} // namespace
+
+TEST(SaveGameBinary, RoundTrip) {
+    std::string mission_data;
+    SaveEncoder encoder(mission_data);
+    encoder.PutU32(2);
+    encoder.PutString("kills");
+    encoder.PutFloats({1.0f, -2.5f, 1e30f});
+    encoder.PutString("empty");
+    encoder.PutFloats({});
+
+    const std::string save = BuildSave("3276.1205:000", mission_data);
+    ASSERT_TRUE(IsBinarySave(save.data(), save.size()));
+
+    std::vector<BinarySaveSection> sections;
+    ASSERT_TRUE(ReadBinarySave(save.data(), save.size(), sections));
+    ASSERT_EQ(2u, sections.size());
+    EXPECT_EQ(SaveSection::stardate, sections[0].tag);
+    EXPECT_EQ("3276.1205:000", std::string(sections[0].data, sections[0].length));
+    EXPECT_EQ(SaveSection::mission_data, sections[1].tag);
+
+    SaveDecoder decoder(sections[1].data, sections[1].length);
+    EXPECT_EQ(2u, decoder.GetU32());
+    EXPECT_EQ("kills", decoder.GetString());
+    std::vector<float> values;
+    decoder.GetFloats(values);
+    EXPECT_EQ((std::vector<float>{1.0f, -2.5f, 1e30f}), values);
+    EXPECT_EQ("empty", decoder.GetString());
+    decoder.GetFloats(values);
+    EXPECT_TRUE(values.empty());
+    EXPECT_TRUE(decoder.Ok());
+    EXPECT_TRUE(decoder.AtEnd());
+}
+
+TEST(SaveGameBinary, TextSaveIsNotBinary) {
+    const std::string text = "\n0 stardate data 3276.1205:000";
+    EXPECT_FALSE(IsBinarySave(text.data(), text.size()));
+    std::vector<BinarySaveSection> sections;
+    EXPECT_FALSE(ReadBinarySave(text.data(), text.size(), sections));
+}
+
+TEST(SaveGameBinary, TruncatedContainerKeepsCompleteSections) {
+    const std::string save = BuildSave("3276.1205:000", std::string(64, 'x'));
+    std::vector<BinarySaveSection> sections;
+    ASSERT_TRUE(ReadBinarySave(save.data(), save.size() - 1, sections));
+    ASSERT_EQ(1u, sections.size());
+    EXPECT_EQ(SaveSection::stardate, sections[0].tag);
+}
+
+TEST(SaveGameBinary, NewerVersionIsRejected) {
+    std::string save = BuildSave("3276.1205:000", std::string());
+    save[8] = static_cast<char>(kBinarySaveVersion + 1);
+    std::vector<BinarySaveSection> sections;
+    EXPECT_FALSE(ReadBinarySave(save.data(), save.size(), sections));
+}
+
+TEST(SaveGameBinary, UnknownSectionsAreListed) {
+    const std::string payload = "future";
+    std::vector<std::pair<SaveSection, const std::string *> > sections;
+    sections.push_back(std::make_pair(static_cast<SaveSection>(99), &payload));
+    std::string save;
+    WriteBinarySave(sections, save);
+    std::vector<BinarySaveSection> read;
+    ASSERT_TRUE(ReadBinarySave(save.data(), save.size(), read));
+    ASSERT_EQ(1u, read.size());
+    EXPECT_EQ(99u, static_cast<uint32_t>(read[0].tag));
+    EXPECT_EQ(payload, std::string(read[0].data, read[0].length));
+}
+
+TEST(SaveGameBinary, DecoderFailsPastTheEnd) {
+    std::string data;
+    SaveEncoder encoder(data);
+    encoder.PutString("truncated");
+    SaveDecoder decoder(data.data(), data.size() - 2);
+    EXPECT_EQ(std::string(), decoder.GetString());
+    EXPECT_FALSE(decoder.Ok());
+    EXPECT_EQ(0u, decoder.GetU32());
+}
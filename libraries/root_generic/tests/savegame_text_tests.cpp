@@ -0,0 +1,415 @@
+/*
+ * savegame_text_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "root_generic/savegame_text.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+typedef std::unordered_map<std::string, std::vector<float> > FloatData;
+typedef std::map<std::string, std::vector<std::string> > StringData;
+
+// The readers savegame.cpp used before the scanner, kept as the reference.
+// Counts that fail to parse were left uninitialized; here they are 0, and a
+// negative float count no longer throws from reserve. A string cut short by
+// the end of the save used to be padded with NULs up to its declared length,
+// which for a corrupt length meant gigabytes; now it just ends there.
+namespace legacy {
+
+int hopto(char *buf, char endln, char endln2, int readlen) {
+    if (endln == ' ' || endln2 == ' ') {
+        while (buf[readlen] && buf[readlen] == ' ') {
+            readlen++;
+        }
+    }
+    for (; buf[readlen] != 0 && buf[readlen] != endln && buf[readlen] != endln2; readlen++) {
+    }
+    if ((buf[readlen] && buf[readlen] == endln) || buf[readlen] == endln2) {
+        readlen++;
+    }
+    return readlen;
+}
+
+std::string scanInString(char *&buf) {
+    std::string str;
+    while (*buf && isspace(*buf)) {
+        buf++;
+    }
+    char *start = buf;
+    while (*buf && (!isspace(*buf))) {
+        buf++;
+    }
+    str.resize(buf - start);
+    for (size_t i = 0; start < buf; ++i) {
+        str[i] = *(start++);
+    }
+    return str;
+}
+
+void ReadMissionData(char *&buf, bool select_data, const std::set<std::string> &select_data_filter, FloatData &m) {
+    int mdsize = 0;
+    char *buf2 = buf;
+    sscanf(buf2, " %d ", &mdsize);
+    buf2 += hopto(buf2, ' ', '\n', 0);
+    for (int i = 0; i < mdsize; i++) {
+        int md_i_size = 0;
+        std::string mag_num(scanInString(buf2));
+        for (size_t i = 0, len = mag_num.length(); i < len; ++i) {
+            if (mag_num[i] == '`') {
+                mag_num[i] = ' ';
+            }
+        }
+        sscanf(buf2, "%d ", &md_i_size);
+        buf2 += hopto(buf2, ' ', '\n', 0);
+        std::vector<float> *vecfloat = 0;
+        bool skip = true;
+        if (!select_data || select_data_filter.count(mag_num)) {
+            vecfloat = &m[mag_num];
+            vecfloat->clear();
+            if (md_i_size > 0) {
+                vecfloat->reserve(md_i_size);
+            }
+            skip = false;
+        }
+        for (int j = 0; j < md_i_size; j++) {
+            if (!skip) {
+                double float_val = atof(buf2);
+                vecfloat->push_back(float_val);
+            }
+            buf2 += hopto(buf2, ' ', '\n', 0);
+        }
+    }
+    buf = buf2;
+}
+
+std::string AnyStringScanInString(char *&buf) {
+    unsigned int size = 0;
+    bool found = false;
+    while ((*buf) && ((*buf) != ' ' || (!found))) {
+        if ((*buf) >= '0' && (*buf) <= '9') {
+            size *= 10;
+            size += (*buf) - '0';
+            found = true;
+        }
+        buf++;
+    }
+    if (*buf) {
+        buf++;
+    }
+    std::string ret;
+    unsigned int i = 0;
+    while (i < size && *buf) {
+        ret.push_back(*(buf++));
+        ++i;
+    }
+    return ret;
+}
+
+void ReadMissionStringData(char *&buf, bool select_data, const std::set<std::string> &select_data_filter,
+        StringData &m) {
+    int mdsize = 0;
+    char *buf2 = buf;
+    sscanf(buf2, " %d ", &mdsize);
+    buf2 += hopto(buf2, ' ', '\n', 0);
+    for (int i = 0; i < mdsize; i++) {
+        int md_i_size;
+        std::string mag_num(AnyStringScanInString(buf2));
+        md_i_size = strtol(buf2, (char **) NULL, 10);
+        buf2 += hopto(buf2, ' ', '\n', 0);
+        std::vector<std::string> *vecstring = 0;
+        bool skip = true;
+        if (md_i_size >= 0 && (!select_data || select_data_filter.count(mag_num))) {
+            vecstring = &m[mag_num];
+            vecstring->clear();
+            vecstring->reserve(md_i_size);
+            skip = false;
+        }
+        for (int j = 0; j < md_i_size; j++) {
+            if (skip) {
+                AnyStringScanInString(buf2);
+            } else {
+                vecstring->push_back(AnyStringScanInString(buf2));
+            }
+        }
+    }
+    buf = buf2;
+}
+
+} // namespace legacy
+
+const std::set<std::string> kFilter = {"kills", "2", "a b", ""};
+
+// Bitwise, so that NaNs and signed zeros count
+bool SameFloats(const FloatData &a, const FloatData &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (const auto &entry : a) {
+        FloatData::const_iterator other = b.find(entry.first);
+        if (other == b.end() || other->second.size() != entry.second.size()) {
+            return false;
+        }
+        if (!entry.second.empty()
+                && memcmp(entry.second.data(), other->second.data(), entry.second.size() * sizeof(float)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parses text both ways, with and without the filter, and compares the results
+// and where each left the cursor
+void ExpectSameFloats(const std::string &text) {
+    for (int select = 0; select < 2; ++select) {
+        std::vector<char> ours(text.begin(), text.end());
+        ours.push_back('\0');
+        std::vector<char> theirs(ours);
+        char *our_cursor = ours.data();
+        char *their_cursor = theirs.data();
+        FloatData our_floats, their_floats;
+        ScanMissionData(our_cursor, select != 0, kFilter, our_floats);
+        legacy::ReadMissionData(their_cursor, select != 0, kFilter, their_floats);
+        EXPECT_TRUE(SameFloats(our_floats, their_floats)) << text;
+        EXPECT_EQ(our_cursor - ours.data(), their_cursor - theirs.data()) << text;
+    }
+}
+
+void ExpectSameStrings(const std::string &text) {
+    for (int select = 0; select < 2; ++select) {
+        std::vector<char> ours(text.begin(), text.end());
+        ours.push_back('\0');
+        std::vector<char> theirs(ours);
+        char *our_cursor = ours.data();
+        char *their_cursor = theirs.data();
+        StringData our_strings, their_strings;
+        ScanMissionStringData(our_cursor, select != 0, kFilter, our_strings);
+        legacy::ReadMissionStringData(their_cursor, select != 0, kFilter, their_strings);
+        EXPECT_EQ(our_strings, their_strings) << text;
+        EXPECT_EQ(our_cursor - ours.data(), their_cursor - theirs.data()) << text;
+    }
+}
+
+void ExpectSameAsLegacy(const std::string &text) {
+    ExpectSameFloats(text);
+    ExpectSameStrings(text);
+}
+
+// Mission data the way SaveGame::WriteMissionData writes it
+std::string WriteFloats(const FloatData &data) {
+    std::string out = " " + std::to_string(data.size());
+    char number[64];
+    for (const auto &entry : data) {
+        std::string key = entry.first;
+        for (char &c : key) {
+            if (c == ' ') {
+                c = '`';
+            }
+        }
+        out += "\n" + key + " " + std::to_string(entry.second.size()) + " ";
+        for (float value : entry.second) {
+            snprintf(number, sizeof(number), "%g", value);
+            out += number;
+            out += " ";
+        }
+    }
+    return out;
+}
+
+// Mission strings the way SaveGame::WriteMissionStringData writes them
+std::string WriteStrings(const StringData &data) {
+    std::string out = std::to_string(data.size());
+    for (const auto &entry : data) {
+        out += "\n" + std::to_string(entry.first.size()) + " " + entry.first;
+        out += std::to_string(entry.second.size()) + " ";
+        for (const std::string &value : entry.second) {
+            out += std::to_string(value.size()) + " " + value;
+        }
+    }
+    return out;
+}
+
+// Short digit runs only, so that a mutated save cannot declare huge counts
+std::string RandomWord(std::mt19937 &generator, int min_length = 0) {
+    static const char kLetters[] = "abcdefghijklmnopqrstuvwxyz_#` 12";
+    std::uniform_int_distribution<int> length(min_length, 12);
+    std::uniform_int_distribution<int> letter(0, sizeof(kLetters) - 2);
+    std::string word(length(generator), 'a');
+    for (char &c : word) {
+        c = kLetters[letter(generator)];
+    }
+    return word;
+}
+
+void RandomSave(std::mt19937 &generator, FloatData &floats, StringData &strings) {
+    std::uniform_int_distribution<int> entries(0, 12);
+    std::uniform_int_distribution<int> values(0, 20);
+    std::uniform_int_distribution<int> eighths(-7999, 7999);
+    const int float_entries = entries(generator);
+    for (int i = 0; i < float_entries; ++i) {
+        // Keys are saved with their spaces as `, and an empty one would not
+        // read back, so the writer never sees either
+        std::string key = i % 5 == 0 ? "kills" : RandomWord(generator, 1);
+        std::replace(key.begin(), key.end(), '`', '_');
+        if (key[0] == ' ') {
+            key[0] = '_';
+        }
+        std::vector<float> &data = floats[key];
+        data.resize(values(generator));
+        for (float &value : data) {
+            value = eighths(generator) / 8.0f;
+        }
+    }
+    const int string_entries = entries(generator);
+    for (int i = 0; i < string_entries; ++i) {
+        std::vector<std::string> &data = strings[RandomWord(generator)];
+        data.resize(values(generator));
+        for (std::string &value : data) {
+            value = RandomWord(generator);
+        }
+    }
+}
+
+// Overwrites, drops and truncates bytes; never adds digits
+std::string Mutate(std::string text, std::mt19937 &generator) {
+    static const char kNoise[] = " \n\r\t`-+.eExXnaif\x80";
+    std::uniform_int_distribution<int> noise(0, sizeof(kNoise) - 2);
+    std::uniform_int_distribution<int> edits(1, 4);
+    for (int i = edits(generator); i > 0 && !text.empty(); --i) {
+        std::uniform_int_distribution<size_t> position(0, text.size() - 1);
+        switch (generator() % 3) {
+            case 0:
+                text[position(generator)] = kNoise[noise(generator)];
+                break;
+            case 1:
+                text.erase(position(generator), 1);
+                break;
+            default:
+                text.resize(position(generator));
+                break;
+        }
+    }
+    return text;
+}
+
+} // namespace
+
+TEST(SaveGameText, Numbers) {
+    const char *const numbers[] = {
+            "0", "-0", "+1", "1.", ".5", "-.5", "3.14159", "0.1", "0.3", "1e+30", "1e-30", "-2.5e-05", "1E5",
+            "123456789012345678901234", "0.000000000000000000000123", "1e400", "1e-400", "9007199254740993",
+            "4.94066e-324", "1.7976931348623157e308", "inf", "-INF", "nan", "0x1p3", "0x10", "1.5e", "1e+", "-",
+            ".", "", "abc", "12abc", "7\r", "\t8", "1e22", "1e23", "12e30", "123456789e20", "0e99999", "5e-22"
+    };
+    for (const char *number : numbers) {
+        ExpectSameFloats(std::string(" 1\nkills 1 ") + number + " ");
+        ExpectSameFloats(std::string(" 1\nkills 2 ") + number + "\n" + number);
+    }
+}
+
+TEST(SaveGameText, Malformed) {
+    const char *const saves[] = {
+            "", " ", "x", " 2", " 2\n", " 2\nkills", " 2\nkills 3 1 2", " -1\nkills 1 5 ",
+            " 1\nkills -4 1 2 3 ", " 1\nkills x 1 ", " 1\n\n\nkills\n2\n1\n2\n", " 1\n a`b  2  1  2 ",
+            "1\n5 kills2 3 abc3 def", "1\n5 kills-2 3 abc", "2\n0 0 1 2", "1\n3 abc 2 9 xyz"
+    };
+    for (const char *save : saves) {
+        ExpectSameAsLegacy(save);
+    }
+}
+
+TEST(SaveGameText, Corpus) {
+    std::mt19937 generator(50);
+    for (int i = 0; i < 2000; ++i) {
+        FloatData floats;
+        StringData strings;
+        RandomSave(generator, floats, strings);
+        const std::string text = WriteFloats(floats) + " " + WriteStrings(strings);
+        ExpectSameFloats(WriteFloats(floats));
+        ExpectSameStrings(WriteStrings(strings));
+        ExpectSameFloats(Mutate(WriteFloats(floats), generator));
+        ExpectSameStrings(Mutate(WriteStrings(strings), generator));
+        ExpectSameAsLegacy(Mutate(text, generator));
+
+        // Well formed saves read back what was written
+        std::vector<char> buffer(text.begin(), text.end());
+        buffer.push_back('\0');
+        char *cursor = buffer.data();
+        FloatData read_floats;
+        StringData read_strings;
+        ScanMissionData(cursor, false, kFilter, read_floats);
+        ScanMissionStringData(cursor, false, kFilter, read_strings);
+        EXPECT_TRUE(SameFloats(read_floats, floats));
+        EXPECT_EQ(read_strings, strings);
+    }
+}
+
+TEST(SaveGameText, Benchmark) {
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> thousandths(-9999999, 9999999);
+    FloatData floats;
+    for (int i = 0; i < 200; ++i) {
+        std::vector<float> &data = floats["mission_" + std::to_string(i)];
+        data.resize(2000);
+        for (float &value : data) {
+            value = thousandths(generator) / 1000.0f;
+        }
+    }
+    const std::string text = WriteFloats(floats);
+    std::vector<char> buffer(text.begin(), text.end());
+    buffer.push_back('\0');
+
+    const auto legacy_start = std::chrono::steady_clock::now();
+    FloatData theirs;
+    char *cursor = buffer.data();
+    legacy::ReadMissionData(cursor, false, kFilter, theirs);
+    const auto scanner_start = std::chrono::steady_clock::now();
+    FloatData ours;
+    cursor = buffer.data();
+    ScanMissionData(cursor, false, kFilter, ours);
+    const auto scanner_end = std::chrono::steady_clock::now();
+
+    EXPECT_TRUE(SameFloats(ours, theirs));
+    const std::chrono::duration<double, std::milli> legacy_time = scanner_start - legacy_start;
+    const std::chrono::duration<double, std::milli> scanner_time = scanner_end - scanner_start;
+    std::cout << "400000 mission floats: " << legacy_time.count() << " ms with atof, " << scanner_time.count()
+              << " ms scanned" << std::endl;
+}
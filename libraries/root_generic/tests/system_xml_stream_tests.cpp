@@ -0,0 +1,168 @@
+/*
+ * system_xml_stream_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2025 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "root_generic/system_xml_stream.h"
+
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+class CountingHandler : public SystemXMLHandler {
+public:
+    std::map<SystemElement, int> counts;
+    std::vector<std::string> names;
+    int max_level = 0;
+    int open = 0;
+
+    void beginElement(SystemElement element, const SystemAttributes &attributes, int level) override {
+        ++counts[element];
+        ++open;
+        max_level = std::max(max_level, level);
+        const auto name = attributes.find("name");
+        if (name != attributes.end()) {
+            names.push_back(name->second);
+        }
+    }
+
+    void endElement(SystemElement element, int level) override {
+        --open;
+    }
+};
+
+// Roughly what a big generated system looks like
+std::string generateSystem(int planets, int asteroids_per_planet) {
+    std::ostringstream xml;
+    xml << "<?xml version=\"1.0\"?>\n<System name=\"Generated\" background=\"backgrounds/green\">\n";
+    xml << "<Light><ambient red=\"0\" green=\"0\" blue=\"0\"/><diffuse red=\".9\" green=\".9\" blue=\".9\"/></Light>\n";
+    xml << "<Planet name=\"Sun\" file=\"stars/sun.png\" radius=\"20000\" light=\"0\">\n";
+    for (int i = 0; i < planets; ++i) {
+        xml << "<Planet name=\"P" << i << "\" file=\"planets/rock.png\" ri=\"1000\" sj=\"1000\" year=\"100\" day=\"1\">\n";
+        xml << "<Ring file=\"planets/ring.png\" InnerRadius=\"2\" OuterRadius=\"3\"/>\n";
+        xml << "<Unit name=\"Base" << i << "\" file=\"mining_base\" faction=\"merchant\" ri=\"10\"/>\n";
+        for (int j = 0; j < asteroids_per_planet; ++j) {
+            xml << "<Asteroid name=\"A" << i << "_" << j << "\" file=\"AFieldThin\" difficulty=\".1\" ri=\"" << j << "\"/>\n";
+        }
+        xml << "</Planet>\n";
+    }
+    xml << "</Planet>\n</System>\n";
+    return xml.str();
+}
+
+} // namespace
+
+TEST(SystemXMLStream, Intern) {
+    EXPECT_EQ(InternSystemElement("Planet"), SystemElement::planet);
+    EXPECT_EQ(InternSystemElement("PLANET"), SystemElement::planet);
+    EXPECT_EQ(InternSystemElement("SpaceElevator"), SystemElement::space_elevator);
+    EXPECT_EQ(InternSystemElement("jump"), SystemElement::jump);
+    EXPECT_EQ(InternSystemElement("Atmosphere"), SystemElement::unknown);
+}
+
+TEST(SystemXMLStream, Sanity) {
+    std::istringstream stream("<System Name=\"Sol\"><Planet name=\"Earth\" FILE=\"x\">"
+                              "<Unit name=\"Base\"/><Atmosphere/></Planet></System>");
+    CountingHandler handler;
+    ASSERT_TRUE(ParseSystemXML(stream, handler));
+    EXPECT_EQ(handler.counts[SystemElement::system], 1);
+    EXPECT_EQ(handler.counts[SystemElement::planet], 1);
+    EXPECT_EQ(handler.counts[SystemElement::unit], 1);
+    EXPECT_EQ(handler.counts[SystemElement::unknown], 1);
+    EXPECT_EQ(handler.max_level, 3);
+    EXPECT_EQ(handler.open, 0);
+    ASSERT_EQ(handler.names.size(), 3);
+    EXPECT_EQ(handler.names[0], "Sol"); // keys are lowercased
+    EXPECT_EQ(handler.names[1], "Earth");
+}
+
+TEST(SystemXMLStream, Malformed) {
+    std::istringstream stream("<System><Planet></System>");
+    CountingHandler handler;
+    std::string error;
+    EXPECT_FALSE(ParseSystemXML(stream, handler, &error));
+    EXPECT_FALSE(error.empty());
+}
+
+TEST(SystemXMLStream, Replay) {
+    const std::string system = generateSystem(3, 4);
+    std::istringstream stream(system);
+    RecordedSystemXML recording;
+    ASSERT_TRUE(ParseSystemXML(stream, recording));
+
+    std::istringstream direct_stream(system);
+    CountingHandler direct;
+    ASSERT_TRUE(ParseSystemXML(direct_stream, direct));
+
+    CountingHandler replayed;
+    recording.replay(replayed);
+    EXPECT_EQ(replayed.counts, direct.counts);
+    EXPECT_EQ(replayed.names, direct.names);
+    EXPECT_EQ(replayed.max_level, direct.max_level);
+    EXPECT_EQ(replayed.open, 0);
+}
+
+TEST(SystemXMLStream, Timing) {
+    const std::string system = generateSystem(50, 100);
+    std::istringstream stream(system);
+    CountingHandler handler;
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(ParseSystemXML(stream, handler));
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+    EXPECT_EQ(handler.counts[SystemElement::asteroid], 5000);
+    EXPECT_EQ(handler.counts[SystemElement::planet], 51);
+    std::cout << "Streamed " << system.size() / 1024 << " KiB generated system in "
+              << elapsed.count() << " ms" << std::endl;
+
+    // The shipped sectors live in the data repository.
+    // This may not work for all deployments.
+    boost::filesystem::path sectors("../../data/sectors");
+    if (!boost::filesystem::is_directory(sectors)) {
+        return;
+    }
+    int files = 0;
+    start = std::chrono::steady_clock::now();
+    for (boost::filesystem::recursive_directory_iterator it(sectors), end; it != end; ++it) {
+        if (it->path().extension() != ".system") {
+            continue;
+        }
+        std::ifstream file(it->path().string(), std::ios::binary);
+        CountingHandler sector_handler;
+        EXPECT_TRUE(ParseSystemXML(file, sector_handler)) << it->path();
+        ++files;
+    }
+    elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    std::cout << "Streamed " << files << " shipped system files in " << elapsed.count() << " ms" << std::endl;
+}
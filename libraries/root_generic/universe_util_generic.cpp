@@ -432,20 +432,107 @@ namespace UniverseUtil {
         return activeSys->getUnitList().createIterator();
     }
 
-    Unit *getUnit(int index) {
-        un_iter iter = activeSys->getUnitList().createIterator();
-        Unit *un = NULL;
-        for (int i = -1; (un = *iter) && i < index; ++iter) {
-            if (!un->Destroyed()) {
-                ++i;
-            }
-            if (i == index) {
-                break;
+    //Indexed snapshot of the live (not destroyed) units of a star system.
+    //Python scripts walk the unit list with getUnit(i) for i in range(n), so
+    //the snapshot is rebuilt at most once per frame, or earlier if the unit
+    //list itself changed, turning each lookup into an array access.
+    struct LiveUnitSnapshot {
+        const UnitCollection *collection = nullptr;
+        unsigned int version = 0;
+        double frame = -1.0;
+        std::vector<Unit *> units;
+
+        bool stale(const UnitCollection &list) const {
+            return collection != &list || version != list.version() || frame != getNewTime();
+        }
+
+        void rebuild(const UnitCollection &list) {
+            units.clear();
+            units.reserve(list.size());
+            for (un_kiter iter = list.constIterator(); !iter.isDone(); ++iter) {
+                Unit *un = *iter;
+                if (!un->Destroyed()) {
+                    units.push_back(un);
+                }
             }
+            collection = &list;
+            version = list.version();
+            frame = getNewTime();
+        }
+    };
+
+    static LiveUnitSnapshot live_units;
+
+    static const std::vector<Unit *> &getLiveUnits() {
+        const UnitCollection &list = activeSys->getUnitList();
+        if (live_units.stale(list)) {
+            live_units.rebuild(list);
+        }
+        return live_units.units;
+    }
+
+    Unit *getUnit(int index) {
+        if (index < 0) {
+            return activeSys->getUnitList().front();
+        }
+        const std::vector<Unit *> *units = &getLiveUnits();
+        if (static_cast<size_t>(index) >= units->size()) {
+            return NULL;
+        }
+        Unit *un = (*units)[index];
+        if (un->Killed() || un->Destroyed()) {
+            //died since the snapshot was taken; indices after it have shifted
+            live_units.rebuild(activeSys->getUnitList());
+            units = &live_units.units;
+            un = static_cast<size_t>(index) < units->size() ? (*units)[index] : NULL;
         }
         return un;
     }
 
+    int getNumLiveUnits() {
+        return getLiveUnits().size();
+    }
+
+    boost::python::tuple getUnitPositions() {
+        const std::vector<Unit *> &units = getLiveUnits();
+        PyObject *result = PyTuple_New(units.size() * 3);
+        for (size_t i = 0; i < units.size(); ++i) {
+            const QVector &pos = units[i]->Position();
+            PyTuple_SET_ITEM(result, i * 3, PyFloat_FromDouble(pos.i));
+            PyTuple_SET_ITEM(result, i * 3 + 1, PyFloat_FromDouble(pos.j));
+            PyTuple_SET_ITEM(result, i * 3 + 2, PyFloat_FromDouble(pos.k));
+        }
+        return boost::python::tuple(boost::python::handle<>(result));
+    }
+
+    boost::python::tuple getUnitFactions() {
+        const std::vector<Unit *> &units = getLiveUnits();
+        PyObject *result = PyTuple_New(units.size());
+        for (size_t i = 0; i < units.size(); ++i) {
+            PyTuple_SET_ITEM(result, i, PyLong_FromLong(units[i]->faction));
+        }
+        return boost::python::tuple(boost::python::handle<>(result));
+    }
+
+    boost::python::tuple getUnitFlightgroups() {
+        const std::vector<Unit *> &units = getLiveUnits();
+        PyObject *result = PyTuple_New(units.size());
+        for (size_t i = 0; i < units.size(); ++i) {
+            const string &fg = UnitUtil::getFlightgroupNameCR(units[i]);
+            PyTuple_SET_ITEM(result, i, PyUnicode_FromStringAndSize(fg.data(), fg.size()));
+        }
+        return boost::python::tuple(boost::python::handle<>(result));
+    }
+
+    boost::python::tuple getUnitHulls() {
+        const std::vector<Unit *> &units = getLiveUnits();
+        PyObject *result = PyTuple_New(units.size());
+        for (size_t i = 0; i < units.size(); ++i) {
+            PyTuple_SET_ITEM(result, i, PyFloat_FromDouble(units[i]->hull.Get()));
+        }
+        return boost::python::tuple(boost::python::handle<>(result));
+    }
+
     Unit *getUnitByPtr(void *ptr, Unit *finder, bool allowslowness) {
         if (finder) {
             UnitPtrLocator unitLocator(ptr);
@@ -1820,7 +1820,8 @@ std::string VSFile::ReadFull() {
                 content[readsize] = '\0';
             }
         }
-        string res(content);
+        //keep embedded NULs, binary savegames are read through here
+        string res(content, readsize);
         delete[] content;
         return res;
     } else {